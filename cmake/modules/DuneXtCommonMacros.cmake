@@ -41,6 +41,23 @@ else(EIGEN3_FOUND)
   set(HAVE_EIGEN 0)
 endif(EIGEN3_FOUND)
 
+# optional compression of the rotated log files, see dune/xt/common/rotating_log_file.hh
+find_package(ZLIB)
+if(ZLIB_FOUND)
+  dune_register_package_flags(INCLUDE_DIRS ${ZLIB_INCLUDE_DIRS} LIBRARIES ${ZLIB_LIBRARIES})
+  set(HAVE_ZLIB 1)
+else(ZLIB_FOUND)
+  set(HAVE_ZLIB 0)
+endif(ZLIB_FOUND)
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_LIBRARY zstd)
+if(ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+  dune_register_package_flags(INCLUDE_DIRS ${ZSTD_INCLUDE_DIR} LIBRARIES ${ZSTD_LIBRARY})
+  set(HAVE_ZSTD 1)
+else()
+  set(HAVE_ZSTD 0)
+endif()
+
 # intel mic and likwid don't mix
 if(NOT CMAKE_SYSTEM_PROCESSOR STREQUAL "k1om")
   include(FindLIKWID)
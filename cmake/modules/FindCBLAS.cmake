@@ -18,13 +18,40 @@
 
 include(Hints)
 
+include(CheckFunctionExists)
+
+# the cblas interface is shipped as a separate library (reference cblas, ATLAS) or as part of the blas library
+# (OpenBLAS, BLIS, Debian's reference blas), so we take the first of those which actually provides it
 message("-- checking for cblas library")
-find_library(CBLAS_LIBRARY cblas HINTS ${lib_hints})
+# a separate libcblas only contains the wrappers, which call into libblas
+find_library(CBLAS_BLAS_LIBRARY blas HINTS ${lib_hints})
+set(CBLAS_LIBRARY "CBLAS_LIBRARY-NOTFOUND")
+foreach(cblas_candidate cblas openblas blis blas)
+  find_library(CBLAS_CANDIDATE_${cblas_candidate}_LIBRARY ${cblas_candidate} HINTS ${lib_hints})
+  set(cblas_candidate_library "${CBLAS_CANDIDATE_${cblas_candidate}_LIBRARY}")
+  if(NOT "${cblas_candidate_library}" MATCHES "-NOTFOUND")
+    set(cblas_candidate_libraries "${cblas_candidate_library}")
+    if("${cblas_candidate}" STREQUAL "cblas" AND NOT "${CBLAS_BLAS_LIBRARY}" MATCHES "CBLAS_BLAS_LIBRARY-NOTFOUND")
+      list(APPEND cblas_candidate_libraries "${CBLAS_BLAS_LIBRARY}")
+    endif()
+    # the result is cached, but has to be checked again for each candidate
+    unset(CBLAS_LIBRARY_PROVIDES_CBLAS_DGEMM CACHE)
+    set(CMAKE_REQUIRED_LIBRARIES "${cblas_candidate_libraries}")
+    check_function_exists(cblas_dgemm CBLAS_LIBRARY_PROVIDES_CBLAS_DGEMM)
+    unset(CMAKE_REQUIRED_LIBRARIES)
+    if(CBLAS_LIBRARY_PROVIDES_CBLAS_DGEMM)
+      set(CBLAS_LIBRARY "${cblas_candidate_library}")
+      set(CBLAS_LIBRARIES "${cblas_candidate_libraries}")
+      break()
+    else(CBLAS_LIBRARY_PROVIDES_CBLAS_DGEMM)
+      message("--   ${cblas_candidate_library} does not provide the cblas interface")
+    endif(CBLAS_LIBRARY_PROVIDES_CBLAS_DGEMM)
+  endif()
+endforeach(cblas_candidate)
 if("${CBLAS_LIBRARY}" MATCHES "CBLAS_LIBRARY-NOTFOUND")
   message("--   CBLAS library not found, make sure you have CBLAS installed")
 else("${CBLAS_LIBRARY}" MATCHES "CBLAS_LIBRARY-NOTFOUND")
   message("--   found CBLAS library")
-  set(CBLAS_LIBRARIES "${CBLAS_LIBRARY}")
 endif("${CBLAS_LIBRARY}" MATCHES "CBLAS_LIBRARY-NOTFOUND")
 
 message("-- checking for cblas.h header")
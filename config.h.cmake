@@ -60,6 +60,14 @@
 #cmakedefine01 HAVE_TBB
 #endif
 
+#ifndef HAVE_ZLIB
+#cmakedefine01 HAVE_ZLIB
+#endif
+
+#ifndef HAVE_ZSTD
+#cmakedefine01 HAVE_ZSTD
+#endif
+
 #ifndef DXT_DISABLE_LARGE_TESTS
 #define DXT_DISABLE_LARGE_TESTS 0
 #endif
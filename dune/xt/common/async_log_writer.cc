@@ -0,0 +1,158 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "async_log_writer.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+
+
+AsyncLogWriter::AsyncLogWriter(const size_t capacity, const AsyncLogOverflow overflow)
+  : queue_(capacity)
+  , overflow_(overflow)
+  , dropped_(0)
+  , written_(0)
+  , sleeping_(false)
+  , stop_(false)
+  , thread_([this]() { run(); })
+{}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+bool AsyncLogWriter::write(std::ostream& out, std::string&& text)
+{
+  internal::AsyncLogRecord record{&out, std::move(text)};
+  size_t attempts = 0;
+  while (!queue_.try_push(record)) {
+    if (overflow_ != AsyncLogOverflow::block) {
+      if (overflow_ == AsyncLogOverflow::count) {
+        // counted before dropped_, so run() finds the drop here once it sees the new total
+        std::lock_guard<std::mutex> lock(dropped_mutex_);
+        const auto element =
+            std::find_if(dropped_per_stream_.begin(), dropped_per_stream_.end(), [&](const auto& stream_drops) {
+              return stream_drops.first == &out;
+            });
+        if (element == dropped_per_stream_.end())
+          dropped_per_stream_.emplace_back(&out, 1);
+        else
+          ++element->second;
+      }
+      ++dropped_;
+      return false;
+    }
+    wake_if_sleeping();
+    if (++attempts < 64)
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  wake_if_sleeping();
+  return true;
+} // ... write(...)
+
+void AsyncLogWriter::flush()
+{
+  const size_t pushed = queue_.pushed();
+  std::unique_lock<std::mutex> lock(mutex_);
+  wake_.notify_one();
+  written_changed_.wait(lock, [&]() { return written_ >= pushed; });
+}
+
+size_t AsyncLogWriter::dropped() const
+{
+  return dropped_;
+}
+
+void AsyncLogWriter::wake_if_sleeping()
+{
+  // pairs with the fence in run(): either we see sleeping_ or the writer sees our record
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+}
+
+void AsyncLogWriter::write_drop_notes(std::vector<std::ostream*>& touched_streams)
+{
+  std::vector<std::pair<std::ostream*, size_t>> drops;
+  {
+    std::lock_guard<std::mutex> lock(dropped_mutex_);
+    drops.swap(dropped_per_stream_);
+  }
+  for (const auto& stream_drops : drops) {
+    *stream_drops.first << "[" << stream_drops.second << " log records were dropped]\n";
+    if (std::find(touched_streams.begin(), touched_streams.end(), stream_drops.first) == touched_streams.end())
+      touched_streams.push_back(stream_drops.first);
+  }
+} // ... write_drop_notes(...)
+
+void AsyncLogWriter::run()
+{
+  internal::AsyncLogRecord record;
+  std::vector<std::ostream*> touched_streams;
+  size_t reported_drops = 0;
+  while (true) {
+    // write at most one round, so that flush() does not wait forever while others keep on logging
+    size_t records = 0;
+    while (records < queue_.capacity() && queue_.try_pop(record)) {
+      if (overflow_ == AsyncLogOverflow::count) {
+        const size_t drops = dropped_;
+        if (drops != reported_drops) {
+          reported_drops = drops;
+          write_drop_notes(touched_streams);
+        }
+      }
+      record.out->write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+      if (std::find(touched_streams.begin(), touched_streams.end(), record.out) == touched_streams.end())
+        touched_streams.push_back(record.out);
+      ++records;
+    }
+    // records dropped after the last written one are reported as well
+    if (overflow_ == AsyncLogOverflow::count && dropped_ != reported_drops) {
+      reported_drops = dropped_;
+      write_drop_notes(touched_streams);
+    }
+    for (auto* out : touched_streams)
+      out->flush();
+    touched_streams.clear();
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_ = queue_.popped();
+    written_changed_.notify_all();
+    if (records > 0)
+      continue;
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue_.empty()) {
+      if (stop_)
+        break;
+      // the timeout is only a safety net, producers wake us up
+      wake_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+  }
+} // ... run(...)
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
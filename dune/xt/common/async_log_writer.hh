@@ -0,0 +1,213 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_ASYNC_LOG_WRITER_HH
+#define DUNE_XT_COMMON_ASYNC_LOG_WRITER_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+/**
+ * \brief A bounded lock-free queue for any number of producers and a single consumer.
+ *
+ *        Each cell carries a sequence number which tells producers and the consumer whether the cell is free or
+ *        filled in the current round (see D. Vyukov, "Bounded MPMC queue"). Producers only contend on the enqueue
+ *        position, the consumer does not contend at all.
+ */
+template <class T>
+class BoundedMpscQueue
+{
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t round_up_to_power_of_two(const size_t size)
+  {
+    size_t ret = 2;
+    while (ret < size)
+      ret *= 2;
+    return ret;
+  }
+
+public:
+  //! the capacity is rounded up to the next power of two
+  explicit BoundedMpscQueue(const size_t capacity)
+    : cells_(round_up_to_power_of_two(capacity))
+    , mask_(cells_.size() - 1)
+    , enqueue_pos_(0)
+    , dequeue_pos_(0)
+  {
+    for (size_t ii = 0; ii < cells_.size(); ++ii)
+      cells_[ii].sequence.store(ii, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const
+  {
+    return cells_.size();
+  }
+
+  //! moves value into the queue, if it is not full (value is left untouched otherwise)
+  bool try_push(T& value)
+  {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0)
+        return false; // the consumer has not yet emptied this cell in the last round
+      else
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  } // ... try_push(...)
+
+  //! \note may only be called by the consumer
+  bool try_pop(T& value)
+  {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+      return false;
+    value = std::move(cell.value);
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  //! \note may only be called by the consumer
+  bool empty() const
+  {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return cells_[pos & mask_].sequence.load(std::memory_order_seq_cst) != pos + 1;
+  }
+
+  //! number of values pushed so far (including those whose push has not completed yet)
+  size_t pushed() const
+  {
+    return enqueue_pos_.load(std::memory_order_acquire);
+  }
+
+  //! number of values popped so far
+  size_t popped() const
+  {
+    return dequeue_pos_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::vector<Cell> cells_;
+  const size_t mask_;
+  std::atomic<size_t> enqueue_pos_;
+  std::atomic<size_t> dequeue_pos_;
+}; // class BoundedMpscQueue
+
+
+struct AsyncLogRecord
+{
+  std::ostream* out;
+  std::string text;
+};
+
+
+} // namespace internal
+
+
+//! what AsyncLogWriter::write() does if the queue is full
+enum class AsyncLogOverflow
+{
+  //! wait until the background thread has made room
+  block,
+  //! discard the record
+  drop,
+  //! discard the record and write the number of discarded records to the stream they were meant for
+  count
+};
+
+
+/**
+ * \brief Writes complete records to their streams from a background thread.
+ *
+ *        Producers only move their records into a bounded lock-free queue, so they are not stalled by slow consoles
+ *        or file systems. The background thread writes the records in the order they were queued and flushes the
+ *        streams whenever the queue runs empty.
+ * \note  The streams must not be written to by anyone else (except after flush() and before the next write()) and
+ *        have to outlive this object.
+ * \sa    Logging::enable_async()
+ */
+class AsyncLogWriter
+{
+public:
+  explicit AsyncLogWriter(const size_t capacity = 4096, const AsyncLogOverflow overflow = AsyncLogOverflow::block);
+
+  //! writes everything that was queued before returning
+  ~AsyncLogWriter();
+
+  /**
+   * \brief Queues text to be written to out.
+   * \return false if the record was dropped since the queue was full (only if the overflow policy is not block)
+   */
+  bool write(std::ostream& out, std::string&& text);
+
+  //! blocks until everything queued before has been written and the streams have been flushed
+  void flush();
+
+  //! number of records dropped so far
+  size_t dropped() const;
+
+private:
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  void run();
+
+  void wake_if_sleeping();
+
+  //! writes the number of records dropped since the last call to each affected stream, adds those to touched_streams
+  void write_drop_notes(std::vector<std::ostream*>& touched_streams);
+
+  internal::BoundedMpscQueue<internal::AsyncLogRecord> queue_;
+  const AsyncLogOverflow overflow_;
+  std::atomic<size_t> dropped_;
+  //! number of records dropped per stream since the last note (only for AsyncLogOverflow::count)
+  std::vector<std::pair<std::ostream*, size_t>> dropped_per_stream_;
+  std::mutex dropped_mutex_;
+  //! number of records which have been written and flushed, guarded by mutex_
+  size_t written_;
+  std::atomic<bool> sleeping_;
+  bool stop_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable written_changed_;
+  std::thread thread_;
+}; // class AsyncLogWriter
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_ASYNC_LOG_WRITER_HH
@@ -0,0 +1,453 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_BATCHED_FMATRIX_HH
+#define DUNE_XT_COMMON_BATCHED_FMATRIX_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/fmatrix.hh>
+#include <dune/xt/common/fvector.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+//! as many lanes as fit into 64 bytes (one AVX-512 register or cache line)
+template <class K>
+struct DefaultBatchWidth : public std::integral_constant<size_t, (sizeof(K) >= 64 ? 1 : 64 / sizeof(K))>
+{};
+
+
+/**
+ * \brief a if select is 1, b if it is 0.
+ *
+ *        Computed arithmetically (which is exact for finite a and b), since the compiler turns select ? a : b into
+ *        branches once it has unrolled the loop over the lanes, which then does not vectorize.
+ */
+template <class K>
+K blend(const K& select, const K& a, const K& b)
+{
+  return a * select + b * (K(1) - select);
+}
+
+
+/**
+ * \brief Gaussian elimination with partial pivoting in all lanes at once.
+ *
+ *        The matrix is given by the first N columns of A, the remaining ones (e.g. right hand sides) are swapped and
+ *        eliminated along. Afterwards, the matrix is upper triangular (or diagonal, if jordan is true) and det holds
+ *        the determinants. The rows are swapped by blending in each lane (instead of branching), so all lanes execute
+ *        the same instructions and the innermost loops vectorize.
+ * \throws FMatrixError if any lane is singular and throw_if_singular (the determinant of a singular lane is 0,
+ *         its other entries are garbage otherwise)
+ */
+template <class K, size_t N, size_t M, size_t W>
+void batched_elimination(std::array<std::array<std::array<K, W>, M>, N>& A,
+                         std::array<K, W>& det,
+                         const bool jordan,
+                         const bool throw_if_singular)
+{
+  using std::abs;
+  typedef typename FieldTraits<K>::real_type RealType;
+  // the same relative threshold as in FieldMatrix::luDecomposition
+  std::array<RealType, W> singthres;
+  std::fill(singthres.begin(), singthres.end(), RealType(0));
+  for (size_t ii = 0; ii < N; ++ii) {
+    std::array<RealType, W> row_sum;
+    std::fill(row_sum.begin(), row_sum.end(), RealType(0));
+    for (size_t jj = 0; jj < N; ++jj)
+      for (size_t ll = 0; ll < W; ++ll)
+        row_sum[ll] += abs(A[ii][jj][ll]);
+    for (size_t ll = 0; ll < W; ++ll)
+      singthres[ll] = std::max(singthres[ll], row_sum[ll]);
+  }
+  for (size_t ll = 0; ll < W; ++ll) {
+    singthres[ll] = std::max(FMatrixPrecision<RealType>::absolute_limit(),
+                             singthres[ll] * FMatrixPrecision<RealType>::singular_limit());
+    det[ll] = K(1);
+  }
+  std::array<RealType, W> pivmax;
+  // K instead of size_t, so that everything below has the width of the lanes
+  std::array<K, W> imax;
+  std::array<K, W> swap;
+  std::array<K, W> singular;
+  std::array<K, W> factor;
+  for (size_t ii = 0; ii < N; ++ii) {
+    for (size_t ll = 0; ll < W; ++ll) {
+      pivmax[ll] = abs(A[ii][ii][ll]);
+      imax[ll] = K(ii);
+    }
+    for (size_t kk = ii + 1; kk < N; ++kk)
+      for (size_t ll = 0; ll < W; ++ll) {
+        const RealType value = abs(A[kk][ii][ll]);
+        imax[ll] = blend(K(value > pivmax[ll]), K(kk), imax[ll]);
+        pivmax[ll] = std::max(value, pivmax[ll]);
+      }
+    // swap rows
+    for (size_t kk = ii + 1; kk < N; ++kk) {
+      for (size_t ll = 0; ll < W; ++ll)
+        swap[ll] = K(imax[ll] == K(kk));
+      for (size_t jj = ii; jj < M; ++jj)
+        for (size_t ll = 0; ll < W; ++ll) {
+          const K upper = A[ii][jj][ll];
+          const K lower = A[kk][jj][ll];
+          A[ii][jj][ll] = blend(swap[ll], lower, upper);
+          A[kk][jj][ll] = blend(swap[ll], upper, lower);
+        }
+      for (size_t ll = 0; ll < W; ++ll)
+        det[ll] *= K(1) - K(2) * swap[ll];
+    }
+    // singular ?
+    K any_singular(0);
+    for (size_t ll = 0; ll < W; ++ll) {
+      singular[ll] = K(pivmax[ll] < singthres[ll]);
+      any_singular += singular[ll];
+      det[ll] = blend(singular[ll], K(0), det[ll] * A[ii][ii][ll]);
+      A[ii][ii][ll] = blend(singular[ll], K(1), A[ii][ii][ll]);
+    }
+    if (any_singular > 0 && throw_if_singular)
+      DUNE_THROW(FMatrixError, "matrix is singular");
+    // eliminate
+    for (size_t kk = jordan ? 0 : ii + 1; kk < N; ++kk) {
+      if (kk == ii)
+        continue;
+      for (size_t ll = 0; ll < W; ++ll)
+        factor[ll] = A[kk][ii][ll] / A[ii][ii][ll];
+      for (size_t jj = ii + 1; jj < M; ++jj)
+        for (size_t ll = 0; ll < W; ++ll)
+          A[kk][jj][ll] -= factor[ll] * A[ii][jj][ll];
+    }
+  }
+} // ... batched_elimination(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief W vectors of the same size, stored lane by lane (structure of arrays), \sa BatchedFieldMatrix
+ */
+template <class K, int SIZE, size_t W = internal::DefaultBatchWidth<K>::value>
+class BatchedFieldVector
+{
+public:
+  static const int dimension = SIZE;
+  static const size_t width = W;
+
+  typedef K value_type;
+  typedef std::array<K, W> LanesType;
+
+  explicit BatchedFieldVector(const K& value = K(0))
+  {
+    for (auto& entry : data_)
+      entry.fill(value);
+  }
+
+  explicit BatchedFieldVector(const std::array<Dune::FieldVector<K, SIZE>, W>& vectors)
+  {
+    for (size_t ll = 0; ll < W; ++ll)
+      set_lane(ll, vectors[ll]);
+  }
+
+  //! the ii-th entry of all lanes
+  LanesType& operator[](const size_t ii)
+  {
+    return data_[ii];
+  }
+
+  const LanesType& operator[](const size_t ii) const
+  {
+    return data_[ii];
+  }
+
+  FieldVector<K, SIZE> lane(const size_t ll) const
+  {
+    FieldVector<K, SIZE> ret;
+    for (size_t ii = 0; ii < SIZE; ++ii)
+      ret[ii] = data_[ii][ll];
+    return ret;
+  }
+
+  void set_lane(const size_t ll, const Dune::FieldVector<K, SIZE>& vector)
+  {
+    for (size_t ii = 0; ii < SIZE; ++ii)
+      data_[ii][ll] = vector[ii];
+  }
+
+private:
+  std::array<LanesType, SIZE> data_;
+}; // class BatchedFieldVector
+
+
+/**
+ * \brief W matrices of the same size, stored lane by lane (structure of arrays).
+ *
+ *        Each operation is applied to all lanes at once: the innermost loops of all kernels run over the lanes, so the
+ *        compiler vectorizes across the matrices (which it cannot do for one small FieldMatrix at a time). The default
+ *        width fills 64 bytes, i.e., one AVX-512 register per entry (two AVX2 ones) for double. Like FieldMatrix,
+ *        matrices up to 3x3 are inverted by their closed formula, larger ones by Gaussian elimination with partial
+ *        pivoting (which is done branch-free in each lane).
+ *
+ *        For field types which are not floating point (e.g. std::complex), each lane is converted to a FieldMatrix
+ *        and computed on its own.
+ * \note  The storage is not over-aligned, so these may be put into std::vector etc. without an aligned allocator.
+ */
+template <class K, int ROWS, int COLS, size_t W = internal::DefaultBatchWidth<K>::value>
+class BatchedFieldMatrix
+{
+  typedef BatchedFieldMatrix<K, ROWS, COLS, W> ThisType;
+  typedef std::integral_constant<bool, std::is_floating_point<K>::value> Vectorized;
+
+public:
+  static const int rows = ROWS;
+  static const int cols = COLS;
+  static const size_t width = W;
+
+  typedef K value_type;
+  typedef std::array<K, W> LanesType;
+  typedef std::array<LanesType, COLS> RowType;
+  typedef BatchedFieldVector<K, COLS, W> DomainType;
+  typedef BatchedFieldVector<K, ROWS, W> RangeType;
+
+  explicit BatchedFieldMatrix(const K& value = K(0))
+  {
+    for (auto& row : data_)
+      for (auto& entry : row)
+        entry.fill(value);
+  }
+
+  explicit BatchedFieldMatrix(const std::array<Dune::FieldMatrix<K, ROWS, COLS>, W>& matrices)
+  {
+    for (size_t ll = 0; ll < W; ++ll)
+      set_lane(ll, matrices[ll]);
+  }
+
+  //! the ii-th row of all lanes, i.e. (*this)[ii][jj][ll] is the entry (ii, jj) of the ll-th matrix
+  RowType& operator[](const size_t ii)
+  {
+    return data_[ii];
+  }
+
+  const RowType& operator[](const size_t ii) const
+  {
+    return data_[ii];
+  }
+
+  FieldMatrix<K, ROWS, COLS> lane(const size_t ll) const
+  {
+    FieldMatrix<K, ROWS, COLS> ret;
+    for (size_t ii = 0; ii < ROWS; ++ii)
+      for (size_t jj = 0; jj < COLS; ++jj)
+        ret[ii][jj] = data_[ii][jj][ll];
+    return ret;
+  }
+
+  void set_lane(const size_t ll, const Dune::FieldMatrix<K, ROWS, COLS>& matrix)
+  {
+    for (size_t ii = 0; ii < ROWS; ++ii)
+      for (size_t jj = 0; jj < COLS; ++jj)
+        data_[ii][jj][ll] = matrix[ii][jj];
+  }
+
+  //! y = A x in each lane
+  void mv(const DomainType& x, RangeType& y) const
+  {
+    for (size_t ii = 0; ii < ROWS; ++ii) {
+      auto& y_ii = y[ii];
+      y_ii.fill(K(0));
+      for (size_t jj = 0; jj < COLS; ++jj)
+        for (size_t ll = 0; ll < W; ++ll)
+          y_ii[ll] += data_[ii][jj][ll] * x[jj][ll];
+    }
+  }
+
+  /**
+   * \brief Inverts all lanes.
+   * \throws FMatrixError if any lane is singular (all lanes are garbage then)
+   */
+  void invert()
+  {
+    static_assert(ROWS == COLS, "Only square matrices can be inverted!");
+    invert(Vectorized());
+  }
+
+  /**
+   * \brief Solves A x = b in each lane.
+   * \throws FMatrixError if any lane is singular
+   */
+  void solve(RangeType& x, const RangeType& b) const
+  {
+    static_assert(ROWS == COLS, "Only square matrices can be solved!");
+    solve(x, b, Vectorized());
+  }
+
+  //! the determinant of each lane (0 for singular ones, as for FieldMatrix)
+  LanesType determinant() const
+  {
+    static_assert(ROWS == COLS, "Only square matrices have a determinant!");
+    return determinant(Vectorized());
+  }
+
+private:
+  typedef std::array<RowType, ROWS> DataType;
+
+  void invert(std::false_type)
+  {
+    for (size_t ll = 0; ll < W; ++ll) {
+      auto matrix = lane(ll);
+      matrix.invert();
+      set_lane(ll, matrix);
+    }
+  }
+
+  void invert(std::true_type)
+  {
+    if (ROWS <= 3) {
+      // closed formula, as in Dune::DenseMatrix
+      const auto det = determinant(Vectorized());
+      K any_singular(0);
+      for (size_t ll = 0; ll < W; ++ll)
+        any_singular += K(std::abs(det[ll]) < FMatrixPrecision<K>::absolute_limit());
+      if (any_singular > 0)
+        DUNE_THROW(FMatrixError, "matrix is singular");
+      const auto A = data_;
+      auto& inv = data_;
+      if (ROWS == 1) {
+        for (size_t ll = 0; ll < W; ++ll)
+          inv[0][0][ll] = K(1) / A[0][0][ll];
+      } else if (ROWS == 2) {
+        for (size_t ll = 0; ll < W; ++ll) {
+          const K det_inv = K(1) / det[ll];
+          inv[0][0][ll] = A[at(1)][at(1)][ll] * det_inv;
+          inv[0][at(1)][ll] = -A[0][at(1)][ll] * det_inv;
+          inv[at(1)][0][ll] = -A[at(1)][0][ll] * det_inv;
+          inv[at(1)][at(1)][ll] = A[0][0][ll] * det_inv;
+        }
+      } else {
+        const size_t i1 = at(1), i2 = at(2);
+        for (size_t ll = 0; ll < W; ++ll) {
+          const K det_inv = K(1) / det[ll];
+          inv[0][0][ll] = (A[i1][i1][ll] * A[i2][i2][ll] - A[i1][i2][ll] * A[i2][i1][ll]) * det_inv;
+          inv[0][i1][ll] = (A[0][i2][ll] * A[i2][i1][ll] - A[0][i1][ll] * A[i2][i2][ll]) * det_inv;
+          inv[0][i2][ll] = (A[0][i1][ll] * A[i1][i2][ll] - A[0][i2][ll] * A[i1][i1][ll]) * det_inv;
+          inv[i1][0][ll] = (A[i1][i2][ll] * A[i2][0][ll] - A[i1][0][ll] * A[i2][i2][ll]) * det_inv;
+          inv[i1][i1][ll] = (A[0][0][ll] * A[i2][i2][ll] - A[0][i2][ll] * A[i2][0][ll]) * det_inv;
+          inv[i1][i2][ll] = (A[0][i2][ll] * A[i1][0][ll] - A[0][0][ll] * A[i1][i2][ll]) * det_inv;
+          inv[i2][0][ll] = (A[i1][0][ll] * A[i2][i1][ll] - A[i1][i1][ll] * A[i2][0][ll]) * det_inv;
+          inv[i2][i1][ll] = (A[0][i1][ll] * A[i2][0][ll] - A[0][0][ll] * A[i2][i1][ll]) * det_inv;
+          inv[i2][i2][ll] = (A[0][0][ll] * A[i1][i1][ll] - A[0][i1][ll] * A[i1][0][ll]) * det_inv;
+        }
+      }
+    } else {
+      // Gauss-Jordan with the identity as right hand sides
+      std::array<std::array<LanesType, 2 * COLS>, ROWS> A;
+      for (size_t ii = 0; ii < ROWS; ++ii)
+        for (size_t jj = 0; jj < COLS; ++jj) {
+          A[ii][jj] = data_[ii][jj];
+          A[ii][COLS + jj].fill(K(ii == jj ? 1 : 0));
+        }
+      LanesType det;
+      internal::batched_elimination(A, det, true, true);
+      for (size_t ii = 0; ii < ROWS; ++ii)
+        for (size_t jj = 0; jj < COLS; ++jj)
+          for (size_t ll = 0; ll < W; ++ll)
+            data_[ii][jj][ll] = A[ii][COLS + jj][ll] / A[ii][ii][ll];
+    }
+  } // ... invert(std::true_type)
+
+  void solve(RangeType& x, const RangeType& b, std::false_type) const
+  {
+    for (size_t ll = 0; ll < W; ++ll) {
+      FieldVector<K, ROWS> x_ll;
+      lane(ll).solve(x_ll, b.lane(ll));
+      x.set_lane(ll, x_ll);
+    }
+  }
+
+  void solve(RangeType& x, const RangeType& b, std::true_type) const
+  {
+    if (ROWS <= 3) {
+      auto inv = *this;
+      inv.invert(Vectorized());
+      inv.mv(b, x);
+    } else {
+      std::array<std::array<LanesType, COLS + 1>, ROWS> A;
+      for (size_t ii = 0; ii < ROWS; ++ii) {
+        std::copy(data_[ii].begin(), data_[ii].end(), A[ii].begin());
+        A[ii][COLS] = b[ii];
+      }
+      LanesType det;
+      internal::batched_elimination(A, det, false, true);
+      // backsolve
+      for (size_t ii = ROWS; ii > 0;) {
+        --ii;
+        auto& x_ii = x[ii];
+        x_ii = A[ii][COLS];
+        for (size_t jj = ii + 1; jj < ROWS; ++jj)
+          for (size_t ll = 0; ll < W; ++ll)
+            x_ii[ll] -= A[ii][jj][ll] * x[jj][ll];
+        for (size_t ll = 0; ll < W; ++ll)
+          x_ii[ll] /= A[ii][ii][ll];
+      }
+    }
+  } // ... solve(..., std::true_type)
+
+  LanesType determinant(std::false_type) const
+  {
+    LanesType ret;
+    for (size_t ll = 0; ll < W; ++ll)
+      ret[ll] = lane(ll).determinant();
+    return ret;
+  }
+
+  LanesType determinant(std::true_type) const
+  {
+    LanesType ret;
+    const auto& A = data_;
+    if (ROWS == 1) {
+      ret = A[0][0];
+    } else if (ROWS == 2) {
+      for (size_t ll = 0; ll < W; ++ll)
+        ret[ll] = A[0][0][ll] * A[at(1)][at(1)][ll] - A[0][at(1)][ll] * A[at(1)][0][ll];
+    } else if (ROWS == 3) {
+      const size_t i1 = at(1), i2 = at(2);
+      for (size_t ll = 0; ll < W; ++ll)
+        ret[ll] = A[0][0][ll] * (A[i1][i1][ll] * A[i2][i2][ll] - A[i1][i2][ll] * A[i2][i1][ll])
+                  - A[0][i1][ll] * (A[i1][0][ll] * A[i2][i2][ll] - A[i1][i2][ll] * A[i2][0][ll])
+                  + A[0][i2][ll] * (A[i1][0][ll] * A[i2][i1][ll] - A[i1][i1][ll] * A[i2][0][ll]);
+    } else {
+      auto LU = data_;
+      internal::batched_elimination(LU, ret, false, false);
+    }
+    return ret;
+  } // ... determinant(std::true_type)
+
+  //! ii, if it is a valid index, 0 otherwise (to silence out of bounds warnings in the branches for smaller sizes)
+  static constexpr size_t at(const size_t ii)
+  {
+    return ii < ROWS ? ii : 0;
+  }
+
+  DataType data_;
+}; // class BatchedFieldMatrix
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_BATCHED_FMATRIX_HH
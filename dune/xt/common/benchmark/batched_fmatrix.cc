@@ -0,0 +1,89 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <dune/xt/common/batched_fmatrix.hh>
+#include <dune/xt/common/exceptions.hh>
+
+using namespace Dune::XT::Common;
+
+
+//! well conditioned random matrices
+template <int N, size_t W>
+std::array<Dune::FieldMatrix<double, N, N>, W> random_matrices(std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::array<Dune::FieldMatrix<double, N, N>, W> ret;
+  for (auto& mat : ret) {
+    for (size_t ii = 0; ii < N; ++ii)
+      for (size_t jj = 0; jj < N; ++jj)
+        mat[ii][jj] = distribution(generator);
+    for (size_t ii = 0; ii < N; ++ii)
+      mat[ii][ii] += N;
+  }
+  return ret;
+} // ... random_matrices(...)
+
+
+template <int N>
+void benchmark_batched_kernels()
+{
+  static constexpr size_t W = BatchedFieldMatrix<double, N, N>::width;
+  const size_t num_batches = 1 << 13;
+  std::mt19937 generator(N);
+  std::vector<std::array<Dune::FieldMatrix<double, N, N>, W>> matrices(num_batches);
+  for (auto& mats : matrices)
+    mats = random_matrices<N, W>(generator);
+  typedef std::chrono::steady_clock Clock;
+  double checksum = 0;
+  // one FieldMatrix at a time
+  std::vector<FieldMatrix<double, N, N>> single;
+  for (const auto& mats : matrices)
+    single.insert(single.end(), mats.begin(), mats.end());
+  auto start = Clock::now();
+  for (auto& mat : single) {
+    mat.invert();
+    checksum += mat[0][0];
+  }
+  const double single_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / single.size();
+  // W at a time
+  std::vector<BatchedFieldMatrix<double, N, N>> batches;
+  for (const auto& mats : matrices)
+    batches.emplace_back(mats);
+  start = Clock::now();
+  for (auto& batch : batches) {
+    batch.invert();
+    checksum += batch[0][0][0];
+  }
+  const double batched_ns =
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (batches.size() * W);
+  // the checksum keeps the compiler from dropping the inversions
+  DUNE_THROW_IF(!std::isfinite(checksum), Dune::MathError, "checksum = " << checksum);
+  std::cout << std::setw(4) << N << std::fixed << std::setprecision(1) << std::setw(12) << single_ns << std::setw(12)
+            << batched_ns << std::endl;
+} // ... benchmark_batched_kernels(...)
+
+
+int main()
+{
+  std::cout << "nanoseconds per inverted matrix, one FieldMatrix at a time and batched:\n"
+            << "   N      single     batched" << std::endl;
+  benchmark_batched_kernels<2>();
+  benchmark_batched_kernels<3>();
+  benchmark_batched_kernels<4>();
+  benchmark_batched_kernels<6>();
+  return 0;
+}
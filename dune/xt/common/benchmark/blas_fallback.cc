@@ -0,0 +1,153 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dune/xt/common/blas_fallback.hh>
+#include <dune/xt/common/cblas.hh>
+#include <dune/xt/common/lapacke.hh>
+
+using namespace Dune::XT::Common;
+using namespace Dune::XT::Common::internal;
+
+
+//! the seconds per call of f, averaged over 200ms
+template <class F>
+double seconds(const F& f)
+{
+  f();
+  const auto start = std::chrono::steady_clock::now();
+  size_t runs = 0;
+  do {
+    f();
+    ++runs;
+  } while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(200));
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+
+//! prints the GFLOP/s of the fallbacks for n x n matrices (and of the library, if available)
+int main()
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  const int n = 1000;
+  // a well conditioned lower triangular matrix
+  std::vector<double> a(size_t(n) * n);
+  for (auto& entry : a)
+    entry = distribution(generator) / n;
+  for (int ii = 0; ii < n; ++ii)
+    a[ii * n + ii] += 2.;
+  std::vector<double> x(n);
+  for (auto& entry : x)
+    entry = distribution(generator);
+  auto y = x;
+  std::vector<double> spd(size_t(n) * n, 0.);
+  for (int ii = 0; ii < n; ++ii)
+    for (int jj = 0; jj <= ii; ++jj)
+      spd[ii * n + jj] = spd[jj * n + ii] = (ii == jj) ? 2. * n : a[ii * n + jj];
+  auto work = spd;
+  std::vector<int> jpvt(n);
+  std::vector<double> tau(n);
+  std::cout << "GFLOP/s of the fallbacks for n = " << n << (Cblas::available() ? " (and of the library)" : "") << ":"
+            << std::endl;
+  const auto report = [&](const std::string& id, const double flops, const double fallback, const double library) {
+    std::cout << "  " << std::setw(6) << id << std::fixed << std::setprecision(2) << std::setw(10)
+              << flops / fallback * 1e-9;
+    if (library > 0)
+      std::cout << std::setw(10) << flops / library * 1e-9;
+    std::cout << std::endl;
+  };
+  const bool blas = Cblas::available();
+  const bool lapack = Lapacke::available();
+  for (const bool trans : {false, true})
+    report(trans ? "gemv^T" : "gemv",
+           2. * n * n,
+           seconds([&] { fallback_gemv(true, trans, false, n, n, 1., a.data(), n, x.data(), 1, 0., y.data(), 1); }),
+           blas ? seconds([&] {
+             Cblas::dgemv(Cblas::row_major(),
+                          trans ? Cblas::trans() : Cblas::no_trans(),
+                          n,
+                          n,
+                          1.,
+                          a.data(),
+                          n,
+                          x.data(),
+                          1,
+                          0.,
+                          y.data(),
+                          1);
+           })
+                : 0.);
+  report("trsv",
+         1. * n * n,
+         seconds([&] {
+           y = x;
+           fallback_trsv(true, true, false, false, false, n, a.data(), n, y.data(), 1);
+         }),
+         blas ? seconds([&] {
+           y = x;
+           Cblas::dtrsv(
+               Cblas::row_major(), Cblas::lower(), Cblas::no_trans(), Cblas::non_unit(), n, a.data(), n, y.data(), 1);
+         })
+              : 0.);
+  report("trsm",
+         1. * n * n * n,
+         seconds([&] {
+           work = spd;
+           fallback_trsm(true, true, true, false, false, false, n, n, 1., a.data(), n, work.data(), n);
+         }),
+         blas ? seconds([&] {
+           work = spd;
+           Cblas::dtrsm(Cblas::row_major(),
+                        Cblas::left(),
+                        Cblas::lower(),
+                        Cblas::no_trans(),
+                        Cblas::non_unit(),
+                        n,
+                        n,
+                        1.,
+                        a.data(),
+                        n,
+                        work.data(),
+                        n);
+         })
+              : 0.);
+  report("potrf",
+         n * n * n / 3.,
+         seconds([&] {
+           work = spd;
+           fallback_potrf(true, true, n, work.data(), n);
+         }),
+         lapack ? seconds([&] {
+           work = spd;
+           Lapacke::dpotrf(Lapacke::row_major(), 'L', n, work.data(), n);
+         })
+                : 0.);
+  report("geqp3",
+         4. * n * n * n / 3.,
+         seconds([&] {
+           work = spd;
+           std::fill(jpvt.begin(), jpvt.end(), 0);
+           fallback_geqp3(false, n, n, work.data(), n, jpvt.data(), tau.data());
+         }),
+         lapack ? seconds([&] {
+           work = spd;
+           std::fill(jpvt.begin(), jpvt.end(), 0);
+           Lapacke::dgeqp3(Lapacke::col_major(), n, n, work.data(), n, jpvt.data(), tau.data());
+         })
+                : 0.);
+  return 0;
+} // ... main(...)
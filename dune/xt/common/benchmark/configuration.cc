@@ -0,0 +1,55 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <dune/common/parametertree.hh>
+#include <dune/common/parametertreeparser.hh>
+
+#include <dune/xt/common/configuration.hh>
+#include <dune/xt/common/exceptions.hh>
+
+
+//! prints the seconds to read an INI file with one line per parameter sample, by Dune and by Configuration
+int main(int argc, char** argv)
+{
+  // the number of samples may be given as the first argument
+  const size_t samples = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const size_t samples_per_section = 1000;
+  const std::string filename = "benchmark_configuration.ini";
+  {
+    std::ofstream file(filename);
+    file << "# a training set\nsamples = " << samples << "\n";
+    for (size_t ii = 0; ii < samples; ++ii) {
+      if (ii % samples_per_section == 0)
+        file << "[training_set.batch_" << ii / samples_per_section << "]\n";
+      file << "sample_" << ii << " = [" << 1e-3 * ii << " " << 2. / (ii + 1) << " 0.5] # mu\n";
+    }
+  }
+  typedef std::chrono::steady_clock Clock;
+  auto start = Clock::now();
+  Dune::ParameterTree tree;
+  Dune::ParameterTreeParser::readINITree(filename, tree);
+  const Dune::XT::Common::Configuration dune_config(tree);
+  const double dune_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  start = Clock::now();
+  const Dune::XT::Common::Configuration config(filename);
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  std::remove(filename.c_str());
+  DUNE_THROW_IF(!(config == dune_config), Dune::XT::Common::Exceptions::configuration_error, "the results differ!");
+  std::cout << "seconds to read " << samples << " samples (Dune::ParameterTreeParser, Configuration, speedup):\n"
+            << std::fixed << std::setprecision(3) << std::setw(10) << dune_seconds << std::setw(10) << seconds
+            << std::setprecision(1) << std::setw(8) << dune_seconds / seconds << std::endl;
+  return 0;
+} // ... main(...)
@@ -0,0 +1,91 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/fmatrix.hh>
+#include <dune/xt/common/test/matrices.hh>
+
+using Dune::XT::Common::Test::reversed_triangular_matrix;
+
+
+template <int N>
+struct InvertSolveDeterminantBenchmark
+{
+  template <class MatrixType>
+  static std::array<double, 3> nanoseconds_per_call(const MatrixType& mat, const size_t repetitions)
+  {
+    typedef std::chrono::steady_clock Clock;
+    typename MatrixType::row_type b(1.);
+    typename MatrixType::row_type x;
+    double checksum = 0.;
+    std::array<double, 3> ret;
+    auto start = Clock::now();
+    for (size_t rr = 0; rr < repetitions; ++rr) {
+      MatrixType inverse = mat;
+      inverse[0][0] += 1e-3 * (rr % 2);
+      inverse.invert();
+      checksum += inverse[0][0];
+    }
+    ret[0] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / repetitions;
+    start = Clock::now();
+    for (size_t rr = 0; rr < repetitions; ++rr) {
+      b[0] = 1. + 1e-3 * (rr % 2);
+      mat.solve(x, b);
+      checksum += x[0];
+    }
+    ret[1] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / repetitions;
+    start = Clock::now();
+    for (size_t rr = 0; rr < repetitions; ++rr) {
+      MatrixType tmp = mat;
+      tmp[0][0] += 1e-3 * (rr % 2);
+      checksum += tmp.determinant();
+    }
+    ret[2] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / repetitions;
+    // the checksum keeps the compiler from dropping the calls
+    DUNE_THROW_IF(!std::isfinite(checksum), Dune::MathError, "checksum = " << checksum);
+    return ret;
+  } // ... nanoseconds_per_call(...)
+
+  static void run()
+  {
+    InvertSolveDeterminantBenchmark<N - 1>::run();
+    const size_t repetitions = std::max(100, 200000 / (N * N));
+    const auto mat = reversed_triangular_matrix<N>();
+    const auto xt = nanoseconds_per_call(mat, repetitions);
+    const auto dune = nanoseconds_per_call(Dune::FieldMatrix<double, N, N>(mat), repetitions);
+    std::cout << std::setw(4) << N << std::fixed << std::setprecision(1);
+    for (size_t ii = 0; ii < 3; ++ii)
+      std::cout << std::setw(12) << xt[ii] << std::setw(12) << dune[ii];
+    std::cout << std::endl;
+  }
+}; // struct InvertSolveDeterminantBenchmark
+
+template <>
+struct InvertSolveDeterminantBenchmark<0>
+{
+  static void run()
+  {
+    std::cout << "nanoseconds per call of Dune::XT::Common::FieldMatrix (xt) and Dune::FieldMatrix (dune):\n"
+              << "   N   invert xt invert dune    solve xt  solve dune      det xt    det dune" << std::endl;
+  }
+};
+
+
+int main()
+{
+  InvertSolveDeterminantBenchmark<16>::run();
+  return 0;
+}
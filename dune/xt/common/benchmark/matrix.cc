@@ -0,0 +1,49 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/test/matrices.hh>
+
+using Dune::XT::Common::Test::create_dynamic_matrix;
+
+
+//! prints the GFLOP/s of operator* of two DynamicMatrix, compared to naive ijk loops
+int main()
+{
+  std::cout << "GFLOP/s of the product of two n x n DynamicMatrix<double> (naive: ijk loops):\n"
+            << "     n       naive     operator*" << std::endl;
+  for (size_t n : {64, 256, 512}) {
+    const auto lhs = create_dynamic_matrix<double>(n, n, 1);
+    const auto rhs = create_dynamic_matrix<double>(n, n, 2);
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+    Dune::DynamicMatrix<double> naive(n, n, 0.);
+    for (size_t ii = 0; ii < n; ++ii)
+      for (size_t jj = 0; jj < n; ++jj)
+        for (size_t kk = 0; kk < n; ++kk)
+          naive[ii][jj] += lhs[ii][kk] * rhs[kk][jj];
+    const double naive_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    const auto product = lhs * rhs;
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    // the entries are small integers, so both products are exact
+    DUNE_THROW_IF(naive[n - 1][n - 1] != product[n - 1][n - 1],
+                  Dune::MathError,
+                  "naive: " << naive[n - 1][n - 1] << ", operator*: " << product[n - 1][n - 1]);
+    const double flops = 2. * n * n * n;
+    std::cout << std::setw(6) << n << std::fixed << std::setprecision(2) << std::setw(12) << flops / naive_seconds / 1e9
+              << std::setw(14) << flops / seconds / 1e9 << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,973 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_BLAS_FALLBACK_HH
+#define DUNE_XT_COMMON_BLAS_FALLBACK_HH
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/gemm.hh>
+
+/**
+ * \file
+ * \brief Portable implementations of the routines wrapped in cblas.hh and lapacke.hh.
+ *
+ *        These are used by the wrappers if neither the intel mkl nor a cblas/lapacke was found. They take the same
+ *        arguments as the cblas/lapacke functions, with bools instead of the enums. All innermost loops stream through
+ *        contiguous memory (matrices are copied or transposed first, if required), so that they are vectorized by the
+ *        compiler, and the level 3 routines do the bulk of their work in gemm().
+ */
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+template <class K>
+K conj_if(const K& x, std::false_type)
+{
+  return x;
+}
+
+template <class K>
+K conj_if(const K& x, std::true_type)
+{
+  return x;
+}
+
+template <class K>
+std::complex<K> conj_if(const std::complex<K>& x, std::true_type)
+{
+  return std::conj(x);
+}
+
+
+//! the first (logical) entry of a blas vector with n entries and increment inc, which may be negative
+template <class K>
+K* first_entry(K* x, const int n, const int inc)
+{
+  return inc >= 0 ? x : x + std::ptrdiff_t(1 - n) * inc;
+}
+
+
+//! x itself if inc == 1, a contiguous copy of the n entries in storage otherwise
+template <class K>
+K* gather(const int n, K* x, const int inc, std::vector<typename std::remove_const<K>::type>& storage)
+{
+  if (inc == 1)
+    return x;
+  storage.resize(n);
+  const K* first = first_entry(x, n, inc);
+  for (int ii = 0; ii < n; ++ii)
+    storage[ii] = first[std::ptrdiff_t(ii) * inc];
+  return storage.data();
+}
+
+
+//! copies the n contiguous values back to x, if they were gathered
+template <class K>
+void scatter(const int n, const K* values, K* x, const int inc)
+{
+  if (values == x)
+    return;
+  K* first = first_entry(x, n, inc);
+  for (int ii = 0; ii < n; ++ii)
+    first[std::ptrdiff_t(ii) * inc] = values[ii];
+}
+
+
+//! sum_ii conj_if(x[ii]) * y[ii], with independent partial sums, which the compiler may vectorize
+template <class K, class C>
+K dot_contiguous(const size_t n, const K* x, const K* y, C conjugate)
+{
+  const size_t lanes = 8;
+  K partial_sums[lanes];
+  std::fill(partial_sums, partial_sums + lanes, K(0));
+  size_t ii = 0;
+  for (; ii + lanes <= n; ii += lanes)
+    for (size_t ll = 0; ll < lanes; ++ll)
+      partial_sums[ll] += conj_if(x[ii + ll], conjugate) * y[ii + ll];
+  K ret(0);
+  for (; ii < n; ++ii)
+    ret += conj_if(x[ii], conjugate) * y[ii];
+  for (size_t ll = 0; ll < lanes; ++ll)
+    ret += partial_sums[ll];
+  return ret;
+}
+
+
+//! y += alpha * conj_if(x)
+template <class K, class C>
+void axpy_contiguous(const size_t n, const K& alpha, const K* x, K* y, C conjugate)
+{
+  for (size_t ii = 0; ii < n; ++ii)
+    y[ii] += alpha * conj_if(x[ii], conjugate);
+}
+
+
+//! the euclidean norm of n contiguous reals, without overflow or underflow of the intermediate sum of squares
+template <class R>
+R nrm2_contiguous(const size_t n, const R* x)
+{
+  const R sum_of_squares = dot_contiguous(n, x, x, std::false_type());
+  if (std::isnan(sum_of_squares)
+      || (std::isfinite(sum_of_squares)
+          && sum_of_squares >= std::numeric_limits<R>::min() / std::numeric_limits<R>::epsilon()))
+    return std::sqrt(sum_of_squares);
+  R scale(0);
+  for (size_t ii = 0; ii < n; ++ii)
+    scale = std::max(scale, std::abs(x[ii]));
+  if (scale == R(0) || std::isinf(scale))
+    return scale;
+  R scaled_sum_of_squares(0);
+  for (size_t ii = 0; ii < n; ++ii)
+    scaled_sum_of_squares += (x[ii] / scale) * (x[ii] / scale);
+  return scale * std::sqrt(scaled_sum_of_squares);
+} // ... nrm2_contiguous(...)
+
+
+template <class K>
+K fallback_dot(const int n, const K* x, const int incx, const K* y, const int incy, const bool conjugate = false)
+{
+  if (n <= 0)
+    return K(0);
+  std::vector<K> x_storage, y_storage;
+  const K* xx = gather(n, x, incx, x_storage);
+  const K* yy = gather(n, y, incy, y_storage);
+  return conjugate ? dot_contiguous(n, xx, yy, std::true_type()) : dot_contiguous(n, xx, yy, std::false_type());
+}
+
+
+template <class K>
+void fallback_axpy(const int n, const K alpha, const K* x, const int incx, K* y, const int incy)
+{
+  if (n <= 0 || alpha == K(0))
+    return;
+  if (incx == 1 && incy == 1) {
+    axpy_contiguous(n, alpha, x, y, std::false_type());
+    return;
+  }
+  const K* first_x = first_entry(x, n, incx);
+  K* first_y = first_entry(y, n, incy);
+  for (int ii = 0; ii < n; ++ii)
+    first_y[std::ptrdiff_t(ii) * incy] += alpha * first_x[std::ptrdiff_t(ii) * incx];
+}
+
+
+//! as in the reference blas (and OpenBLAS), the norm is 0 for non-positive increments
+template <class R>
+R fallback_nrm2(const int n, const R* x, const int incx)
+{
+  if (n <= 0 || incx <= 0)
+    return R(0);
+  std::vector<R> storage;
+  return nrm2_contiguous(n, gather(n, x, incx, storage));
+}
+
+//! the real and imaginary parts are treated as 2n reals
+template <class R>
+R fallback_nrm2(const int n, const std::complex<R>* x, const int incx)
+{
+  if (n <= 0 || incx <= 0)
+    return R(0);
+  std::vector<std::complex<R>> storage;
+  const std::complex<R>* xx = gather(n, x, incx, storage);
+  return nrm2_contiguous(2 * size_t(n), reinterpret_cast<const R*>(xx));
+}
+
+
+//! x is left untouched for non-positive increments, as for nrm2
+template <class K>
+void fallback_scal(const int n, const K alpha, K* x, const int incx)
+{
+  if (n <= 0 || incx <= 0)
+    return;
+  for (int ii = 0; ii < n; ++ii)
+    x[std::ptrdiff_t(ii) * incx] *= alpha;
+}
+
+
+//! ax = op(A) x for a rows x cols matrix op(A), the rows or the columns of which are contiguous
+template <class K, class C>
+void gemv_contiguous(const bool rows_are_contiguous,
+                     const size_t rows,
+                     const size_t cols,
+                     const K* a,
+                     const size_t lda,
+                     const K* x,
+                     K* ax,
+                     C conjugate)
+{
+  if (rows_are_contiguous) {
+    for (size_t ii = 0; ii < rows; ++ii)
+      ax[ii] = dot_contiguous(cols, a + ii * lda, x, conjugate);
+  } else {
+    std::fill(ax, ax + rows, K(0));
+    for (size_t jj = 0; jj < cols; ++jj)
+      axpy_contiguous(rows, x[jj], a + jj * lda, ax, conjugate);
+  }
+} // ... gemv_contiguous(...)
+
+
+/**
+ * \brief y = alpha op(A) x + beta y, where A is m x n, op(A) = A, A^T or A^H (if trans and conjugate).
+ * \sa    cblas_dgemv
+ */
+template <class K>
+void fallback_gemv(const bool row_major,
+                   const bool trans,
+                   const bool conjugate,
+                   const int m,
+                   const int n,
+                   const K alpha,
+                   const K* a,
+                   const int lda,
+                   const K* x,
+                   const int incx,
+                   const K beta,
+                   K* y,
+                   const int incy)
+{
+  DUNE_THROW_IF(m < 0 || n < 0, Exceptions::wrong_input_given, "m = " << m << "\n   n = " << n);
+  const int rows = trans ? n : m;
+  const int cols = trans ? m : n;
+  if (rows == 0 || (alpha == K(0) && beta == K(1)))
+    return;
+  std::vector<K> ax(rows, K(0));
+  if (cols > 0 && alpha != K(0)) {
+    std::vector<K> x_storage;
+    const K* xx = gather(cols, x, incx, x_storage);
+    // the rows of op(A) are contiguous for A in row major and A^T in column major
+    if (conjugate)
+      gemv_contiguous(row_major != trans, rows, cols, a, lda, xx, ax.data(), std::true_type());
+    else
+      gemv_contiguous(row_major != trans, rows, cols, a, lda, xx, ax.data(), std::false_type());
+  }
+  K* first_y = first_entry(y, rows, incy);
+  for (int ii = 0; ii < rows; ++ii) {
+    K& y_ii = first_y[std::ptrdiff_t(ii) * incy];
+    y_ii = (beta == K(0)) ? alpha * ax[ii] : alpha * ax[ii] + beta * y_ii;
+  }
+} // ... fallback_gemv(...)
+
+
+//! solves T x = b in place (x contains b) for an n x n triangular matrix T, the rows or the columns of which are
+//! contiguous
+template <class K, class C>
+void trsv_contiguous(const bool rows_are_contiguous,
+                     const bool lower,
+                     const bool unit,
+                     const size_t n,
+                     const K* t,
+                     const size_t ldt,
+                     K* x,
+                     C conjugate)
+{
+  if (rows_are_contiguous) {
+    for (size_t nn = 0; nn < n; ++nn) {
+      const size_t ii = lower ? nn : n - 1 - nn;
+      const K* row = t + ii * ldt;
+      if (lower)
+        x[ii] -= dot_contiguous(ii, row, x, conjugate);
+      else
+        x[ii] -= dot_contiguous(n - 1 - ii, row + ii + 1, x + ii + 1, conjugate);
+      if (!unit)
+        x[ii] /= conj_if(row[ii], conjugate);
+    }
+  } else {
+    for (size_t nn = 0; nn < n; ++nn) {
+      const size_t jj = lower ? nn : n - 1 - nn;
+      const K* col = t + jj * ldt;
+      if (!unit)
+        x[jj] /= conj_if(col[jj], conjugate);
+      if (lower)
+        axpy_contiguous(n - 1 - jj, -x[jj], col + jj + 1, x + jj + 1, conjugate);
+      else
+        axpy_contiguous(jj, -x[jj], col, x, conjugate);
+    }
+  }
+} // ... trsv_contiguous(...)
+
+
+/**
+ * \brief Solves op(A) x = b in place (x contains b), where A is an n x n upper or lower triangular matrix.
+ * \sa    cblas_dtrsv
+ */
+template <class K>
+void fallback_trsv(const bool row_major,
+                   const bool lower,
+                   const bool trans,
+                   const bool conjugate,
+                   const bool unit,
+                   const int n,
+                   const K* a,
+                   const int lda,
+                   K* x,
+                   const int incx)
+{
+  DUNE_THROW_IF(n < 0, Exceptions::wrong_input_given, "n = " << n);
+  if (n == 0)
+    return;
+  std::vector<K> x_storage;
+  K* xx = gather(n, x, incx, x_storage);
+  // op(A) is lower triangular if A is lower and not transposed or upper and transposed
+  if (conjugate)
+    trsv_contiguous(row_major != trans, lower != trans, unit, n, a, lda, xx, std::true_type());
+  else
+    trsv_contiguous(row_major != trans, lower != trans, unit, n, a, lda, xx, std::false_type());
+  scatter(n, xx, x, incx);
+} // ... fallback_trsv(...)
+
+
+/**
+ * \brief Solves T X = B (from the left) or X T = B in place, where T is a dense row-major k x k triangular matrix and
+ *        B is row-major.
+ *
+ *        The solution is computed blockwise: the contribution of the solved blocks of X is subtracted from the next
+ *        block of B by gemm(), the diagonal blocks are solved row by row.
+ */
+template <class K>
+void trsm_row_major(const bool from_left,
+                    const bool lower,
+                    const bool unit,
+                    const size_t k,
+                    const K* t,
+                    const size_t rows,
+                    const size_t cols,
+                    K* b,
+                    const size_t ldb)
+{
+  // gemm only pays off if there are enough right hand sides
+  const size_t block_size = (from_left ? cols : rows) < 16 ? k : 64;
+  std::vector<K> update;
+  for (size_t block = 0; block < k; block += block_size) {
+    const size_t size = std::min(block_size, k - block);
+    if (from_left) {
+      // the block rows of X, starting at the top (lower) or at the bottom (upper)
+      const size_t begin = lower ? block : k - block - size;
+      const size_t end = begin + size;
+      const size_t solved_begin = lower ? 0 : end;
+      const size_t solved = lower ? begin : k - end;
+      if (solved > 0) {
+        update.resize(size * cols);
+        gemm(size, cols, solved, t + begin * k + solved_begin, k, b + solved_begin * ldb, ldb, update.data(), cols);
+        for (size_t ii = 0; ii < size; ++ii)
+          axpy_contiguous(cols, K(-1), update.data() + ii * cols, b + (begin + ii) * ldb, std::false_type());
+      }
+      for (size_t nn = 0; nn < size; ++nn) {
+        const size_t ii = lower ? begin + nn : end - 1 - nn;
+        K* b_ii = b + ii * ldb;
+        for (size_t ll = (lower ? begin : ii + 1); ll < (lower ? ii : end); ++ll)
+          axpy_contiguous(cols, -t[ii * k + ll], b + ll * ldb, b_ii, std::false_type());
+        if (!unit) {
+          const K diagonal = t[ii * k + ii];
+          for (size_t jj = 0; jj < cols; ++jj)
+            b_ii[jj] /= diagonal;
+        }
+      }
+    } else {
+      // the block columns of X, starting at the left (upper) or at the right (lower)
+      const size_t begin = lower ? k - block - size : block;
+      const size_t end = begin + size;
+      for (size_t ii = 0; ii < rows; ++ii) {
+        K* x = b + ii * ldb;
+        for (size_t nn = 0; nn < size; ++nn) {
+          const size_t jj = lower ? end - 1 - nn : begin + nn;
+          if (!unit)
+            x[jj] /= t[jj * k + jj];
+          if (lower)
+            axpy_contiguous(jj - begin, -x[jj], t + jj * k + begin, x + begin, std::false_type());
+          else
+            axpy_contiguous(end - 1 - jj, -x[jj], t + jj * k + jj + 1, x + jj + 1, std::false_type());
+        }
+      }
+      const size_t remaining_begin = lower ? 0 : end;
+      const size_t remaining = lower ? begin : k - end;
+      if (remaining > 0) {
+        update.resize(rows * remaining);
+        gemm(rows, remaining, size, b + begin, ldb, t + begin * k + remaining_begin, k, update.data(), remaining);
+        for (size_t ii = 0; ii < rows; ++ii)
+          axpy_contiguous(
+              remaining, K(-1), update.data() + ii * remaining, b + ii * ldb + remaining_begin, std::false_type());
+      }
+    }
+  }
+} // ... trsm_row_major(...)
+
+
+/**
+ * \brief Solves op(A) X = alpha B (left) or X op(A) = alpha B in place (X overwrites B), where B is m x n and A is
+ *        upper or lower triangular.
+ * \sa    cblas_dtrsm
+ */
+template <class K>
+void fallback_trsm(const bool row_major,
+                   const bool left,
+                   const bool lower,
+                   const bool trans,
+                   const bool conjugate,
+                   const bool unit,
+                   const int m,
+                   const int n,
+                   const K alpha,
+                   const K* a,
+                   const int lda,
+                   K* b,
+                   const int ldb)
+{
+  DUNE_THROW_IF(m < 0 || n < 0, Exceptions::wrong_input_given, "m = " << m << "\n   n = " << n);
+  if (m == 0 || n == 0)
+    return;
+  // we work on the rows of B (of B^T, if B is column major, where op(A) X = alpha B becomes X^T op(A)^T = alpha B^T)
+  const size_t rows = row_major ? m : n;
+  const size_t cols = row_major ? n : m;
+  if (alpha != K(1))
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        b[ii * ldb + jj] = (alpha == K(0)) ? K(0) : alpha * b[ii * ldb + jj];
+  if (alpha == K(0))
+    return;
+  const bool from_left = (left == row_major);
+  const size_t k = from_left ? rows : cols;
+  // T = op(A) (row major) or op(A)^T (column major) as a dense row-major matrix, in both cases the entries of T are
+  // stored row by row in a if A is not transposed
+  const bool t_lower = (lower != trans) == row_major;
+  std::vector<K> t(k * k, K(0));
+  for (size_t ii = 0; ii < k; ++ii)
+    for (size_t jj = (t_lower ? 0 : ii); jj < (t_lower ? ii + 1 : k); ++jj) {
+      const K& a_ij = trans ? a[ii + jj * lda] : a[ii * lda + jj];
+      t[ii * k + jj] = conjugate ? conj_if(a_ij, std::true_type()) : a_ij;
+    }
+  trsm_row_major(from_left, t_lower, unit, k, t.data(), rows, cols, b, ldb);
+} // ... fallback_trsm(...)
+
+
+//! op(A) as a row-major rows x cols matrix: A itself if possible, a copy in storage otherwise
+template <class K>
+const K* row_major_op(const bool row_major,
+                      const bool trans,
+                      const bool conjugate,
+                      const size_t rows,
+                      const size_t cols,
+                      const K* a,
+                      const size_t lda,
+                      std::vector<K>& storage,
+                      size_t& ld)
+{
+  const bool rows_are_contiguous = (row_major != trans);
+  if (rows_are_contiguous && !conjugate) {
+    ld = lda;
+    return a;
+  }
+  storage.resize(rows * cols);
+  ld = cols;
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj) {
+      const K& a_ij = rows_are_contiguous ? a[ii * lda + jj] : a[ii + jj * lda];
+      storage[ii * cols + jj] = conjugate ? conj_if(a_ij, std::true_type()) : a_ij;
+    }
+  return storage.data();
+} // ... row_major_op(...)
+
+
+/**
+ * \brief C = alpha op(A) op(B) + beta C, where op(A) is m x k and op(B) is k x n.
+ * \sa    cblas_dgemm
+ */
+template <class K>
+void fallback_gemm(const bool row_major,
+                   const bool transa,
+                   const bool conja,
+                   const bool transb,
+                   const bool conjb,
+                   const int m,
+                   const int n,
+                   const int k,
+                   const K alpha,
+                   const K* a,
+                   const int lda,
+                   const K* b,
+                   const int ldb,
+                   const K beta,
+                   K* c,
+                   const int ldc)
+{
+  DUNE_THROW_IF(m < 0 || n < 0 || k < 0,
+                Exceptions::wrong_input_given,
+                "m = " << m << "\n   n = " << n << "\n   k = " << k);
+  if (m == 0 || n == 0)
+    return;
+  std::vector<K> product(size_t(m) * n, K(0));
+  if (k > 0 && alpha != K(0)) {
+    std::vector<K> a_storage, b_storage;
+    size_t a_ld, b_ld;
+    const K* aa = row_major_op(row_major, transa, conja, m, k, a, lda, a_storage, a_ld);
+    const K* bb = row_major_op(row_major, transb, conjb, k, n, b, ldb, b_storage, b_ld);
+    gemm(m, n, k, aa, a_ld, bb, b_ld, product.data(), n);
+  }
+  // C(ii, jj) is c[ii * ldc + jj] (row major) or c[jj * ldc + ii]
+  const size_t outer = row_major ? m : n;
+  const size_t inner = row_major ? n : m;
+  for (size_t oo = 0; oo < outer; ++oo)
+    for (size_t ii = 0; ii < inner; ++ii) {
+      const K& p = row_major ? product[oo * n + ii] : product[ii * n + oo];
+      K& c_oi = c[oo * ldc + ii];
+      c_oi = (beta == K(0)) ? alpha * p : alpha * p + beta * c_oi;
+    }
+} // ... fallback_gemm(...)
+
+
+/**
+ * \brief C = alpha op(A) op(A)^T + beta C, where op(A) is n x k and only the upper or lower triangle of C is
+ *        referenced.
+ * \sa    cblas_dsyrk
+ */
+template <class K>
+void fallback_syrk(const bool row_major,
+                   const bool lower,
+                   const bool trans,
+                   const int n,
+                   const int k,
+                   const K alpha,
+                   const K* a,
+                   const int lda,
+                   const K beta,
+                   K* c,
+                   const int ldc)
+{
+  DUNE_THROW_IF(n < 0 || k < 0, Exceptions::wrong_input_given, "n = " << n << "\n   k = " << k);
+  if (n == 0)
+    return;
+  // the full product is cheaper with gemm than half of it without
+  std::vector<K> product(size_t(n) * n, K(0));
+  if (k > 0 && alpha != K(0)) {
+    std::vector<K> a_storage, a_t_storage;
+    size_t a_ld, a_t_ld;
+    const K* aa = row_major_op(row_major, trans, false, n, k, a, lda, a_storage, a_ld);
+    const K* aa_t = row_major_op(row_major, !trans, false, k, n, a, lda, a_t_storage, a_t_ld);
+    gemm(n, n, k, aa, a_ld, aa_t, a_t_ld, product.data(), n);
+  }
+  // the triangle is contiguous in the inner index for row major and lower or column major and upper, product is
+  // symmetric
+  const bool triangle_before_diagonal = (lower == row_major);
+  for (size_t oo = 0; oo < size_t(n); ++oo)
+    for (size_t ii = (triangle_before_diagonal ? 0 : oo); ii < (triangle_before_diagonal ? oo + 1 : n); ++ii) {
+      K& c_oi = c[oo * ldc + ii];
+      c_oi = (beta == K(0)) ? alpha * product[oo * n + ii] : alpha * product[oo * n + ii] + beta * c_oi;
+    }
+} // ... fallback_syrk(...)
+
+
+/**
+ * \brief Cholesky factorization A = L L^T in place, for the lower triangle of a dense row-major n x n matrix.
+ *
+ *        Blocked: after the factorization of a block column, its contribution is subtracted from the remaining lower
+ *        triangle by gemm().
+ * \returns 0 or ii + 1, if the leading minor of order ii + 1 is not positive definite (as LAPACK's info)
+ */
+template <class R>
+int cholesky_row_major(const size_t n, R* l, const size_t ld)
+{
+  const size_t block_size = 64;
+  const size_t row_block_size = 128;
+  std::vector<R> panel_t, update;
+  for (size_t j0 = 0; j0 < n; j0 += block_size) {
+    const size_t j1 = std::min(n, j0 + block_size);
+    // the diagonal block and the panel below, the previous block columns have already been subtracted
+    for (size_t ii = j0; ii < n; ++ii) {
+      R* l_ii = l + ii * ld;
+      for (size_t jj = j0; jj < std::min(ii, j1); ++jj)
+        l_ii[jj] = (l_ii[jj] - dot_contiguous(jj - j0, l_ii + j0, l + jj * ld + j0, std::false_type()))
+                   / l[jj * ld + jj];
+      if (ii < j1) {
+        const R diagonal = l_ii[ii] - dot_contiguous(ii - j0, l_ii + j0, l_ii + j0, std::false_type());
+        if (!(diagonal > 0)) {
+          l_ii[ii] = diagonal;
+          return int(ii + 1);
+        }
+        l_ii[ii] = std::sqrt(diagonal);
+      }
+    }
+    if (j1 == n)
+      break;
+    // A[j1:n, j1:n] -= L[j1:n, j0:j1] L[j1:n, j0:j1]^T, block row by block row, the columns up to the diagonal
+    const size_t width = j1 - j0;
+    const size_t remaining = n - j1;
+    panel_t.resize(width * remaining);
+    for (size_t ii = 0; ii < remaining; ++ii)
+      for (size_t jj = 0; jj < width; ++jj)
+        panel_t[jj * remaining + ii] = l[(j1 + ii) * ld + j0 + jj];
+    for (size_t i0 = j1; i0 < n; i0 += row_block_size) {
+      const size_t i1 = std::min(n, i0 + row_block_size);
+      const size_t cols = i1 - j1;
+      update.resize((i1 - i0) * cols);
+      gemm(i1 - i0, cols, width, l + i0 * ld + j0, ld, panel_t.data(), remaining, update.data(), cols);
+      for (size_t ii = i0; ii < i1; ++ii)
+        axpy_contiguous(ii + 1 - j1, R(-1), update.data() + (ii - i0) * cols, l + ii * ld + j1, std::false_type());
+    }
+  }
+  return 0;
+} // ... cholesky_row_major(...)
+
+
+/**
+ * \brief Cholesky factorization of a symmetric positive definite matrix, only the upper or lower triangle is
+ *        referenced and overwritten.
+ * \sa    LAPACKE_dpotrf
+ */
+template <class R>
+int fallback_potrf(const bool row_major, const bool lower, const int n, R* a, const int lda)
+{
+  if (n < 0)
+    return -3;
+  if (lda < std::max(1, n))
+    return -5;
+  if (n == 0)
+    return 0;
+  // L (the lower triangle or the transposed upper one) is stored row by row for row major and lower or column major
+  // and upper, column by column otherwise
+  if (lower == row_major)
+    return cholesky_row_major(n, a, lda);
+  std::vector<R> l(size_t(n) * n);
+  for (size_t jj = 0; jj < size_t(n); ++jj)
+    for (size_t ii = jj; ii < size_t(n); ++ii)
+      l[ii * n + jj] = a[jj * lda + ii];
+  const int info = cholesky_row_major(n, l.data(), n);
+  for (size_t jj = 0; jj < size_t(n); ++jj)
+    for (size_t ii = jj; ii < size_t(n); ++ii)
+      a[jj * lda + ii] = l[ii * n + jj];
+  return info;
+} // ... fallback_potrf(...)
+
+
+/**
+ * \brief L D L^T factorization of a symmetric positive definite tridiagonal matrix (the diagonal d, the subdiagonal e
+ *        are overwritten by D and the subdiagonal of L).
+ * \sa    LAPACKE_dpttrf
+ */
+template <class R>
+int fallback_pttrf(const int n, R* d, R* e)
+{
+  if (n < 0)
+    return -1;
+  for (int ii = 0; ii + 1 < n; ++ii) {
+    if (d[ii] <= 0)
+      return ii + 1;
+    const R e_ii = e[ii];
+    e[ii] = e_ii / d[ii];
+    d[ii + 1] -= e[ii] * e_ii;
+  }
+  if (n > 0 && d[n - 1] <= 0)
+    return n;
+  return 0;
+} // ... fallback_pttrf(...)
+
+
+/**
+ * \brief Solves A X = B in place for the n x nrhs matrix B, given the factorization of fallback_pttrf.
+ * \sa    LAPACKE_dpttrs
+ */
+template <class R>
+int fallback_pttrs(const bool row_major, const int n, const int nrhs, const R* d, const R* e, R* b, const int ldb)
+{
+  if (n < 0)
+    return -2;
+  if (nrhs < 0)
+    return -3;
+  if (ldb < std::max(1, row_major ? nrhs : n))
+    return -7;
+  if (n == 0 || nrhs == 0)
+    return 0;
+  if (row_major) {
+    // the rows are contiguous, so we solve for all right hand sides at once
+    for (size_t ii = 1; ii < size_t(n); ++ii)
+      axpy_contiguous(nrhs, -e[ii - 1], b + (ii - 1) * ldb, b + ii * ldb, std::false_type());
+    for (size_t nn = 0; nn < size_t(n); ++nn) {
+      const size_t ii = n - 1 - nn;
+      R* b_ii = b + ii * ldb;
+      for (size_t jj = 0; jj < size_t(nrhs); ++jj)
+        b_ii[jj] /= d[ii];
+      if (ii + 1 < size_t(n))
+        axpy_contiguous(nrhs, -e[ii], b_ii + ldb, b_ii, std::false_type());
+    }
+  } else {
+    for (size_t jj = 0; jj < size_t(nrhs); ++jj) {
+      R* x = b + jj * ldb;
+      for (size_t ii = 1; ii < size_t(n); ++ii)
+        x[ii] -= e[ii - 1] * x[ii - 1];
+      x[n - 1] /= d[n - 1];
+      for (size_t nn = 1; nn < size_t(n); ++nn) {
+        const size_t ii = n - 1 - nn;
+        x[ii] = x[ii] / d[ii] - e[ii] * x[ii + 1];
+      }
+    }
+  }
+  return 0;
+} // ... fallback_pttrs(...)
+
+
+/**
+ * \brief The machine parameters of R.
+ * \sa    LAPACKE_dlamch
+ */
+template <class R>
+R fallback_lamch(const char cmach)
+{
+  typedef std::numeric_limits<R> L;
+  switch (cmach) {
+    case 'E':
+    case 'e':
+      // the relative machine precision, since rounding is used
+      return L::epsilon() / 2;
+    case 'S':
+    case 's':
+      return L::min();
+    case 'B':
+    case 'b':
+      return R(L::radix);
+    case 'P':
+    case 'p':
+      return L::epsilon();
+    case 'N':
+    case 'n':
+      return R(L::digits);
+    case 'R':
+    case 'r':
+      return R(1);
+    case 'M':
+    case 'm':
+      return R(L::min_exponent);
+    case 'U':
+    case 'u':
+      return L::min();
+    case 'L':
+    case 'l':
+      return R(L::max_exponent);
+    case 'O':
+    case 'o':
+      return L::max();
+    default:
+      return R(0);
+  }
+} // ... fallback_lamch(...)
+
+
+/**
+ * \brief Generates an elementary reflector H = I - tau v v^T with H [alpha, x] = [beta, 0], v = [1, x_new].
+ *
+ *        alpha and x (n - 1 entries) are overwritten by beta and x_new.
+ * \sa    dlarfg
+ */
+template <class R>
+R householder_reflector(const size_t n, R& alpha, R* x)
+{
+  if (n <= 1)
+    return R(0);
+  const R x_norm = nrm2_contiguous(n - 1, x);
+  if (x_norm == R(0))
+    return R(0);
+  const R beta = alpha >= 0 ? -std::hypot(alpha, x_norm) : std::hypot(alpha, x_norm);
+  const R tau = (beta - alpha) / beta;
+  const R scale = R(1) / (alpha - beta);
+  for (size_t ii = 0; ii < n - 1; ++ii)
+    x[ii] *= scale;
+  alpha = beta;
+  return tau;
+} // ... householder_reflector(...)
+
+
+//! applies H = I - tau v v^T (v[0] = 1, the other entries below the diagonal of column ii) from the left to the
+//! columns ii + 1, ..., n - 1 of the column-major m x n matrix a
+template <class R>
+void apply_householder_reflector(const size_t m, const size_t n, R* a, const size_t lda, const size_t ii, const R tau)
+{
+  if (tau == R(0))
+    return;
+  R* v = a + ii * lda + ii;
+  const R diagonal = *v;
+  *v = R(1);
+  for (size_t jj = ii + 1; jj < n; ++jj) {
+    R* col = a + jj * lda + ii;
+    axpy_contiguous(m - ii, -tau * dot_contiguous(m - ii, v, col, std::false_type()), v, col, std::false_type());
+  }
+  *v = diagonal;
+} // ... apply_householder_reflector(...)
+
+
+/**
+ * \brief QR factorization with column pivoting of a column-major m x n matrix, \sa fallback_geqp3.
+ *
+ *        Unblocked, along the lines of LAPACK's dgeqp3 and dlaqp2: the columns with jpvt[jj] != 0 are moved to the
+ *        front and factorized first, the others are pivoted by their partial norms, which are downdated after each
+ *        step (and recomputed, if the downdate is inaccurate).
+ */
+template <class R>
+void qr_with_column_pivoting(const size_t m, const size_t n, R* a, const size_t lda, int* jpvt, R* tau)
+{
+  const auto swap_columns = [&](const size_t j1, const size_t j2) {
+    std::swap_ranges(a + j1 * lda, a + j1 * lda + m, a + j2 * lda);
+  };
+  size_t num_fixed = 0;
+  for (size_t jj = 0; jj < n; ++jj) {
+    if (jpvt[jj] != 0) {
+      if (jj != num_fixed) {
+        swap_columns(jj, num_fixed);
+        jpvt[jj] = jpvt[num_fixed];
+        jpvt[num_fixed] = int(jj + 1);
+      } else
+        jpvt[jj] = int(jj + 1);
+      ++num_fixed;
+    } else
+      jpvt[jj] = int(jj + 1);
+  }
+  const size_t k = std::min(m, n);
+  for (size_t ii = 0; ii < std::min(num_fixed, k); ++ii) {
+    tau[ii] = householder_reflector(m - ii, a[ii * lda + ii], a + ii * lda + ii + 1);
+    apply_householder_reflector(m, n, a, lda, ii, tau[ii]);
+  }
+  if (num_fixed >= k)
+    return;
+  // the partial and the last exactly computed norms of the free columns
+  std::vector<R> partial_norms(n), norms(n);
+  for (size_t jj = num_fixed; jj < n; ++jj) {
+    partial_norms[jj] = nrm2_contiguous(m - num_fixed, a + jj * lda + num_fixed);
+    norms[jj] = partial_norms[jj];
+  }
+  const R tolerance = std::sqrt(fallback_lamch<R>('E'));
+  for (size_t ii = num_fixed; ii < k; ++ii) {
+    const size_t pivot =
+        std::distance(partial_norms.begin(), std::max_element(partial_norms.begin() + ii, partial_norms.end()));
+    if (pivot != ii) {
+      swap_columns(pivot, ii);
+      std::swap(jpvt[pivot], jpvt[ii]);
+      partial_norms[pivot] = partial_norms[ii];
+      norms[pivot] = norms[ii];
+    }
+    tau[ii] = householder_reflector(m - ii, a[ii * lda + ii], a + ii * lda + ii + 1);
+    apply_householder_reflector(m, n, a, lda, ii, tau[ii]);
+    for (size_t jj = ii + 1; jj < n; ++jj) {
+      if (partial_norms[jj] == R(0))
+        continue;
+      const R ratio = std::abs(a[jj * lda + ii]) / partial_norms[jj];
+      const R factor = std::max(R(0), (R(1) - ratio) * (R(1) + ratio));
+      const R relative = partial_norms[jj] / norms[jj];
+      if (factor * relative * relative <= tolerance) {
+        partial_norms[jj] = (ii + 1 < m) ? nrm2_contiguous(m - ii - 1, a + jj * lda + ii + 1) : R(0);
+        norms[jj] = partial_norms[jj];
+      } else
+        partial_norms[jj] *= std::sqrt(factor);
+    }
+  }
+} // ... qr_with_column_pivoting(...)
+
+
+/**
+ * \brief QR factorization with column pivoting A P = Q R.
+ * \sa    LAPACKE_dgeqp3
+ */
+template <class R>
+int fallback_geqp3(const bool row_major, const int m, const int n, R* a, const int lda, int* jpvt, R* tau)
+{
+  if (m < 0)
+    return -2;
+  if (n < 0)
+    return -3;
+  if (lda < std::max(1, row_major ? n : m))
+    return -5;
+  if (m == 0 || n == 0) {
+    for (int jj = 0; jj < n; ++jj)
+      jpvt[jj] = jj + 1;
+    return 0;
+  }
+  // the columns of the matrix are contiguous in column-major storage
+  if (!row_major) {
+    qr_with_column_pivoting(m, n, a, lda, jpvt, tau);
+    return 0;
+  }
+  std::vector<R> a_t(size_t(m) * n);
+  for (size_t ii = 0; ii < size_t(m); ++ii)
+    for (size_t jj = 0; jj < size_t(n); ++jj)
+      a_t[jj * m + ii] = a[ii * lda + jj];
+  qr_with_column_pivoting(m, n, a_t.data(), m, jpvt, tau);
+  for (size_t ii = 0; ii < size_t(m); ++ii)
+    for (size_t jj = 0; jj < size_t(n); ++jj)
+      a[ii * lda + jj] = a_t[jj * m + ii];
+  return 0;
+} // ... fallback_geqp3(...)
+
+
+/**
+ * \brief Overwrites the column-major m x n matrix a (the first k reflectors of a QR factorization) by the first n
+ *        columns of Q, \sa fallback_orgqr.
+ */
+template <class R>
+void householder_q(const size_t m, const size_t n, const size_t k, R* a, const size_t lda, const R* tau)
+{
+  for (size_t jj = k; jj < n; ++jj) {
+    std::fill(a + jj * lda, a + jj * lda + m, R(0));
+    a[jj * lda + jj] = R(1);
+  }
+  for (size_t nn = 0; nn < k; ++nn) {
+    const size_t ii = k - 1 - nn;
+    R* col = a + ii * lda;
+    apply_householder_reflector(m, n, a, lda, ii, tau[ii]);
+    for (size_t ll = ii + 1; ll < m; ++ll)
+      col[ll] *= -tau[ii];
+    col[ii] = R(1) - tau[ii];
+    std::fill(col, col + ii, R(0));
+  }
+} // ... householder_q(...)
+
+
+/**
+ * \brief Generates the m x n matrix Q with orthonormal columns from the first k reflectors of fallback_geqp3.
+ * \sa    LAPACKE_dorgqr
+ */
+template <class R>
+int fallback_orgqr(const bool row_major, const int m, const int n, const int k, R* a, const int lda, const R* tau)
+{
+  if (m < 0)
+    return -2;
+  if (n < 0 || n > m)
+    return -3;
+  if (k < 0 || k > n)
+    return -4;
+  if (lda < std::max(1, row_major ? n : m))
+    return -6;
+  if (n == 0)
+    return 0;
+  if (!row_major) {
+    householder_q(m, n, k, a, lda, tau);
+    return 0;
+  }
+  std::vector<R> a_t(size_t(m) * n);
+  for (size_t ii = 0; ii < size_t(m); ++ii)
+    for (size_t jj = 0; jj < size_t(n); ++jj)
+      a_t[jj * m + ii] = a[ii * lda + jj];
+  householder_q(m, n, k, a_t.data(), m, tau);
+  for (size_t ii = 0; ii < size_t(m); ++ii)
+    for (size_t jj = 0; jj < size_t(n); ++jj)
+      a[ii * lda + jj] = a_t[jj * m + ii];
+  return 0;
+} // ... fallback_orgqr(...)
+
+
+} // namespace internal
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_BLAS_FALLBACK_HH
@@ -12,36 +12,134 @@
 #include "config.h"
 
 #include <cmath>
+#include <complex>
 
-// Due to probles with old cblas versions, we only use the MKL cblas for the moment. See also
-// https://github.com/dune-community/dune-xt-common/pull/198.
 #if HAVE_MKL
 #  include <mkl.h>
+#elif HAVE_CBLAS
+#  include <cblas.h>
 #endif
 
+#include <dune/xt/common/blas_fallback.hh>
 #include <dune/xt/common/exceptions.hh>
-#include <dune/xt/common/unused.hh>
 
 #include "cblas.hh"
 
-#if HAVE_MKL
-#  define DXTC_CBLAS_ONLY(param) param
-#else
-#  define DXTC_CBLAS_ONLY(param) DXTC_UNUSED(param)
-#endif
-
 namespace Dune {
 namespace XT {
 namespace Common {
 namespace Cblas {
+namespace {
+
+
+#if HAVE_MKL || HAVE_CBLAS
+
+// The names of the enums differ between cblas implementations and versions (e.g., CBLAS_LAYOUT vs. CBLAS_ORDER, see
+// also https://github.com/dune-community/dune-xt-common/pull/198), so we only rely on the names of the values.
+typedef decltype(CblasRowMajor) Layout;
+typedef decltype(CblasNoTrans) Transpose;
+typedef decltype(CblasUpper) Uplo;
+typedef decltype(CblasNonUnit) Diag;
+typedef decltype(CblasLeft) Side;
+
+#else // HAVE_MKL || HAVE_CBLAS
+
+// the values of the cblas standard, which are used by all implementations
+enum Layout
+{
+  CblasRowMajor = 101,
+  CblasColMajor = 102
+};
+
+enum Transpose
+{
+  CblasNoTrans = 111,
+  CblasTrans = 112,
+  CblasConjTrans = 113
+};
+
+enum Uplo
+{
+  CblasUpper = 121,
+  CblasLower = 122
+};
+
+enum Diag
+{
+  CblasNonUnit = 131,
+  CblasUnit = 132
+};
+
+enum Side
+{
+  CblasLeft = 141,
+  CblasRight = 142
+};
+
+
+bool is_row_major(const int layout)
+{
+  DUNE_THROW_IF(
+      layout != CblasRowMajor && layout != CblasColMajor, Exceptions::wrong_input_given, "layout = " << layout);
+  return layout == CblasRowMajor;
+}
+
+bool is_transposed(const int trans)
+{
+  DUNE_THROW_IF(trans != CblasNoTrans && trans != CblasTrans && trans != CblasConjTrans,
+                Exceptions::wrong_input_given,
+                "trans = " << trans);
+  return trans != CblasNoTrans;
+}
+
+bool is_conjugated(const int trans)
+{
+  return is_transposed(trans) && trans == CblasConjTrans;
+}
+
+bool is_lower(const int uplo)
+{
+  DUNE_THROW_IF(uplo != CblasUpper && uplo != CblasLower, Exceptions::wrong_input_given, "uplo = " << uplo);
+  return uplo == CblasLower;
+}
+
+bool is_unit(const int diag)
+{
+  DUNE_THROW_IF(diag != CblasNonUnit && diag != CblasUnit, Exceptions::wrong_input_given, "diag = " << diag);
+  return diag == CblasUnit;
+}
+
+bool is_left(const int side)
+{
+  DUNE_THROW_IF(side != CblasLeft && side != CblasRight, Exceptions::wrong_input_given, "side = " << side);
+  return side == CblasLeft;
+}
+
+
+typedef std::complex<double> Complex;
+
+const Complex* as_complex(const void* x)
+{
+  return static_cast<const Complex*>(x);
+}
+
+Complex* as_complex(void* x)
+{
+  return static_cast<Complex*>(x);
+}
+
+#endif // HAVE_MKL || HAVE_CBLAS
+
+
+} // namespace
 
 
 /**
- * \brief If true, calling any of the other methods makes sense.
+ * \brief If true, the other methods are provided by an optimized library, by the kernels of blas_fallback.hh otherwise.
  */
 bool available()
 {
-#if HAVE_MKL
+#if HAVE_MKL || HAVE_CBLAS
   return true;
 #else
   return false;
@@ -51,130 +149,126 @@ bool available()
 
 int row_major()
 {
-#if HAVE_MKL
   return CblasRowMajor;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int col_major()
 {
-#if HAVE_MKL
   return CblasColMajor;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int left()
 {
-#if HAVE_MKL
   return CblasLeft;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int right()
 {
-#if HAVE_MKL
   return CblasRight;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int upper()
 {
-#if HAVE_MKL
   return CblasUpper;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int lower()
 {
-#if HAVE_MKL
   return CblasLower;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int trans()
 {
-#if HAVE_MKL
   return CblasTrans;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int no_trans()
 {
-#if HAVE_MKL
   return CblasNoTrans;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
+}
+
+
+int conj_trans()
+{
+  return CblasConjTrans;
 }
 
 
 int unit()
 {
-#if HAVE_MKL
   return CblasUnit;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int non_unit()
 {
-#if HAVE_MKL
   return CblasNonUnit;
+}
+
+
+double ddot(const int n, const double* x, const int incx, const double* y, const int incy)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  return cblas_ddot(n, x, incx, y, incy);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
-  return 1;
+  return internal::fallback_dot(n, x, incx, y, incy);
 #endif
 }
 
 
-void dgemv(const int DXTC_CBLAS_ONLY(layout),
-           const int DXTC_CBLAS_ONLY(trans),
-           const int DXTC_CBLAS_ONLY(m),
-           const int DXTC_CBLAS_ONLY(n),
-           const double DXTC_CBLAS_ONLY(alpha),
-           const double* DXTC_CBLAS_ONLY(a),
-           const int DXTC_CBLAS_ONLY(lda),
-           const double* DXTC_CBLAS_ONLY(x),
-           const int DXTC_CBLAS_ONLY(incx),
-           const double DXTC_CBLAS_ONLY(beta),
-           double* DXTC_CBLAS_ONLY(y),
-           const int DXTC_CBLAS_ONLY(incy))
+void daxpy(const int n, const double alpha, const double* x, const int incx, double* y, const int incy)
 {
-#if HAVE_MKL
-  cblas_dgemv(static_cast<CBLAS_LAYOUT>(layout),
-              static_cast<CBLAS_TRANSPOSE>(trans),
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_daxpy(n, alpha, x, incx, y, incy);
+#else
+  internal::fallback_axpy(n, alpha, x, incx, y, incy);
+#endif
+}
+
+
+double dnrm2(const int n, const double* x, const int incx)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  return cblas_dnrm2(n, x, incx);
+#else
+  return internal::fallback_nrm2(n, x, incx);
+#endif
+}
+
+
+void dscal(const int n, const double alpha, double* x, const int incx)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dscal(n, alpha, x, incx);
+#else
+  internal::fallback_scal(n, alpha, x, incx);
+#endif
+}
+
+
+void dgemv(const int layout,
+           const int trans,
+           const int m,
+           const int n,
+           const double alpha,
+           const double* a,
+           const int lda,
+           const double* x,
+           const int incx,
+           const double beta,
+           double* y,
+           const int incy)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dgemv(static_cast<Layout>(layout),
+              static_cast<Transpose>(trans),
               m,
               n,
               alpha,
@@ -186,30 +280,113 @@ void dgemv(const int DXTC_CBLAS_ONLY(layout),
               y,
               incy);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
+  internal::fallback_gemv(
+      is_row_major(layout), is_transposed(trans), false, m, n, alpha, a, lda, x, incx, beta, y, incy);
 #endif
 }
 
 
-void dtrsm(const int DXTC_CBLAS_ONLY(layout),
-           const int DXTC_CBLAS_ONLY(side),
-           const int DXTC_CBLAS_ONLY(uplo),
-           const int DXTC_CBLAS_ONLY(transa),
-           const int DXTC_CBLAS_ONLY(diag),
-           const int DXTC_CBLAS_ONLY(m),
-           const int DXTC_CBLAS_ONLY(n),
-           const double DXTC_CBLAS_ONLY(alpha),
-           const double* DXTC_CBLAS_ONLY(a),
-           const int DXTC_CBLAS_ONLY(lda),
-           double* DXTC_CBLAS_ONLY(b),
-           const int DXTC_CBLAS_ONLY(ldb))
+void dgemm(const int layout,
+           const int transa,
+           const int transb,
+           const int m,
+           const int n,
+           const int k,
+           const double alpha,
+           const double* a,
+           const int lda,
+           const double* b,
+           const int ldb,
+           const double beta,
+           double* c,
+           const int ldc)
 {
-#if HAVE_MKL
-  cblas_dtrsm(static_cast<CBLAS_LAYOUT>(layout),
-              static_cast<CBLAS_SIDE>(side),
-              static_cast<CBLAS_UPLO>(uplo),
-              static_cast<CBLAS_TRANSPOSE>(transa),
-              static_cast<CBLAS_DIAG>(diag),
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dgemm(static_cast<Layout>(layout),
+              static_cast<Transpose>(transa),
+              static_cast<Transpose>(transb),
+              m,
+              n,
+              k,
+              alpha,
+              a,
+              lda,
+              b,
+              ldb,
+              beta,
+              c,
+              ldc);
+#else
+  internal::fallback_gemm(is_row_major(layout),
+                          is_transposed(transa),
+                          false,
+                          is_transposed(transb),
+                          false,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          a,
+                          lda,
+                          b,
+                          ldb,
+                          beta,
+                          c,
+                          ldc);
+#endif
+}
+
+
+void dsyrk(const int layout,
+           const int uplo,
+           const int trans,
+           const int n,
+           const int k,
+           const double alpha,
+           const double* a,
+           const int lda,
+           const double beta,
+           double* c,
+           const int ldc)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dsyrk(static_cast<Layout>(layout),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(trans),
+              n,
+              k,
+              alpha,
+              a,
+              lda,
+              beta,
+              c,
+              ldc);
+#else
+  internal::fallback_syrk(
+      is_row_major(layout), is_lower(uplo), is_transposed(trans), n, k, alpha, a, lda, beta, c, ldc);
+#endif
+}
+
+
+void dtrsm(const int layout,
+           const int side,
+           const int uplo,
+           const int transa,
+           const int diag,
+           const int m,
+           const int n,
+           const double alpha,
+           const double* a,
+           const int lda,
+           double* b,
+           const int ldb)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dtrsm(static_cast<Layout>(layout),
+              static_cast<Side>(side),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(transa),
+              static_cast<Diag>(diag),
               m,
               n,
               alpha,
@@ -217,67 +394,221 @@ void dtrsm(const int DXTC_CBLAS_ONLY(layout),
               lda,
               b,
               ldb);
-#  ifndef NDEBUG
+#else
+  internal::fallback_trsm(is_row_major(layout),
+                          is_left(side),
+                          is_lower(uplo),
+                          is_transposed(transa),
+                          false,
+                          is_unit(diag),
+                          m,
+                          n,
+                          alpha,
+                          a,
+                          lda,
+                          b,
+                          ldb);
+#endif
+#ifndef NDEBUG
   for (int ii = 0; ii < m; ++ii)
     if (std::isnan(b[ii]) || std::isinf(b[ii]))
       DUNE_THROW(Dune::MathError, "Triangular solve using cblas_dtrsm failed!");
-#  endif
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
 #endif
 }
 
 
-void dtrsv(const int DXTC_CBLAS_ONLY(layout),
-           const int DXTC_CBLAS_ONLY(uplo),
-           const int DXTC_CBLAS_ONLY(transa),
-           const int DXTC_CBLAS_ONLY(diag),
-           const int DXTC_CBLAS_ONLY(n),
-           const double* DXTC_CBLAS_ONLY(a),
-           const int DXTC_CBLAS_ONLY(lda),
-           double* DXTC_CBLAS_ONLY(x),
-           const int DXTC_CBLAS_ONLY(incx))
+void dtrsv(const int layout,
+           const int uplo,
+           const int transa,
+           const int diag,
+           const int n,
+           const double* a,
+           const int lda,
+           double* x,
+           const int incx)
 {
-#if HAVE_MKL
-  cblas_dtrsv(static_cast<CBLAS_LAYOUT>(layout),
-              static_cast<CBLAS_UPLO>(uplo),
-              static_cast<CBLAS_TRANSPOSE>(transa),
-              static_cast<CBLAS_DIAG>(diag),
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_dtrsv(static_cast<Layout>(layout),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(transa),
+              static_cast<Diag>(diag),
               n,
               a,
               lda,
               x,
               incx);
-#  ifndef NDEBUG
+#else
+  internal::fallback_trsv(
+      is_row_major(layout), is_lower(uplo), is_transposed(transa), false, is_unit(diag), n, a, lda, x, incx);
+#endif
+#ifndef NDEBUG
   for (int ii = 0; ii < n; ++ii)
     if (std::isnan(x[ii]) || std::isinf(x[ii]))
       DUNE_THROW(Dune::MathError, "Triangular solve using cblas_dtrsv failed!");
-#  endif
+#endif
+}
+
+
+void zdotc_sub(const int n, const void* x, const int incx, const void* y, const int incy, void* dotc)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zdotc_sub(n, x, incx, y, incy, dotc);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
+  *as_complex(dotc) = internal::fallback_dot(n, as_complex(x), incx, as_complex(y), incy, true);
 #endif
 }
 
 
-void ztrsm(const int DXTC_CBLAS_ONLY(layout),
-           const int DXTC_CBLAS_ONLY(side),
-           const int DXTC_CBLAS_ONLY(uplo),
-           const int DXTC_CBLAS_ONLY(transa),
-           const int DXTC_CBLAS_ONLY(diag),
-           const int DXTC_CBLAS_ONLY(m),
-           const int DXTC_CBLAS_ONLY(n),
-           const void* DXTC_CBLAS_ONLY(alpha),
-           const void* DXTC_CBLAS_ONLY(a),
-           const int DXTC_CBLAS_ONLY(lda),
-           void* DXTC_CBLAS_ONLY(b),
-           const int DXTC_CBLAS_ONLY(ldb))
+void zdotu_sub(const int n, const void* x, const int incx, const void* y, const int incy, void* dotu)
 {
-#if HAVE_MKL
-  cblas_ztrsm(static_cast<CBLAS_LAYOUT>(layout),
-              static_cast<CBLAS_SIDE>(side),
-              static_cast<CBLAS_UPLO>(uplo),
-              static_cast<CBLAS_TRANSPOSE>(transa),
-              static_cast<CBLAS_DIAG>(diag),
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zdotu_sub(n, x, incx, y, incy, dotu);
+#else
+  *as_complex(dotu) = internal::fallback_dot(n, as_complex(x), incx, as_complex(y), incy);
+#endif
+}
+
+
+void zaxpy(const int n, const void* alpha, const void* x, const int incx, void* y, const int incy)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zaxpy(n, alpha, x, incx, y, incy);
+#else
+  internal::fallback_axpy(n, *as_complex(alpha), as_complex(x), incx, as_complex(y), incy);
+#endif
+}
+
+
+double dznrm2(const int n, const void* x, const int incx)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  return cblas_dznrm2(n, x, incx);
+#else
+  return internal::fallback_nrm2(n, as_complex(x), incx);
+#endif
+}
+
+
+void zscal(const int n, const void* alpha, void* x, const int incx)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zscal(n, alpha, x, incx);
+#else
+  internal::fallback_scal(n, *as_complex(alpha), as_complex(x), incx);
+#endif
+}
+
+
+void zgemm(const int layout,
+           const int transa,
+           const int transb,
+           const int m,
+           const int n,
+           const int k,
+           const void* alpha,
+           const void* a,
+           const int lda,
+           const void* b,
+           const int ldb,
+           const void* beta,
+           void* c,
+           const int ldc)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zgemm(static_cast<Layout>(layout),
+              static_cast<Transpose>(transa),
+              static_cast<Transpose>(transb),
+              m,
+              n,
+              k,
+              alpha,
+              a,
+              lda,
+              b,
+              ldb,
+              beta,
+              c,
+              ldc);
+#else
+  internal::fallback_gemm(is_row_major(layout),
+                          is_transposed(transa),
+                          is_conjugated(transa),
+                          is_transposed(transb),
+                          is_conjugated(transb),
+                          m,
+                          n,
+                          k,
+                          *as_complex(alpha),
+                          as_complex(a),
+                          lda,
+                          as_complex(b),
+                          ldb,
+                          *as_complex(beta),
+                          as_complex(c),
+                          ldc);
+#endif
+}
+
+
+void zsyrk(const int layout,
+           const int uplo,
+           const int trans,
+           const int n,
+           const int k,
+           const void* alpha,
+           const void* a,
+           const int lda,
+           const void* beta,
+           void* c,
+           const int ldc)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_zsyrk(static_cast<Layout>(layout),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(trans),
+              n,
+              k,
+              alpha,
+              a,
+              lda,
+              beta,
+              c,
+              ldc);
+#else
+  internal::fallback_syrk(is_row_major(layout),
+                          is_lower(uplo),
+                          is_transposed(trans),
+                          n,
+                          k,
+                          *as_complex(alpha),
+                          as_complex(a),
+                          lda,
+                          *as_complex(beta),
+                          as_complex(c),
+                          ldc);
+#endif
+}
+
+
+void ztrsm(const int layout,
+           const int side,
+           const int uplo,
+           const int transa,
+           const int diag,
+           const int m,
+           const int n,
+           const void* alpha,
+           const void* a,
+           const int lda,
+           void* b,
+           const int ldb)
+{
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_ztrsm(static_cast<Layout>(layout),
+              static_cast<Side>(side),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(transa),
+              static_cast<Diag>(diag),
               m,
               n,
               alpha,
@@ -285,46 +616,67 @@ void ztrsm(const int DXTC_CBLAS_ONLY(layout),
               lda,
               b,
               ldb);
-#  ifndef NDEBUG
+#else
+  internal::fallback_trsm(is_row_major(layout),
+                          is_left(side),
+                          is_lower(uplo),
+                          is_transposed(transa),
+                          is_conjugated(transa),
+                          is_unit(diag),
+                          m,
+                          n,
+                          *as_complex(alpha),
+                          as_complex(a),
+                          lda,
+                          as_complex(b),
+                          ldb);
+#endif
+#ifndef NDEBUG
   for (int ii = 0; ii < m; ++ii)
     if (std::isnan(std::abs(static_cast<std::complex<double>*>(b)[ii]))
         || std::isinf(std::abs(static_cast<std::complex<double>*>(b)[ii])))
       DUNE_THROW(Dune::MathError, "Triangular solve using cblas_ztrsm failed!");
-#  endif
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
 #endif
 }
 
 
-void ztrsv(const int DXTC_CBLAS_ONLY(layout),
-           const int DXTC_CBLAS_ONLY(uplo),
-           const int DXTC_CBLAS_ONLY(transa),
-           const int DXTC_CBLAS_ONLY(diag),
-           const int DXTC_CBLAS_ONLY(n),
-           const void* DXTC_CBLAS_ONLY(a),
-           const int DXTC_CBLAS_ONLY(lda),
-           void* DXTC_CBLAS_ONLY(x),
-           const int DXTC_CBLAS_ONLY(incx))
+void ztrsv(const int layout,
+           const int uplo,
+           const int transa,
+           const int diag,
+           const int n,
+           const void* a,
+           const int lda,
+           void* x,
+           const int incx)
 {
-#if HAVE_MKL
-  cblas_ztrsv(static_cast<CBLAS_LAYOUT>(layout),
-              static_cast<CBLAS_UPLO>(uplo),
-              static_cast<CBLAS_TRANSPOSE>(transa),
-              static_cast<CBLAS_DIAG>(diag),
+#if HAVE_MKL || HAVE_CBLAS
+  cblas_ztrsv(static_cast<Layout>(layout),
+              static_cast<Uplo>(uplo),
+              static_cast<Transpose>(transa),
+              static_cast<Diag>(diag),
               n,
               a,
               lda,
               x,
               incx);
-#  ifndef NDEBUG
+#else
+  internal::fallback_trsv(is_row_major(layout),
+                          is_lower(uplo),
+                          is_transposed(transa),
+                          is_conjugated(transa),
+                          is_unit(diag),
+                          n,
+                          as_complex(a),
+                          lda,
+                          as_complex(x),
+                          incx);
+#endif
+#ifndef NDEBUG
   for (int ii = 0; ii < n; ++ii)
     if (std::isnan(std::abs(static_cast<std::complex<double>*>(x)[ii]))
         || std::isinf(std::abs(static_cast<std::complex<double>*>(x)[ii])))
       DUNE_THROW(Dune::MathError, "Triangular solve using cblas_ztrsv failed!");
-#  endif
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing CBLAS or the intel mkl, check available() first!");
 #endif
 }
 
@@ -17,7 +17,11 @@ namespace Cblas {
 
 
 /**
- * \brief If true, calling any of the other methods makes sense.
+ * \brief If true, the methods below are provided by an optimized library.
+ *
+ *        This is the case if the intel mkl or any other cblas (e.g., OpenBLAS, ATLAS or the reference cblas) was found
+ *        at configure time. Otherwise, the (slower) kernels of blas_fallback.hh are used, so calling the methods below
+ *        makes sense in any case. The complex variants expect pointers to std::complex<double>.
  */
 bool available();
 
@@ -78,6 +82,13 @@ int trans();
 int no_trans();
 
 
+/**
+ * \brief Wrapper around CblasConjTrans
+ * \sa    CblasConjTrans
+ */
+int conj_trans();
+
+
 /**
  * \brief Wrapper around CblasUnit
  * \sa    CblasUnit
@@ -92,6 +103,34 @@ int unit();
 int non_unit();
 
 
+/**
+ * \brief Wrapper around cblas_ddot
+ * \sa    cblas_ddot
+ */
+double ddot(const int n, const double* x, const int incx, const double* y, const int incy);
+
+
+/**
+ * \brief Wrapper around cblas_daxpy
+ * \sa    cblas_daxpy
+ */
+void daxpy(const int n, const double alpha, const double* x, const int incx, double* y, const int incy);
+
+
+/**
+ * \brief Wrapper around cblas_dnrm2
+ * \sa    cblas_dnrm2
+ */
+double dnrm2(const int n, const double* x, const int incx);
+
+
+/**
+ * \brief Wrapper around cblas_dscal
+ * \sa    cblas_dscal
+ */
+void dscal(const int n, const double alpha, double* x, const int incx);
+
+
 /**
  * \brief Wrapper around cblas_dgemv
  * \sa    cblas_dgemv
@@ -110,6 +149,43 @@ void dgemv(const int layout,
            const int incy);
 
 
+/**
+ * \brief Wrapper around cblas_dgemm
+ * \sa    cblas_dgemm
+ */
+void dgemm(const int layout,
+           const int transa,
+           const int transb,
+           const int m,
+           const int n,
+           const int k,
+           const double alpha,
+           const double* a,
+           const int lda,
+           const double* b,
+           const int ldb,
+           const double beta,
+           double* c,
+           const int ldc);
+
+
+/**
+ * \brief Wrapper around cblas_dsyrk
+ * \sa    cblas_dsyrk
+ */
+void dsyrk(const int layout,
+           const int uplo,
+           const int trans,
+           const int n,
+           const int k,
+           const double alpha,
+           const double* a,
+           const int lda,
+           const double beta,
+           double* c,
+           const int ldc);
+
+
 /**
  * \brief Wrapper around cblas_dtrsm
  * \sa    cblas_dtrsm
@@ -143,6 +219,81 @@ void dtrsv(const int layout,
            const int incx);
 
 
+/**
+ * \brief Wrapper around cblas_zdotc_sub
+ *
+ *        The result is written to dotc, since the complex return values of cblas_zdotc differ between
+ *        implementations.
+ * \sa    cblas_zdotc_sub
+ */
+void zdotc_sub(const int n, const void* x, const int incx, const void* y, const int incy, void* dotc);
+
+
+/**
+ * \brief Wrapper around cblas_zdotu_sub
+ * \sa    cblas_zdotu_sub
+ */
+void zdotu_sub(const int n, const void* x, const int incx, const void* y, const int incy, void* dotu);
+
+
+/**
+ * \brief Wrapper around cblas_zaxpy
+ * \sa    cblas_zaxpy
+ */
+void zaxpy(const int n, const void* alpha, const void* x, const int incx, void* y, const int incy);
+
+
+/**
+ * \brief Wrapper around cblas_dznrm2
+ * \sa    cblas_dznrm2
+ */
+double dznrm2(const int n, const void* x, const int incx);
+
+
+/**
+ * \brief Wrapper around cblas_zscal
+ * \sa    cblas_zscal
+ */
+void zscal(const int n, const void* alpha, void* x, const int incx);
+
+
+/**
+ * \brief Wrapper around cblas_zgemm
+ * \sa    cblas_zgemm
+ */
+void zgemm(const int layout,
+           const int transa,
+           const int transb,
+           const int m,
+           const int n,
+           const int k,
+           const void* alpha,
+           const void* a,
+           const int lda,
+           const void* b,
+           const int ldb,
+           const void* beta,
+           void* c,
+           const int ldc);
+
+
+/**
+ * \brief Wrapper around cblas_zsyrk
+ * \sa    cblas_zsyrk
+ */
+void zsyrk(const int layout,
+           const int uplo,
+           const int trans,
+           const int n,
+           const int k,
+           const void* alpha,
+           const void* a,
+           const int lda,
+           const void* beta,
+           void* c,
+           const int ldc);
+
+
 /**
  * \brief Wrapper around cblas_ztrsm
  * \sa    cblas_ztrsm
@@ -12,24 +12,384 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/format.hpp>
 
 #include <dune/common/parametertreeparser.hh>
 
 #include <dune/xt/common/filesystem.hh>
+#include <dune/xt/common/parallel/threadstorage.hh>
+#include <dune/xt/common/string.hh>
 
 #include "configuration.hh"
 
 namespace Dune {
 namespace XT {
 namespace Common {
+namespace internal {
+
+
+//! splitmix64 finalizer
+static std::uint64_t mix_bits(std::uint64_t hh)
+{
+  hh ^= hh >> 30;
+  hh *= 0xbf58476d1ce4e5b9ULL;
+  hh ^= hh >> 27;
+  hh *= 0x94d049bb133111ebULL;
+  hh ^= hh >> 31;
+  return hh;
+}
+
+/**
+ * \brief Hashes a single flattened key/value pair into two independent 64-bit lanes.
+ *
+ *        The lanes of all pairs are summed up (modulo 2^64) to obtain the fingerprint of a Configuration, which makes
+ *        it independent of the insertion order and allows to remove a pair by subtraction.
+ */
+static std::array<std::uint64_t, 2> hash_entry(const std::string& key, const std::string& value)
+{
+  // lane 0: FNV-1a, lane 1: multiplicative hash with a different constant, separated by a byte no key contains
+  std::uint64_t h0 = 0xcbf29ce484222325ULL;
+  std::uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+  const auto consume = [&](const std::string& str) {
+    for (const unsigned char cc : str) {
+      h0 = (h0 ^ cc) * 0x100000001b3ULL;
+      h1 = (h1 + cc + 1) * 0xff51afd7ed558ccdULL;
+    }
+  };
+  consume(key);
+  h0 = (h0 ^ 0xff) * 0x100000001b3ULL;
+  h1 = (h1 + 0x100) * 0xff51afd7ed558ccdULL;
+  consume(value);
+  return {{mix_bits(h0 ^ key.size()), mix_bits(h1 + value.size())}};
+} // ... hash_entry(...)
+
+static void accumulate_fingerprint(const ParameterTree& tree,
+                                   const std::string& prefix,
+                                   std::array<std::uint64_t, 2>& fingerprint)
+{
+  for (const auto& key : tree.getValueKeys()) {
+    const auto entry = hash_entry(prefix + key, tree[key]);
+    fingerprint[0] += entry[0];
+    fingerprint[1] += entry[1];
+  }
+  for (const auto& sub_key : tree.getSubKeys())
+    accumulate_fingerprint(tree.sub(sub_key), prefix + sub_key + ".", fingerprint);
+} // ... accumulate_fingerprint(...)
+
+static void flatten_into(const ParameterTree& tree, const std::string& prefix, std::map<std::string, std::string>& ret)
+{
+  for (const auto& key : tree.getValueKeys())
+    ret[prefix + key] = tree[key];
+  for (const auto& sub_key : tree.getSubKeys())
+    flatten_into(tree.sub(sub_key), prefix + sub_key + ".", ret);
+} // ... flatten_into(...)
+
+static std::array<std::uint64_t, 2> fingerprint(const ParameterTree& tree)
+{
+  std::array<std::uint64_t, 2> ret = {{0, 0}};
+  accumulate_fingerprint(tree, "", ret);
+  return ret;
+}
+
+static std::map<std::string, std::string> flatten(const ParameterTree& tree)
+{
+  std::map<std::string, std::string> ret;
+  flatten_into(tree, "", ret);
+  return ret;
+}
+
+
+struct ConfigurationAccessStatistics
+{
+  size_t count = 0;
+  std::chrono::steady_clock::duration duration = std::chrono::steady_clock::duration::zero();
+};
+
+/**
+ * Each thread records into its own map, so profiled get() calls from several threads do not contend. The maps are
+ * only merged when a report is requested, which locks each of them in turn since their threads may still record.
+ */
+class ConfigurationAccessProfile
+{
+  typedef std::map<std::string, ConfigurationAccessStatistics> MapType;
+
+  struct ThreadStatistics
+  {
+    MapType statistics;
+    std::mutex mutex;
+  };
+
+public:
+  void record(const std::string& key, const std::chrono::steady_clock::duration& duration)
+  {
+    // without TBB there is only one map for all threads, with TBB the lock is only contended by ranked()
+    auto& local = *thread_statistics_;
+    std::lock_guard<std::mutex> guard(local.mutex);
+    auto& stats = local.statistics[key];
+    ++stats.count;
+    stats.duration += duration;
+  }
+
+  //! \return (key, statistics) pairs of all threads, sorted by decreasing accumulated duration and count
+  std::vector<std::pair<std::string, ConfigurationAccessStatistics>> ranked()
+  {
+    MapType merged;
+    for (auto& local : thread_statistics_) {
+      std::lock_guard<std::mutex> guard(local.mutex);
+      for (const auto& element : local.statistics) {
+        auto& stats = merged[element.first];
+        stats.count += element.second.count;
+        stats.duration += element.second.duration;
+      }
+    }
+    std::vector<std::pair<std::string, ConfigurationAccessStatistics>> ret(merged.begin(), merged.end());
+    std::stable_sort(ret.begin(), ret.end(), [](const auto& lhs, const auto& rhs) {
+      if (lhs.second.duration != rhs.second.duration)
+        return lhs.second.duration > rhs.second.duration;
+      return lhs.second.count > rhs.second.count;
+    });
+    return ret;
+  } // ... ranked(...)
+
+private:
+  PerThreadValue<ThreadStatistics> thread_statistics_;
+}; // class ConfigurationAccessProfile
+
+static inline bool is_ini_whitespace(const char cc)
+{
+  return cc == ' ' || cc == '\t' || cc == '\n' || cc == '\r';
+}
+
+static inline const char* ltrim(const char* first, const char* last)
+{
+  while (first != last && is_ini_whitespace(*first))
+    ++first;
+  return first;
+}
+
+static inline const char* rtrim(const char* first, const char* last)
+{
+  while (last != first && is_ini_whitespace(*(last - 1)))
+    --last;
+  return last;
+}
+
+static inline const char* find_char(const char* first, const char* last, const char cc)
+{
+  const auto* found = static_cast<const char*>(std::memchr(first, cc, static_cast<size_t>(last - first)));
+  return found ? found : last;
+}
+
+static inline StringView make_view(const char* first, const char* last)
+{
+  return StringView(first, static_cast<size_t>(last - first));
+}
+
+static inline std::uint64_t fnv1a(std::uint64_t hh, const StringView str)
+{
+  for (const char cc : str)
+    hh = (hh ^ static_cast<unsigned char>(cc)) * 0x100000001b3ULL;
+  return hh;
+}
+
+/**
+ * \brief The full keys of an INI file, to detect duplicates.
+ *
+ *        The sections are interned, a key is stored as the index of its section and a view into the file, so that
+ *        inserting a key does not allocate (only the open addressing table grows from time to time).
+ */
+class IniKeySet
+{
+  struct Slot
+  {
+    std::uint64_t hash;
+    size_t section; // 0 marks an empty slot, the sections are numbered from 1
+    StringView key;
+  };
+
+public:
+  IniKeySet()
+    : slots_(64, Slot{0, 0, StringView()})
+    , size_(0)
+  {
+    intern_section("");
+  }
+
+  //! the id of the section with the given prefix (including the trailing '.'), to be passed to insert()
+  size_t intern_section(const std::string& prefix)
+  {
+    const auto found = section_ids_.find(prefix);
+    if (found != section_ids_.end())
+      return found->second;
+    prefixes_.push_back(prefix);
+    prefix_hashes_.push_back(fnv1a(0xcbf29ce484222325ULL, prefix));
+    section_ids_.emplace(prefix, prefixes_.size());
+    return prefixes_.size();
+  }
+
+  //! false if the full key (prefix of section and key) was inserted before, key has to outlive this set
+  bool insert(const size_t section, const StringView key)
+  {
+    if (2 * (size_ + 1) > slots_.size())
+      grow();
+    const std::uint64_t hash = fnv1a(prefix_hashes_[section - 1], key);
+    for (size_t ii = hash & (slots_.size() - 1);; ii = (ii + 1) & (slots_.size() - 1)) {
+      auto& slot = slots_[ii];
+      if (slot.section == 0) {
+        slot = Slot{hash, section, key};
+        ++size_;
+        return true;
+      }
+      if (slot.hash == hash && equal_full_keys(slot.section, slot.key, section, key))
+        return false;
+    }
+  } // ... insert(...)
+
+private:
+  bool equal_full_keys(const size_t left_section,
+                       const StringView left_key,
+                       const size_t right_section,
+                       const StringView right_key) const
+  {
+    const std::string& left_prefix = prefixes_[left_section - 1];
+    const std::string& right_prefix = prefixes_[right_section - 1];
+    const size_t size = left_prefix.size() + left_key.size();
+    if (size != right_prefix.size() + right_key.size())
+      return false;
+    // "a.b" in the root section is the same full key as "b" in section "a"
+    for (size_t ii = 0; ii < size; ++ii) {
+      const char left = ii < left_prefix.size() ? left_prefix[ii] : left_key[ii - left_prefix.size()];
+      const char right = ii < right_prefix.size() ? right_prefix[ii] : right_key[ii - right_prefix.size()];
+      if (left != right)
+        return false;
+    }
+    return true;
+  } // ... equal_full_keys(...)
+
+  void grow()
+  {
+    std::vector<Slot> old_slots(2 * slots_.size(), Slot{0, 0, StringView()});
+    std::swap(old_slots, slots_);
+    for (const auto& slot : old_slots) {
+      if (slot.section == 0)
+        continue;
+      size_t ii = slot.hash & (slots_.size() - 1);
+      while (slots_[ii].section != 0)
+        ii = (ii + 1) & (slots_.size() - 1);
+      slots_[ii] = slot;
+    }
+  } // ... grow(...)
+
+  std::vector<Slot> slots_;
+  size_t size_;
+  std::vector<std::string> prefixes_;
+  std::vector<std::uint64_t> prefix_hashes_;
+  std::unordered_map<std::string, size_t> section_ids_;
+}; // class IniKeySet
+
+/**
+ * \brief Single pass INI parser on a memory mapped file.
+ *
+ *        Has the same semantics as Dune::ParameterTreeParser::readINITree (sections, '#' comments, quoted multi-line
+ *        values, duplicate keys are an error, existing keys are only replaced if overwrite is true), but scans the
+ *        mapped file in place (as StringViews) instead of copying each line and looks up the tree of the current
+ *        section only once. Apart from the storage of the tree, only the section headers and quoted multi-line values
+ *        allocate.
+ */
+static void read_ini_tree(const std::string& filename, ParameterTree& tree, const bool overwrite = true)
+{
+  const MappedFile file(filename);
+  const char* const file_end = file.end();
+  std::string prefix;
+  size_t section_id = 1;
+  ParameterTree* section = &tree;
+  IniKeySet keys_in_file;
+  std::string key;
+  std::string value;
+  const char* pos = file.begin();
+  // mimics std::istream::eof() after getline: only set once a line was not terminated by a newline
+  bool eof = false;
+  while (pos != file_end) {
+    const char* line_end = find_char(pos, file_end, '\n');
+    eof = (line_end == file_end);
+    const char* next = eof ? file_end : line_end + 1;
+    const char* line_begin = ltrim(pos, line_end);
+    pos = next;
+    if (line_begin == line_end || *line_begin == '#')
+      continue;
+    if (*line_begin == '[') {
+      const char* close = find_char(line_begin, line_end, ']');
+      if (close != line_end) {
+        const char* name_begin = ltrim(line_begin + 1, close);
+        prefix.assign(name_begin, rtrim(name_begin, close));
+        if (!prefix.empty())
+          prefix.push_back('.');
+        section_id = keys_in_file.intern_section(prefix);
+        section = nullptr; // resolved on the first key, Dune does not create empty sections either
+      }
+      continue;
+    }
+    const char* content_end = find_char(line_begin, line_end, '#');
+    const char* mid = find_char(line_begin, content_end, '=');
+    if (mid == content_end)
+      continue;
+    const StringView key_view = make_view(line_begin, rtrim(line_begin, mid));
+    const char* value_begin = ltrim(mid + 1, content_end);
+    if (value_begin != content_end && (*value_begin == '\'' || *value_begin == '"')) {
+      // quoted values may span several lines, which are taken verbatim until one ends with the quote
+      const char quote = *value_begin;
+      value.assign(value_begin + 1, content_end);
+      while (value.empty() || *(rtrim(value.data(), value.data() + value.size()) - 1) != quote) {
+        if (!eof) {
+          const char* continuation_end = find_char(pos, file_end, '\n');
+          value.push_back('\n');
+          value.append(pos, continuation_end);
+          eof = (continuation_end == file_end);
+          pos = eof ? file_end : continuation_end + 1;
+        } else
+          value.push_back(quote);
+      }
+      value.resize(static_cast<size_t>(rtrim(value.data(), value.data() + value.size()) - value.data()) - 1);
+    } else
+      value.assign(value_begin, rtrim(value_begin, content_end));
+    if (!keys_in_file.insert(section_id, key_view))
+      DUNE_THROW(ParameterTreeParserError,
+                 "Key '" << prefix << key_view << "' appears twice in file '" << filename << "' !");
+    if (key_view.empty()) {
+      // an empty key is stored as the section name itself, leave that to the generic lookup
+      key.assign(prefix);
+      if (overwrite || !tree.hasKey(key))
+        tree[key] = value;
+      continue;
+    }
+    if (!section)
+      section = prefix.empty() ? &tree : &tree.sub(prefix.substr(0, prefix.size() - 1));
+    key.assign(key_view.data(), key_view.size());
+    if (overwrite || !section->hasKey(key))
+      (*section)[key] = value;
+  }
+} // ... read_ini_tree(...)
+
+
+} // namespace internal
 
 ConfigurationDefaults::ConfigurationDefaults(bool warn_on_default_access_in,
                                              bool log_on_exit_in,
-                                             std::string logfile_in)
+                                             std::string logfile_in,
+                                             bool profile_access_in)
   : warn_on_default_access(warn_on_default_access_in)
   , log_on_exit(log_on_exit_in)
   , logfile(logfile_in)
+  , profile_access(profile_access_in)
 {}
 
 Configuration::Configuration()
@@ -37,6 +397,8 @@ Configuration::Configuration()
   , warn_on_default_access_(ConfigurationDefaults().warn_on_default_access)
   , log_on_exit_(ConfigurationDefaults().log_on_exit)
   , logfile_(ConfigurationDefaults().logfile)
+  , fingerprint_({{0, 0}})
+  , fingerprint_valid_(true)
 {
   setup_();
 }
@@ -46,7 +408,10 @@ Configuration::Configuration(const Dune::ParameterTree& tree_in, ConfigurationDe
   , warn_on_default_access_(defaults.warn_on_default_access)
   , log_on_exit_(defaults.log_on_exit)
   , logfile_(defaults.logfile)
+  , fingerprint_({{0, 0}})
+  , fingerprint_valid_(false)
 {
+  set_profile_access(defaults.profile_access);
   setup_();
 }
 
@@ -55,6 +420,8 @@ Configuration::Configuration(const ParameterTree& tree_in, const std::string sub
   , warn_on_default_access_(ConfigurationDefaults().warn_on_default_access)
   , log_on_exit_(ConfigurationDefaults().log_on_exit)
   , logfile_(ConfigurationDefaults().logfile)
+  , fingerprint_({{0, 0}})
+  , fingerprint_valid_(true)
 {
   setup_();
   add(tree_in, sub_id);
@@ -65,6 +432,9 @@ Configuration::Configuration(const Configuration& other)
   , warn_on_default_access_(other.warn_on_default_access_)
   , log_on_exit_(other.log_on_exit_)
   , logfile_(other.logfile_)
+  , fingerprint_(other.fingerprint_)
+  , fingerprint_valid_(other.fingerprint_valid_.load())
+  , access_profile_(other.access_profile_)
 {}
 
 Configuration::Configuration(const std::initializer_list<std::pair<std::string, std::string>>& key_value_pairs)
@@ -72,6 +442,8 @@ Configuration::Configuration(const std::initializer_list<std::pair<std::string,
   , warn_on_default_access_(ConfigurationDefaults().warn_on_default_access)
   , log_on_exit_(ConfigurationDefaults().log_on_exit)
   , logfile_(ConfigurationDefaults().logfile)
+  , fingerprint_({{0, 0}})
+  , fingerprint_valid_(true)
 {
   for (const auto& key_value_pair : key_value_pairs) {
     const auto& key = key_value_pair.first;
@@ -98,6 +470,11 @@ Configuration::~Configuration()
     test_create_directory(directory_only(logfile_));
     report(*make_ofstream(logfile_));
   }
+  if (access_profile_ && access_profile_.use_count() == 1) {
+    const auto access_logfile = access_logfile_();
+    test_create_directory(directory_only(access_logfile));
+    report_access(*make_ofstream(access_logfile));
+  }
 }
 
 void Configuration::set_warn_on_default_access(const bool value)
@@ -112,6 +489,33 @@ void Configuration::set_log_on_exit(const bool value)
   log_on_exit_ = value;
 }
 
+void Configuration::set_profile_access(const bool value)
+{
+  if (value && !access_profile_)
+    access_profile_ = std::make_shared<internal::ConfigurationAccessProfile>();
+  else if (!value)
+    access_profile_ = nullptr;
+}
+
+void Configuration::report_access(std::ostream& out) const
+{
+  if (!access_profile_)
+    return;
+  const auto ranked = access_profile_->ranked();
+  size_t key_width = 3;
+  for (const auto& element : ranked)
+    key_width = std::max(key_width, element.first.size());
+  out << std::left << std::setw(boost::numeric_cast<int>(key_width)) << "key" << std::right << std::setw(12)
+      << "accesses" << std::setw(16) << "total [ms]" << std::setw(16) << "mean [us]" << std::endl;
+  for (const auto& element : ranked) {
+    const auto& stats = element.second;
+    const double total_ms = std::chrono::duration<double, std::milli>(stats.duration).count();
+    out << std::left << std::setw(boost::numeric_cast<int>(key_width)) << element.first << std::right
+        << std::setw(12) << stats.count << std::setw(16) << std::fixed << std::setprecision(3) << total_ms
+        << std::setw(16) << 1e3 * total_ms / stats.count << std::defaultfloat << std::endl;
+  }
+} // ... report_access(...)
+
 void Configuration::set_logfile(const std::string logfile)
 {
   if (logfile.empty())
@@ -120,12 +524,34 @@ void Configuration::set_logfile(const std::string logfile)
     test_create_directory(directory_only(logfile_));
 }
 
+const std::array<std::uint64_t, 2>& Configuration::fingerprint() const
+{
+  if (!fingerprint_valid_) {
+    // concurrent readers may all find the fingerprint invalid, only one of them computes it
+    std::lock_guard<std::mutex> guard(fingerprint_mutex_);
+    if (!fingerprint_valid_)
+      compute_fingerprint_();
+  }
+  return fingerprint_;
+}
+
 // method definitions for Configuration
 bool Configuration::has_key(const std::string& key) const
 {
   return BaseType::hasKey(key);
 }
 
+std::string& Configuration::operator[](const std::string& key)
+{
+  fingerprint_valid_ = false;
+  return BaseType::operator[](key);
+}
+
+const std::string& Configuration::operator[](const std::string& key) const
+{
+  return BaseType::operator[](key);
+}
+
 Configuration Configuration::sub(const std::string sub_id, bool fail_if_missing, Configuration default_value) const
 {
   if ((empty() || !has_sub(sub_id)) && !fail_if_missing)
@@ -188,6 +614,9 @@ Configuration& Configuration::operator=(const Configuration& other)
     warn_on_default_access_ = other.warn_on_default_access_;
     log_on_exit_ = other.log_on_exit_;
     logfile_ = other.logfile_;
+    fingerprint_ = other.fingerprint_;
+    fingerprint_valid_ = other.fingerprint_valid_.load();
+    access_profile_ = other.access_profile_;
   }
   return *this;
 } // ... operator=(...)
@@ -231,8 +660,9 @@ void Configuration::read_command_line(int argc, char* argv[])
     DUNE_THROW(Dune::Exception, (usage % argv[0]).str());
   }
   if (boost::filesystem::exists(argv[1]))
-    Dune::ParameterTreeParser::readINITree(argv[1], *this);
+    internal::read_ini_tree(argv[1], *this);
   Dune::ParameterTreeParser::readOptions(argc, argv, *this);
+  fingerprint_valid_ = false;
   // datadir and logdir may be given from the command line...
   setup_();
 } // readCommandLine
@@ -240,6 +670,7 @@ void Configuration::read_command_line(int argc, char* argv[])
 void Configuration::read_options(int argc, char* argv[])
 {
   Dune::ParameterTreeParser::readOptions(argc, argv, *this);
+  fingerprint_valid_ = false;
 }
 
 void Configuration::setup_()
@@ -253,6 +684,37 @@ void Configuration::setup_()
   logfile_ = boost::filesystem::path(logfile_).string();
 } // ... setup_(...)
 
+void Configuration::compute_fingerprint_() const
+{
+  fingerprint_ = internal::fingerprint(*this);
+  fingerprint_valid_ = true;
+} // ... compute_fingerprint_(...)
+
+void Configuration::update_fingerprint_(const std::string& key, const std::string& value)
+{
+  if (!fingerprint_valid_)
+    return;
+  if (has_key(key)) {
+    const auto old_entry = internal::hash_entry(key, static_cast<const BaseType&>(*this)[key]);
+    fingerprint_[0] -= old_entry[0];
+    fingerprint_[1] -= old_entry[1];
+  }
+  const auto new_entry = internal::hash_entry(key, value);
+  fingerprint_[0] += new_entry[0];
+  fingerprint_[1] += new_entry[1];
+} // ... update_fingerprint_(...)
+
+void Configuration::record_access_(const std::string& key, const std::chrono::steady_clock::duration& duration) const
+{
+  access_profile_->record(key, duration);
+}
+
+std::string Configuration::access_logfile_() const
+{
+  const boost::filesystem::path logfile(logfile_);
+  return (logfile.parent_path() / (logfile.stem().string() + "_access" + logfile.extension().string())).string();
+}
+
 void Configuration::add_tree_(const Configuration& other, const std::string sub_id, const bool overwrite)
 {
   for (const auto& element : other.flatten()) {
@@ -274,7 +736,7 @@ void Configuration::add_tree_(const Configuration& other, const std::string sub_
 ParameterTree Configuration::initialize(const std::string filename)
 {
   ParameterTree param_tree;
-  Dune::ParameterTreeParser::readINITree(filename, param_tree);
+  internal::read_ini_tree(filename, param_tree);
   return param_tree;
 } // ... initialize(...)
 
@@ -289,12 +751,12 @@ ParameterTree Configuration::initialize(int argc, char** argv)
 {
   ParameterTree param_tree;
   if (argc == 2) {
-    Dune::ParameterTreeParser::readINITree(argv[1], param_tree);
+    internal::read_ini_tree(argv[1], param_tree);
   } else if (argc > 2) {
     Dune::ParameterTreeParser::readOptions(argc, argv, param_tree);
   }
   if (param_tree.hasKey("paramfile")) {
-    Dune::ParameterTreeParser::readINITree(param_tree.get<std::string>("paramfile"), param_tree, false);
+    internal::read_ini_tree(param_tree.get<std::string>("paramfile"), param_tree, false);
   }
   return param_tree;
 } // ... initialize(...)
@@ -303,14 +765,14 @@ ParameterTree Configuration::initialize(int argc, char** argv, std::string filen
 {
   ParameterTree param_tree;
   if (argc == 1) {
-    Dune::ParameterTreeParser::readINITree(filename, param_tree);
+    internal::read_ini_tree(filename, param_tree);
   } else if (argc == 2) {
-    Dune::ParameterTreeParser::readINITree(argv[1], param_tree);
+    internal::read_ini_tree(argv[1], param_tree);
   } else {
     Dune::ParameterTreeParser::readOptions(argc, argv, param_tree);
   }
   if (param_tree.hasKey("paramfile")) {
-    Dune::ParameterTreeParser::readINITree(param_tree.get<std::string>("paramfile"), param_tree, false);
+    internal::read_ini_tree(param_tree.get<std::string>("paramfile"), param_tree, false);
   }
   return param_tree;
 } // ... initialize(...)
@@ -360,15 +822,8 @@ void Configuration::report_flatly(const BaseType& subtree, const std::string& pr
 
 std::map<std::string, std::string> Configuration::flatten() const
 {
-  std::map<std::string, std::string> ret;
-  for (const auto& kk : getValueKeys())
-    ret[kk] = get<std::string>(kk);
-  for (const auto& ss : getSubKeys()) {
-    const auto flat_sub = sub(ss).flatten();
-    for (const auto& element : flat_sub)
-      ret[ss + "." + element.first] = element.second;
-  }
-  return ret;
+  // walks the base tree directly to avoid copying each sub into a Configuration
+  return internal::flatten(*this);
 } // ... flatten(...)
 
 std::ostream& operator<<(std::ostream& out, const Configuration& config)
@@ -379,6 +834,9 @@ std::ostream& operator<<(std::ostream& out, const Configuration& config)
 
 bool operator==(const Configuration& left, const Configuration& right)
 {
+  // differing fingerprints imply differing content, equal ones are confirmed to rule out hash collisions
+  if (left.fingerprint() != right.fingerprint())
+    return false;
   return left.flatten() == right.flatten();
 }
 
@@ -392,7 +850,11 @@ bool operator!=(const Configuration& left, const Configuration& right)
 
 bool operator==(const ParameterTree& left, const ParameterTree& right)
 {
-  return Dune::XT::Common::Configuration(left).flatten() == Dune::XT::Common::Configuration(right).flatten();
+  // same as for Configurations, but on the trees themselves instead of on copies
+  namespace internal = XT::Common::internal;
+  if (internal::fingerprint(left) != internal::fingerprint(right))
+    return false;
+  return internal::flatten(left) == internal::flatten(right);
 }
 
 bool operator!=(const ParameterTree& left, const ParameterTree& right)
@@ -403,15 +865,35 @@ bool operator!=(const ParameterTree& left, const ParameterTree& right)
 } // namespace Dune
 namespace std {
 
+//! Orders like less<Configuration> would order the corresponding Configurations.
 bool less<Dune::ParameterTree>::operator()(const Dune::ParameterTree& lhs, const Dune::ParameterTree& rhs) const
 {
-  return Dune::XT::Common::Configuration(lhs).flatten() < Dune::XT::Common::Configuration(rhs).flatten();
+  namespace internal = Dune::XT::Common::internal;
+  const auto lhs_fingerprint = internal::fingerprint(lhs);
+  const auto rhs_fingerprint = internal::fingerprint(rhs);
+  if (lhs_fingerprint != rhs_fingerprint)
+    return lhs_fingerprint < rhs_fingerprint;
+  return internal::flatten(lhs) < internal::flatten(rhs);
 }
 
+/**
+ * Orders by fingerprint first and only falls back to comparing the flattened content if the fingerprints coincide.
+ * This is a strict weak ordering compatible with operator==, but not the lexicographic order of the flattened content.
+ */
 bool less<Dune::XT::Common::Configuration>::operator()(const Dune::XT::Common::Configuration& lhs,
                                                        const Dune::XT::Common::Configuration& rhs) const
 {
+  const auto& lhs_fingerprint = lhs.fingerprint();
+  const auto& rhs_fingerprint = rhs.fingerprint();
+  if (lhs_fingerprint != rhs_fingerprint)
+    return lhs_fingerprint < rhs_fingerprint;
   return lhs.flatten() < rhs.flatten();
 }
 
+std::size_t hash<Dune::XT::Common::Configuration>::operator()(const Dune::XT::Common::Configuration& config) const
+{
+  const auto& fingerprint = config.fingerprint();
+  return static_cast<std::size_t>(fingerprint[0] ^ (fingerprint[1] << 1));
+}
+
 } // namespace std
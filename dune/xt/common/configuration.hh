@@ -14,7 +14,13 @@
 #ifndef DUNE_XT_COMMON_CONFIGURATION_HH
 #define DUNE_XT_COMMON_CONFIGURATION_HH
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 #include <boost/lexical_cast/bad_lexical_cast.hpp>
@@ -36,10 +42,12 @@ struct ConfigurationDefaults
 {
   ConfigurationDefaults(bool warn_on_default_access_in = false,
                         bool log_on_exit_in = false,
-                        std::string logfile_in = std::string("data/log/dxtc_parameter.log"));
+                        std::string logfile_in = std::string("data/log/dxtc_parameter.log"),
+                        bool profile_access_in = false);
   const bool warn_on_default_access;
   const bool log_on_exit;
   const std::string logfile;
+  const bool profile_access;
 };
 
 namespace internal {
@@ -49,8 +57,15 @@ struct Typer
   typedef typename std::conditional<std::is_same<T, const char*>::value, std::string, T>::type type;
 };
 
+//! per thread access counts and parsing times of a Configuration, defined in configuration.cc
+class ConfigurationAccessProfile;
+
 } // namespace internal
 
+/**
+ * \note All const methods (get(), has_key(), flatten(), fingerprint(), ...) may be called concurrently from several
+ *       threads (including python threads), all others (set(), add(), operator[], ...) require exclusive access.
+ */
 class Configuration : public Dune::ParameterTree
 {
   typedef Dune::ParameterTree BaseType;
@@ -97,7 +112,10 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
     , warn_on_default_access_(defaults.warn_on_default_access)
     , log_on_exit_(defaults.log_on_exit)
     , logfile_(defaults.logfile)
+    , fingerprint_({{0, 0}})
+    , fingerprint_valid_(true)
   {
+    set_profile_access(defaults.profile_access);
     const auto values = make_string_sequence(values_in.begin(), values_in.end());
     if (keys.size() != values.size()) {
 
@@ -115,6 +133,15 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
 
   Configuration& operator=(const Configuration& other);
 
+  /**
+   * \brief 128-bit hash of all flattened key/value pairs, independent of insertion order.
+   *
+   *        The fingerprint is updated incrementally by set() and add(), so comparing two Configurations with
+   *        different content does not require flattening them.
+   * \note  Modifying this Configuration through a reference to the base Dune::ParameterTree is not tracked.
+   */
+  const std::array<std::uint64_t, 2>& fingerprint() const;
+
   /**
    * \defgroup base ´´These methods replace or override those from Dune::ParameterTree.``
    * \{
@@ -126,6 +153,14 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
   //! check if sub is existing in tree_
   bool has_sub(const std::string subTreeName) const;
 
+  /**
+   * \attention Writing to the returned reference invalidates the fingerprint, which is then recomputed on the next
+   *            call to fingerprint(). Prefer set(), which updates it incrementally.
+   */
+  std::string& operator[](const std::string& key);
+
+  const std::string& operator[](const std::string& key) const;
+
   /** \brief print the ParameterTree
    *  \param out output stream
    *  \param prefix to be prepended to each line
@@ -155,7 +190,7 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
                  "This Configuration (see below) does not contain the key '"
                      << key << "' and there was no default value provided!\n======================\n"
                      << report_string());
-    return get_valid_value(key, T(), validator, size, cols);
+    return get_(key, T(), validator, size, cols);
   } // ... get(...)
 
   //! const get without default value, with validation
@@ -170,7 +205,7 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
                  "This Configuration (see below) does not contain the key '"
                      << key << "' and there was no default value provided!\n======================\n"
                      << report_string());
-    return get_valid_value(key, T(), validator, 0, 0);
+    return get_(key, T(), validator, 0, 0);
   } // ... get(...)
 
   //! get variation with default value, validation
@@ -211,7 +246,9 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
                  "While setting '" << key << "' in this configuration (see below), it already exists and you requested "
                                    << "no overwrite!\n======================\n"
                                    << report_string());
-    BaseType::operator[](key) = to_string(value);
+    const auto value_str = to_string(value);
+    update_fingerprint_(key, value_str);
+    BaseType::operator[](key) = value_str;
   } // ... set(..., T, ...)
 
   void set(const std::string& key, const char* value, const bool overwrite = false);
@@ -252,6 +289,18 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
   void set_log_on_exit(const bool value);
   void set_logfile(const std::string logfile);
 
+  /**
+   * \brief Enables counting of accesses and parsing time per key in all get() variants.
+   *
+   *        The statistics are gathered per thread and shared by all copies of this Configuration (but not by subs).
+   *        If enabled, a ranked report is written next to the logfile (e.g. data/log/dxtc_parameter_access.log) on
+   *        destruction of the last copy.
+   */
+  void set_profile_access(const bool value);
+
+  //! print the keys accessed so far, ranked by accumulated parsing time (requires set_profile_access(true))
+  void report_access(std::ostream& out = std::cout) const;
+
   //! check if tree_ is empty
   bool empty() const;
 
@@ -270,6 +319,16 @@ some_function_which_expects_a_config({{"type", "custom"}, {"tolerance", "1e-10"}
 private:
   void setup_();
 
+  //! recomputes fingerprint_ from scratch
+  void compute_fingerprint_() const;
+
+  //! accounts for key being (re)set to value in fingerprint_, has to be called before the value is stored
+  void update_fingerprint_(const std::string& key, const std::string& value);
+
+  void record_access_(const std::string& key, const std::chrono::steady_clock::duration& duration) const;
+
+  std::string access_logfile_() const;
+
   void add_tree_(const Configuration& other, const std::string sub_id, const bool overwrite);
 
   //! get value from tree and validate with validator
@@ -327,6 +386,12 @@ private:
                 << std::endl;
     }
 #endif // ifndef NDEBUG
+    if (access_profile_) {
+      const auto start = std::chrono::steady_clock::now();
+      auto ret = get_valid_value(key, def, validator, size, cols);
+      record_access_(key, std::chrono::steady_clock::now() - start);
+      return ret;
+    }
     return get_valid_value(key, def, validator, size, cols);
   } // ... get_(...)
 
@@ -351,6 +416,11 @@ private:
   bool warn_on_default_access_;
   bool log_on_exit_;
   std::string logfile_;
+  mutable std::array<std::uint64_t, 2> fingerprint_;
+  mutable std::atomic<bool> fingerprint_valid_;
+  //! only one of several concurrent readers of this Configuration computes an invalid fingerprint
+  mutable std::mutex fingerprint_mutex_;
+  std::shared_ptr<internal::ConfigurationAccessProfile> access_profile_;
 }; // class Configuration
 
 std::ostream& operator<<(std::ostream& out, const Configuration& config);
@@ -396,6 +466,12 @@ struct less<Dune::XT::Common::Configuration>
   bool operator()(const Dune::XT::Common::Configuration& lhs, const Dune::XT::Common::Configuration& rhs) const;
 }; // struct less< ParameterTree >
 
+template <>
+struct hash<Dune::XT::Common::Configuration>
+{
+  std::size_t operator()(const Dune::XT::Common::Configuration& config) const;
+}; // struct hash< Configuration >
+
 } // namespace std
 
 #define DXTC_CONFIG Dune::XT::Common::Config()
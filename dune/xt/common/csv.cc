@@ -0,0 +1,113 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+
+#if HAVE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+
+#include "csv.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+static const char* find_line_end(const char* first, const char* last)
+{
+  const auto* found = static_cast<const char*>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+  return found ? found : last;
+}
+
+const char* skip_lines(const char* first, const char* last, size_t num_lines)
+{
+  for (; num_lines > 0 && first != last; --num_lines) {
+    first = find_line_end(first, last);
+    if (first != last)
+      ++first;
+  }
+  return first;
+}
+
+size_t count_csv_columns(const char* first, const char* last, const char delimiter)
+{
+  while (first != last) {
+    const char* line_end = find_line_end(first, last);
+    if (is_csv_data_line(first, line_end)) {
+      if (delimiter != ' ')
+        return 1 + static_cast<size_t>(std::count(first, line_end, delimiter));
+      size_t cols = 0;
+      for (bool in_entry = false; first != line_end; ++first) {
+        if (!is_csv_blank(*first) && !in_entry)
+          ++cols;
+        in_entry = !is_csv_blank(*first);
+      }
+      return cols;
+    }
+    first = (line_end == last) ? last : line_end + 1;
+  }
+  return 0;
+} // ... count_csv_columns(...)
+
+std::vector<CsvChunk> split_csv_chunks(const char* first, const char* last, const size_t num_chunks)
+{
+  std::vector<CsvChunk> chunks;
+  const size_t size = static_cast<size_t>(last - first);
+  const char* chunk_begin = first;
+  for (size_t ii = 1; ii <= num_chunks && chunk_begin != last; ++ii) {
+    // move the nominal end of the chunk to the next line break
+    const char* chunk_end = (ii == num_chunks) ? last : std::max(chunk_begin, first + (size / num_chunks) * ii);
+    if (chunk_end != last) {
+      chunk_end = find_line_end(chunk_end, last);
+      if (chunk_end != last)
+        ++chunk_end;
+    }
+    chunks.push_back({chunk_begin, chunk_end, 0, 0});
+    chunk_begin = chunk_end;
+  }
+  for_each_index_in_parallel(chunks.size(), [&](const size_t ii) {
+    auto& chunk = chunks[ii];
+    for (const char* line_begin = chunk.begin; line_begin != chunk.end;) {
+      const char* line_end = find_line_end(line_begin, chunk.end);
+      if (is_csv_data_line(line_begin, line_end))
+        ++chunk.num_rows;
+      line_begin = (line_end == chunk.end) ? chunk.end : line_end + 1;
+    }
+  });
+  for (size_t ii = 1; ii < chunks.size(); ++ii)
+    chunks[ii].first_row = chunks[ii - 1].first_row + chunks[ii - 1].num_rows;
+  return chunks;
+} // ... split_csv_chunks(...)
+
+size_t csv_chunk_count(const size_t size)
+{
+  static const size_t min_chunk_size = 1 << 20;
+  const size_t max_chunks = 4 * std::max(size_t(1), ThreadManager::default_max_threads());
+  return std::max(size_t(1), std::min(max_chunks, size / min_chunk_size));
+}
+
+void for_each_index_in_parallel(const size_t count, const std::function<void(size_t)>& f)
+{
+#if HAVE_TBB
+  tbb::parallel_for(size_t(0), count, f);
+#else
+  for (size_t ii = 0; ii < count; ++ii)
+    f(ii);
+#endif
+}
+
+
+} // namespace internal
+} // namespace Common
+} // namespace XT
+} // namespace Dune
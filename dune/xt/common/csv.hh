@@ -0,0 +1,211 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_CSV_HH
+#define DUNE_XT_COMMON_CSV_HH
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/filesystem.hh>
+#include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/string.hh>
+#include <dune/xt/common/vector.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+//! complete lines of a csv file and the index of the first data row among them
+struct CsvChunk
+{
+  const char* begin;
+  const char* end;
+  size_t first_row;
+  size_t num_rows;
+};
+
+static inline bool is_csv_blank(const char cc)
+{
+  return cc == ' ' || cc == '\t' || cc == '\r';
+}
+
+//! lines containing only white space or starting with '#' are skipped
+static inline bool is_csv_data_line(const char* first, const char* last)
+{
+  while (first != last && is_csv_blank(*first))
+    ++first;
+  return first != last && *first != '#';
+}
+
+//! the position after the first num_lines lines of [first, last)
+const char* skip_lines(const char* first, const char* last, size_t num_lines);
+
+//! the number of entries of the first data line of [first, last), a delimiter of ' ' means any white space
+size_t count_csv_columns(const char* first, const char* last, const char delimiter);
+
+/**
+ * \brief Splits [first, last) into at most num_chunks chunks of complete lines and counts their data rows (in
+ *        parallel, if TBB is available).
+ */
+std::vector<CsvChunk> split_csv_chunks(const char* first, const char* last, const size_t num_chunks);
+
+//! a chunk count that keeps all threads busy without making the chunks too small
+size_t csv_chunk_count(const size_t size);
+
+//! calls f(ii) for each ii < count, in parallel if TBB is available
+void for_each_index_in_parallel(const size_t count, const std::function<void(size_t)>& f);
+
+/**
+ * \brief Reads the rows of a chunk and calls set_entry(row, col, value) for each entry.
+ * \return an empty string on success, a description of the first error otherwise
+ */
+template <class S, class SetEntryType>
+std::string read_csv_chunk(const CsvChunk& chunk, const char delimiter, const size_t cols, SetEntryType& set_entry)
+{
+  const bool whitespace_delimited = (delimiter == ' ');
+  size_t row = chunk.first_row;
+  const char* line_begin = chunk.begin;
+  while (line_begin != chunk.end) {
+    const auto* found =
+        static_cast<const char*>(std::memchr(line_begin, '\n', static_cast<size_t>(chunk.end - line_begin)));
+    const char* line_end = found ? found : chunk.end;
+    const char* next_line = found ? found + 1 : chunk.end;
+    if (!is_csv_data_line(line_begin, line_end)) {
+      line_begin = next_line;
+      continue;
+    }
+    const char* pos = line_begin;
+    for (size_t col = 0; col < cols; ++col) {
+      if (col > 0 && !whitespace_delimited) {
+        if (pos == line_end || *pos != delimiter)
+          return "row " + to_string(row) + " has only " + to_string(col) + " columns instead of " + to_string(cols)
+                 + ": '" + std::string(line_begin, line_end) + "'";
+        ++pos;
+      }
+      S value;
+      const char* number_end = pos;
+      if (parse_number(pos, line_end, value, &number_end) != std::errc()) {
+        if (whitespace_delimited && !is_csv_data_line(pos, line_end))
+          return "row " + to_string(row) + " has only " + to_string(col) + " columns instead of " + to_string(cols)
+                 + ": '" + std::string(line_begin, line_end) + "'";
+        return "could not read the entry in row " + to_string(row) + ", column " + to_string(col) + ": '"
+               + std::string(line_begin, line_end) + "'";
+      }
+      set_entry(row, col, value);
+      pos = number_end;
+      while (pos != line_end && is_csv_blank(*pos))
+        ++pos;
+      if (pos != line_end && (whitespace_delimited ? pos == number_end : *pos != delimiter))
+        return "could not read the entry in row " + to_string(row) + ", column " + to_string(col) + ": '"
+               + std::string(line_begin, line_end) + "'";
+    }
+    if (pos != line_end)
+      return "row " + to_string(row) + " has more than " + to_string(cols) + " columns: '"
+             + std::string(line_begin, line_end) + "'";
+    ++row;
+    line_begin = next_line;
+  }
+  return "";
+} // ... read_csv_chunk(...)
+
+template <class S, class CreateType, class SetEntryType>
+void read_csv(const std::string& filename,
+              const char delimiter,
+              const size_t skip_rows,
+              CreateType&& create,
+              SetEntryType&& set_entry)
+{
+  static_assert(std::is_arithmetic<S>::value && !std::is_same<S, bool>::value,
+                "Only numbers can be read from csv files!");
+  const MappedFile file(filename);
+  const char* const first = skip_lines(file.begin(), file.end(), skip_rows);
+  const auto chunks = split_csv_chunks(first, file.end(), csv_chunk_count(static_cast<size_t>(file.end() - first)));
+  const size_t rows = chunks.empty() ? 0 : chunks.back().first_row + chunks.back().num_rows;
+  const size_t cols = count_csv_columns(first, file.end(), delimiter);
+  create(rows, cols);
+  std::vector<std::string> errors(chunks.size());
+  for_each_index_in_parallel(chunks.size(), [&](const size_t ii) {
+    errors[ii] = read_csv_chunk<S>(chunks[ii], delimiter, cols, set_entry);
+  });
+  for (const auto& error : errors)
+    if (!error.empty())
+      DUNE_THROW(Exceptions::conversion_error, "Could not read '" << filename << "', " << error << "!");
+} // ... read_csv(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief Reads a file of numbers into a matrix, one row per line.
+ *
+ *        The file is mapped into memory and its parts are read in parallel (if TBB is available), the entries are
+ *        written directly into the matrix. Lines which are empty or start with '#' are ignored, all other lines need
+ *        to have the same number of entries.
+ * \param delimiter separates the entries of a row, ' ' means any number of spaces or tabs
+ * \param skip_rows number of lines to ignore at the beginning of the file (e.g., a header)
+ * \throws Exceptions::conversion_error if an entry cannot be read, the error contains its row and column
+ */
+template <class MatrixType = Dune::DynamicMatrix<double>>
+MatrixType read_csv_matrix(const std::string& filename, const char delimiter = ',', const size_t skip_rows = 0)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  static_assert(M::is_matrix, "MatrixType has to be a matrix type supported by MatrixAbstraction!");
+  MatrixType ret;
+  internal::read_csv<typename M::S>(
+      filename,
+      delimiter,
+      skip_rows,
+      [&](const size_t rows, const size_t cols) {
+        if (M::has_static_size && (rows != M::static_rows || cols != M::static_cols))
+          DUNE_THROW(Exceptions::conversion_error,
+                     "'" << filename << "' contains a " << rows << "x" << cols << " matrix, but " << M::static_rows
+                         << "x" << M::static_cols << " is required for this MatrixType!");
+        ret = M::create(rows, cols);
+      },
+      [&](const size_t row, const size_t col, const typename M::S& value) { M::set_entry(ret, row, col, value); });
+  return ret;
+} // ... read_csv_matrix(...)
+
+
+/**
+ * \brief Reads a file of numbers column-wise, one row per line.
+ * \sa    read_csv_matrix for the format
+ * \return one vector per column
+ */
+template <class VectorType = std::vector<double>>
+std::vector<VectorType>
+read_csv_columns(const std::string& filename, const char delimiter = ',', const size_t skip_rows = 0)
+{
+  using V = VectorAbstraction<VectorType>;
+  static_assert(V::is_vector && !V::has_static_size,
+                "VectorType has to be a dynamic vector type supported by VectorAbstraction!");
+  std::vector<VectorType> ret;
+  internal::read_csv<typename V::S>(
+      filename,
+      delimiter,
+      skip_rows,
+      [&](const size_t rows, const size_t cols) { ret.assign(cols, V::create(rows)); },
+      [&](const size_t row, const size_t col, const typename V::S& value) { ret[col][row] = value; });
+  return ret;
+} // ... read_csv_columns(...)
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_CSV_HH
@@ -0,0 +1,208 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <deque>
+
+#include <boost/format.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include "exceptions.hh"
+#include "filesystem.hh"
+#include "event_log.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+namespace {
+
+
+/**
+ * The file layout (all numbers in the byte order given by the endianness marker):
+ * - header: "DXTCEVT\0", uint32 version, uint32 endianness marker 0x01020304, int64 nanoseconds since the unix epoch
+ *   at create(), uint32 rank
+ * - format record: uint8 1, uint32 id, uint32 line, uint16 number of arguments, uint8 type per argument, uint32
+ *   length of the file name, the file name, uint32 length of the format, the format
+ * - event record: uint8 2, uint32 id, uint64 nanoseconds since create(), the arguments
+ */
+static const char event_log_magic[] = "DXTCEVT";
+static const std::uint32_t event_log_version = 1;
+static const std::uint8_t event_log_format_record = 1;
+static const std::uint8_t event_log_event_record = 2;
+//! the buffer is written once it exceeds this size
+static const size_t event_log_block_size = 1 << 16;
+
+
+struct EventFormatRegistry
+{
+  std::mutex mutex;
+  //! a deque, since references to the formats have to stay valid
+  std::deque<EventFormat> formats;
+};
+
+EventFormatRegistry& event_format_registry()
+{
+  static EventFormatRegistry registry;
+  return registry;
+}
+
+
+template <class T>
+void append_number(std::string& buffer, const T& value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void append_string(std::string& buffer, const std::string& value)
+{
+  append_number(buffer, static_cast<std::uint32_t>(value.size()));
+  buffer += value;
+}
+
+
+} // namespace
+
+
+const EventFormat& event_format(const size_t id)
+{
+  auto& registry = event_format_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (id >= registry.formats.size())
+    DUNE_THROW(Dune::RangeError, "There is no event format with id " << id << "!");
+  return registry.formats[id];
+}
+
+
+EventFormatSite::EventFormatSite(const char* file, const int line)
+  : file_(file)
+  , line_(line)
+  , id_plus_one_(0)
+{}
+
+size_t EventFormatSite::register_format(const char* format, std::vector<EventArgType>&& types)
+{
+  auto& registry = event_format_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  // another thread may have been faster
+  const size_t id_plus_one = id_plus_one_.load(std::memory_order_acquire);
+  if (id_plus_one > 0)
+    return id_plus_one - 1;
+  if (types.size() > UINT16_MAX || registry.formats.size() >= UINT32_MAX)
+    DUNE_THROW(Dune::InvalidStateException,
+               "Too many event formats or arguments (at " << file_ << ":" << line_ << ")!");
+  registry.formats.push_back({file_, line_, format, std::move(types)});
+  const size_t id = registry.formats.size() - 1;
+  id_plus_one_.store(id + 1, std::memory_order_release);
+  return id;
+} // ... register_format(...)
+
+
+} // namespace internal
+
+
+EventLogging::EventLogging()
+  : enabled_(false)
+{}
+
+EventLogging::~EventLogging()
+{
+  deinit();
+}
+
+void EventLogging::create(const std::string filename, const std::string datadir, const std::string logdir)
+{
+  deinit();
+  const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+  std::string name = filename;
+  if (comm.size() > 1)
+    name += (boost::format("_p%08d") % comm.rank()).str();
+  const std::string path = (boost::filesystem::path(datadir) / logdir / (name + ".evt")).string();
+  test_create_directory(path);
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_.open(path, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open())
+    DUNE_THROW(Dune::IOError, "Could not open '" << path << "' for writing!");
+  filename_ = path;
+  start_ = std::chrono::steady_clock::now();
+  const auto unix_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+  buffer_.clear();
+  buffer_.reserve(2 * internal::event_log_block_size);
+  buffer_.append(internal::event_log_magic, sizeof(internal::event_log_magic));
+  internal::append_number(buffer_, internal::event_log_version);
+  internal::append_number(buffer_, std::uint32_t(0x01020304));
+  internal::append_number(buffer_, static_cast<std::int64_t>(unix_time));
+  internal::append_number(buffer_, static_cast<std::uint32_t>(comm.rank()));
+  written_formats_.clear();
+  enabled_ = true;
+} // ... create(...)
+
+void EventLogging::deinit()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_)
+    return;
+  enabled_ = false;
+  write_buffer();
+  file_.close();
+}
+
+const std::string& EventLogging::filename() const
+{
+  return filename_;
+}
+
+void EventLogging::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_)
+    return;
+  write_buffer();
+  file_.flush();
+}
+
+void EventLogging::begin_event(const size_t id, const size_t args_size)
+{
+  if (buffer_.size() + args_size > internal::event_log_block_size)
+    write_buffer();
+  if (id >= written_formats_.size())
+    written_formats_.resize(id + 1, false);
+  if (!written_formats_[id]) {
+    const auto& format = internal::event_format(id);
+    internal::append_number(buffer_, internal::event_log_format_record);
+    internal::append_number(buffer_, static_cast<std::uint32_t>(id));
+    internal::append_number(buffer_, static_cast<std::uint32_t>(format.line));
+    internal::append_number(buffer_, static_cast<std::uint16_t>(format.types.size()));
+    for (const auto& type : format.types)
+      internal::append_number(buffer_, static_cast<std::uint8_t>(type));
+    internal::append_string(buffer_, format.file);
+    internal::append_string(buffer_, format.format);
+    written_formats_[id] = true;
+  }
+  internal::append_number(buffer_, internal::event_log_event_record);
+  internal::append_number(buffer_, static_cast<std::uint32_t>(id));
+  // taken under the lock, so that the times in the file are ordered
+  const auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+  internal::append_number(buffer_, static_cast<std::uint64_t>(nanoseconds));
+} // ... begin_event(...)
+
+void EventLogging::write_buffer()
+{
+  file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+}
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
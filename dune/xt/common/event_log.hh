@@ -0,0 +1,344 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+/**
+ *  \file event_log.hh
+ *  \brief binary logging of high-rate events, see EventLogger()
+ **/
+#ifndef DUNE_XT_COMMON_EVENT_LOG_HH
+#define DUNE_XT_COMMON_EVENT_LOG_HH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+#include <dune/common/visibility.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+//! the type codes of event arguments, as stored in the file (do not reorder)
+enum class EventArgType : std::uint8_t
+{
+  int8 = 1,
+  int16,
+  int32,
+  int64,
+  uint8,
+  uint16,
+  uint32,
+  uint64,
+  float32,
+  float64,
+  boolean,
+  //! a std::uint32_t length followed by the characters
+  string
+};
+
+
+constexpr EventArgType integral_event_arg_type(const size_t bytes, const bool is_signed)
+{
+  return static_cast<EventArgType>((is_signed ? 1 : 5) + (bytes == 1 ? 0 : (bytes == 2 ? 1 : (bytes == 4 ? 2 : 3))));
+}
+
+
+template <class T, class = void>
+struct EventArg
+{
+  static_assert(AlwaysFalse<T>::value,
+                "Only arithmetic types, character strings and std::string can be written to the event log!");
+};
+
+template <class T>
+struct EventArg<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+{
+  static_assert(sizeof(T) <= 8, "");
+
+  static constexpr EventArgType type()
+  {
+    return integral_event_arg_type(sizeof(T), std::is_signed<T>::value);
+  }
+
+  static size_t size(const T& /*value*/)
+  {
+    return sizeof(T);
+  }
+
+  static void append(std::string& buffer, const T& value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+};
+
+template <class T>
+struct EventArg<T, std::enable_if_t<std::is_same<T, float>::value || std::is_same<T, double>::value>>
+{
+  static constexpr EventArgType type()
+  {
+    return std::is_same<T, float>::value ? EventArgType::float32 : EventArgType::float64;
+  }
+
+  static size_t size(const T& /*value*/)
+  {
+    return sizeof(T);
+  }
+
+  static void append(std::string& buffer, const T& value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+};
+
+template <>
+struct EventArg<bool>
+{
+  static constexpr EventArgType type()
+  {
+    return EventArgType::boolean;
+  }
+
+  static size_t size(const bool& /*value*/)
+  {
+    return 1;
+  }
+
+  static void append(std::string& buffer, const bool& value)
+  {
+    buffer += static_cast<char>(value ? 1 : 0);
+  }
+};
+
+struct StringEventArg
+{
+  static constexpr EventArgType type()
+  {
+    return EventArgType::string;
+  }
+
+  static size_t size(const size_t length)
+  {
+    return sizeof(std::uint32_t) + std::min(length, size_t(UINT32_MAX));
+  }
+
+  static void append(std::string& buffer, const char* value, const size_t length)
+  {
+    const auto truncated_length = static_cast<std::uint32_t>(std::min(length, size_t(UINT32_MAX)));
+    buffer.append(reinterpret_cast<const char*>(&truncated_length), sizeof(truncated_length));
+    buffer.append(value, truncated_length);
+  }
+};
+
+template <>
+struct EventArg<std::string> : public StringEventArg
+{
+  static size_t size(const std::string& value)
+  {
+    return StringEventArg::size(value.size());
+  }
+
+  static void append(std::string& buffer, const std::string& value)
+  {
+    StringEventArg::append(buffer, value.data(), value.size());
+  }
+};
+
+template <class T>
+struct EventArg<T, std::enable_if_t<std::is_same<T, const char*>::value || std::is_same<T, char*>::value>>
+  : public StringEventArg
+{
+  static size_t size(const char* value)
+  {
+    return StringEventArg::size(value ? std::strlen(value) : 0);
+  }
+
+  static void append(std::string& buffer, const char* value)
+  {
+    StringEventArg::append(buffer, value ? value : "", value ? std::strlen(value) : 0);
+  }
+};
+
+
+//! a registered format, \sa EventFormatSite
+struct EventFormat
+{
+  std::string file;
+  int line;
+  std::string format;
+  std::vector<EventArgType> types;
+};
+
+
+//! the format with the given id, as registered by an EventFormatSite
+const EventFormat& event_format(const size_t id);
+
+
+/**
+ * \brief The static format descriptor of one DXTC_EVENT_LOG call site.
+ *
+ *        The format is registered (process wide) on first use, afterwards id() is a single atomic load.
+ */
+class EventFormatSite
+{
+public:
+  EventFormatSite(const char* file, const int line);
+
+  template <class... Args>
+  size_t id(const char* format)
+  {
+    const size_t id_plus_one = id_plus_one_.load(std::memory_order_acquire);
+    if (id_plus_one > 0)
+      return id_plus_one - 1;
+    return register_format(format, {EventArg<Args>::type()...});
+  }
+
+private:
+  size_t register_format(const char* format, std::vector<EventArgType>&& types);
+
+  const char* file_;
+  const int line_;
+  std::atomic<size_t> id_plus_one_;
+}; // class EventFormatSite
+
+
+} // namespace internal
+
+
+class EventLogging;
+//! global EventLogging instance
+inline EventLogging& EventLogger();
+
+
+/**
+ * \brief Writes events in a compact binary format, to be decoded offline by decode_event_log.py.
+ *
+ *        Instead of formatting every value at runtime, each call site of DXTC_EVENT_LOG registers its format string
+ *        and argument types once and records then only carry the id of the format, the time since create() and the
+ *        raw bytes of the arguments:
+\code
+EventLogger().create("residuals");
+for (size_t ii = 0; ii < num_iterations; ++ii)
+  DXTC_EVENT_LOG("iteration {}: residual {}, cfl {}", ii, residual, cfl);
+\endcode
+ *        Each format is written to the file in front of the first event using it, so the files are self-contained.
+ *        The events are buffered and written in blocks, until create() is called nothing is recorded at all. The
+ *        decoder turns the files back into text or CSV:
+\code
+decode_event_log.py data/log/residuals.evt
+decode_event_log.py --csv data/log/residuals.evt
+\endcode
+ *        Supported arguments are all arithmetic types except long double, character strings and std::string.
+ * \note  The file is written in the native byte order of the machine (which is recorded in its header).
+ * \note  All threads append to one buffer under one mutex, which keeps the events in the file ordered by time. Threads
+ *        recording at high rates thus contend on it, although it is only held to copy the bytes of a single event.
+ */
+class EventLogging
+{
+  EventLogging();
+
+public:
+  ~EventLogging();
+
+  /**
+   * \brief Starts recording to datadir/logdir/filename.evt (with the rank appended to filename for several ranks).
+   *
+   *        Recording to a previous file is stopped first.
+   */
+  void create(const std::string filename = "dune_xt_common_events",
+              const std::string datadir = "data",
+              const std::string logdir = "log");
+
+  //! writes all buffered events and stops recording
+  void deinit();
+
+  bool enabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  //! the file which is recorded to, if enabled()
+  const std::string& filename() const;
+
+  //! writes all buffered events to the file
+  void flush();
+
+  //! \note Use DXTC_EVENT_LOG instead of calling this directly.
+  template <class... Args>
+  void record(internal::EventFormatSite& site, const char* format, const Args&... args)
+  {
+    if (!enabled())
+      return;
+    const auto id = site.id<std::decay_t<Args>...>(format);
+    size_t size = 0;
+    const size_t sizes[] = {0, (size += internal::EventArg<std::decay_t<Args>>::size(args))...};
+    static_cast<void>(sizes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_)
+      return;
+    begin_event(id, size);
+    const int appended[] = {0, (internal::EventArg<std::decay_t<Args>>::append(buffer_, args), 0)...};
+    static_cast<void>(appended);
+  } // ... record(...)
+
+private:
+  EventLogging(const EventLogging&) = delete;
+  EventLogging& operator=(const EventLogging&) = delete;
+
+  //! appends the format (if it was not yet written) and the record header, writes the buffer if required
+  void begin_event(const size_t id, const size_t args_size);
+
+  void write_buffer();
+
+  std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  std::string filename_;
+  std::ofstream file_;
+  std::string buffer_;
+  std::vector<bool> written_formats_;
+  std::chrono::steady_clock::time_point start_;
+
+  friend EventLogging& EventLogger();
+}; // class EventLogging
+
+
+DUNE_EXPORT inline EventLogging& EventLogger()
+{
+  static EventLogging log;
+  return log;
+}
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+
+/**
+ * \brief Records an event in the EventLogger(), e.g. DXTC_EVENT_LOG("residual {} at iteration {}", res, it).
+ *
+ *        Each "{}" in the format (which has to be a string literal) is replaced by the next argument when decoding.
+ *        The arguments are not even evaluated if the EventLogger() has not been created.
+ */
+#define DXTC_EVENT_LOG(...)                                                                                            \
+  do {                                                                                                                 \
+    if (Dune::XT::Common::EventLogger().enabled()) {                                                                   \
+      static Dune::XT::Common::internal::EventFormatSite dxtc_event_log_site(__FILE__, __LINE__);                      \
+      Dune::XT::Common::EventLogger().record(dxtc_event_log_site, __VA_ARGS__);                                        \
+    }                                                                                                                  \
+  } while (0)
+
+#endif // DUNE_XT_COMMON_EVENT_LOG_HH
@@ -11,6 +11,15 @@
 
 #include "config.h"
 
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/common/exceptions.hh>
+
 #include "filesystem.hh"
 
 namespace Dune {
@@ -88,6 +97,39 @@ void meminfo(LogStream& stream)
   stream << "------------ \n\n" << std::endl;
 } // meminfo
 
+MappedFile::MappedFile(const std::string& filename)
+  : data_(nullptr)
+  , size_(0)
+  , mapped_(false)
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    DUNE_THROW(Dune::IOError, "Could not open file " << filename);
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+    size_ = static_cast<size_t>(file_stat.st_size);
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      ::madvise(addr, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(addr);
+      mapped_ = true;
+    }
+  }
+  ::close(fd);
+  if (!mapped_) {
+    std::ifstream in(filename, std::ios::binary);
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+} // MappedFile(...)
+
+MappedFile::~MappedFile()
+{
+  if (mapped_)
+    ::munmap(const_cast<char*>(data_), size_);
+}
+
 } // namespace Common
 } // namespace XT
 } // namespace Dune
@@ -49,6 +49,45 @@ void file_to_stream_filtered(std::ostream& stream, std::string filename, std::st
 //! output programs mem usage stats by reading from /proc
 void meminfo(LogStream& stream);
 
+/**
+ * \brief Read-only view of the contents of a whole file.
+ *
+ *        Regular files are mapped into memory, anything else (pipes, files in /proc) or files which cannot be mapped
+ *        are read into a buffer.
+ */
+class MappedFile
+{
+public:
+  //! \throws Dune::IOError if the file cannot be opened
+  explicit MappedFile(const std::string& filename);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile();
+
+  const char* begin() const
+  {
+    return data_;
+  }
+
+  const char* end() const
+  {
+    return data_ + size_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+private:
+  const char* data_;
+  size_t size_;
+  bool mapped_;
+  std::string buffer_;
+}; // class MappedFile
+
 } // namespace Common
 } // namespace XT
 } // namespace Dune
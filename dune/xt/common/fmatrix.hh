@@ -13,7 +13,9 @@
 #ifndef DUNE_XT_COMMON_FMATRIX_HH
 #define DUNE_XT_COMMON_FMATRIX_HH
 
+#include <array>
 #include <initializer_list>
+#include <type_traits>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
@@ -27,10 +29,66 @@
 namespace Dune {
 namespace XT {
 namespace Common {
+namespace internal {
+
+
+/**
+ * \brief Calls a function for each index below end, unrolled at compile time.
+ *
+ *        Each call gets the index as std::integral_constant and is guarded by a check of the (runtime) bounds. Since
+ *        the bounds of nested loops are computed from such constants, their checks are resolved at compile time, even
+ *        if the compiler does not inline the enclosing function.
+ */
+template <size_t end>
+struct UnrolledLoop
+{
+  //! calls f(ii) for ii = begin, ..., stop - 1
+  template <class F>
+  static void apply(const size_t begin, const size_t stop, F&& f)
+  {
+    apply(begin, stop, f, std::integral_constant<size_t, 0>());
+  }
+
+  //! calls f(ii) for ii = end - 1, ..., 0
+  template <class F>
+  static void apply_reversed(F&& f)
+  {
+    apply_reversed(f, std::integral_constant<size_t, end>());
+  }
+
+private:
+  template <class F, size_t ii>
+  static void apply(const size_t begin, const size_t stop, F& f, std::integral_constant<size_t, ii> index)
+  {
+    if (ii >= begin && ii < stop)
+      f(index);
+    apply(begin, stop, f, std::integral_constant<size_t, ii + 1>());
+  }
+
+  template <class F>
+  static void apply(const size_t /*begin*/, const size_t /*stop*/, F& /*f*/, std::integral_constant<size_t, end>)
+  {}
+
+  template <class F, size_t ii>
+  static void apply_reversed(F& f, std::integral_constant<size_t, ii>)
+  {
+    f(std::integral_constant<size_t, ii - 1>());
+    apply_reversed(f, std::integral_constant<size_t, ii - 1>());
+  }
+
+  template <class F>
+  static void apply_reversed(F& /*f*/, std::integral_constant<size_t, 0>)
+  {}
+}; // struct UnrolledLoop
+
+
+} // namespace internal
 
 
 /**
  * \todo We need to implement all operators from the base which return the base, to rather return ourselfes!
+ * \note  For ROWS > 3, invert(), solve() and determinant() do not allocate and their loops are unrolled at compile
+ *        time for ROWS up to 8.
  */
 template <class K, int ROWS, int COLS>
 class FieldMatrix : public Dune::FieldMatrix<K, ROWS, COLS>
@@ -149,13 +207,37 @@ public:
   void solve(V& x, const W& b) const;
 
 private:
+  typedef typename FieldTraits<value_type>::real_type real_type;
+  typedef std::array<size_type, ROWS> PivotType;
+  //! the loops of invert(), solve() and determinant() are unrolled at compile time for small matrices
+  typedef std::integral_constant<bool, (ROWS <= 8)> Unrolled;
+  //! the (cubic) substitution of invert() only pays off for even smaller ones
+  typedef std::integral_constant<bool, (ROWS <= 6)> UnrolledInverse;
+
+  template <class Func>
+  void luDecomposition(ThisType& A, Func& func, const real_type& singthres, std::false_type) const;
+
+  template <class Func>
+  void luDecomposition(ThisType& A, Func& func, const real_type& singthres, std::true_type) const;
+
+  //! computes the inverse from the LU decomposition of invert()
+  void invert(const ThisType& LU, const PivotType& pivot, std::false_type);
+
+  void invert(const ThisType& LU, const PivotType& pivot, std::true_type);
+
+  //! the back substitution of solve()
+  template <class V>
+  static void backsolve(const ThisType& A, V& x, V& rhs, std::false_type);
+
+  template <class V>
+  static void backsolve(const ThisType& A, V& x, V& rhs, std::true_type);
+
   // copy from dune/common/densematrix.hh, we have to copy it as it is a private member of Dune::DenseMatrix
   struct ElimPivot
   {
-    ElimPivot(std::vector<size_type>& pivot)
+    ElimPivot(PivotType& pivot)
       : pivot_(pivot)
     {
-      typedef typename std::vector<size_type>::size_type size_type;
       for (size_type i = 0; i < pivot_.size(); ++i)
         pivot_[i] = i;
     }
@@ -169,7 +251,7 @@ private:
     void operator()(const T&, int, int)
     {}
 
-    std::vector<size_type>& pivot_;
+    PivotType& pivot_;
   }; // struct ElimPivot
 
   template <typename V>
@@ -211,22 +293,31 @@ private:
   };
 }; // class FieldMatrix<...>
 
-// Direct copy of the luDecomposition function in dune/common/densematrix.hh
+// Copy of the luDecomposition function in dune/common/densematrix.hh
 // The only (functional) change is that this version always performs pivotization (the version in dune-common only
 // performs pivotization if the diagonal entry is below a certain threshold)
 // See dune/xt/la/test/matrixinverter_for_real_matrix_from_3d_pointsource.tpl for an example where the dune-common
 // version fails due to stability issues.
-// TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), remove this copy once we depend on a
-// suitable version of dune-common (probably 2.7).
+// In addition, the loops are unrolled for small matrices, since this is called per quadrature point.
+// TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), check whether this copy is still faster
+// once we depend on a suitable version of dune-common (probably 2.7).
 template <class K, int ROWS, int COLS>
 template <typename Func>
 inline void FieldMatrix<K, ROWS, COLS>::luDecomposition(FieldMatrix<K, ROWS, COLS>& A, Func func) const
 {
-  typedef typename FieldTraits<value_type>::real_type real_type;
   real_type norm = A.infinity_norm_real(); // for relative thresholds
   real_type singthres =
       std::max(FMatrixPrecision<real_type>::absolute_limit(), norm * FMatrixPrecision<real_type>::singular_limit());
+  luDecomposition(A, func, singthres, Unrolled());
+}
 
+template <class K, int ROWS, int COLS>
+template <typename Func>
+inline void FieldMatrix<K, ROWS, COLS>::luDecomposition(FieldMatrix<K, ROWS, COLS>& A,
+                                                        Func& func,
+                                                        const real_type& singthres,
+                                                        std::false_type) const
+{
   // LU decomposition of A in A
   for (size_type i = 0; i < ROWS; i++) // loop over all rows
   {
@@ -262,12 +353,48 @@ inline void FieldMatrix<K, ROWS, COLS>::luDecomposition(FieldMatrix<K, ROWS, COL
       func(factor, static_cast<int>(k), static_cast<int>(i));
     }
   }
-}
+} // ... luDecomposition(..., std::false_type)
 
-// Direct copy of the invert function in dune/common/densematrix.hh
+// the same operations as above, in the same order
+template <class K, int ROWS, int COLS>
+template <typename Func>
+inline void FieldMatrix<K, ROWS, COLS>::luDecomposition(FieldMatrix<K, ROWS, COLS>& A,
+                                                        Func& func,
+                                                        const real_type& singthres,
+                                                        std::true_type) const
+{
+  typedef internal::UnrolledLoop<ROWS> Loop;
+  Loop::apply(0, ROWS, [&](const auto i) {
+    real_type pivmax = fvmeta::absreal(A[i][i]);
+    size_type imax = i;
+    Loop::apply(i + 1, ROWS, [&](const auto k) {
+      const real_type abs = fvmeta::absreal(A[k][i]);
+      if (abs > pivmax) {
+        pivmax = abs;
+        imax = k;
+      }
+    });
+    if (imax != i) {
+      for (size_type j = 0; j < ROWS; j++)
+        std::swap(A[i][j], A[imax][j]);
+      func.swap(static_cast<int>(i), static_cast<int>(imax));
+    }
+    if (pivmax < singthres)
+      DUNE_THROW(FMatrixError, "matrix is singular");
+    Loop::apply(i + 1, ROWS, [&](const auto k) {
+      field_type factor = A[k][i] / A[i][i];
+      A[k][i] = factor;
+      Loop::apply(i + 1, ROWS, [&](const auto j) { A[k][j] -= factor * A[i][j]; });
+      func(factor, static_cast<int>(k), static_cast<int>(i));
+    });
+  });
+} // ... luDecomposition(..., std::true_type)
+
+// Copy of the invert function in dune/common/densematrix.hh
 // The only (functional) change is the replacement of the luDecomposition of DenseMatrix by our own version.
-// TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), remove this copy once we depend on a
-// suitable version of dune-common (probably 2.7).
+// In addition, the pivot is kept on the stack and the loops are unrolled for small matrices.
+// TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), check whether this copy is still faster
+// once we depend on a suitable version of dune-common (probably 2.7).
 template <class K, int ROWS, int COLS>
 inline void FieldMatrix<K, ROWS, COLS>::invert()
 {
@@ -278,43 +405,74 @@ inline void FieldMatrix<K, ROWS, COLS>::invert()
     BaseType::invert();
   } else {
     auto A = *this;
-    std::vector<size_type> pivot(ROWS);
+    PivotType pivot;
     this->luDecomposition(A, ElimPivot(pivot));
-    auto& L = A;
-    auto& U = A;
-
-    // initialize inverse
-    *this = field_type();
-
-    for (size_type i = 0; i < ROWS; ++i)
-      (*this)[i][i] = 1;
-
-    // L Y = I; multiple right hand sides
-    for (size_type i = 0; i < ROWS; i++)
-      for (size_type j = 0; j < i; j++)
-        for (size_type k = 0; k < ROWS; k++)
-          (*this)[i][k] -= L[i][j] * (*this)[j][k];
-
-    // U A^{-1} = Y
-    for (size_type i = ROWS; i > 0;) {
-      --i;
-      for (size_type k = 0; k < ROWS; k++) {
-        for (size_type j = i + 1; j < ROWS; j++)
-          (*this)[i][k] -= U[i][j] * (*this)[j][k];
-        (*this)[i][k] /= U[i][i];
-      }
-    }
+    invert(A, pivot, UnrolledInverse());
+  }
+}
 
-    for (size_type i = ROWS; i > 0;) {
-      --i;
-      if (i != pivot[i])
-        for (size_type j = 0; j < ROWS; ++j)
-          std::swap((*this)[j][pivot[i]], (*this)[j][i]);
+template <class K, int ROWS, int COLS>
+inline void FieldMatrix<K, ROWS, COLS>::invert(const ThisType& LU, const PivotType& pivot, std::false_type)
+{
+  const auto& L = LU;
+  const auto& U = LU;
+
+  // initialize inverse
+  *this = field_type();
+
+  for (size_type i = 0; i < ROWS; ++i)
+    (*this)[i][i] = 1;
+
+  // L Y = I; multiple right hand sides
+  for (size_type i = 0; i < ROWS; i++)
+    for (size_type j = 0; j < i; j++)
+      for (size_type k = 0; k < ROWS; k++)
+        (*this)[i][k] -= L[i][j] * (*this)[j][k];
+
+  // U A^{-1} = Y
+  for (size_type i = ROWS; i > 0;) {
+    --i;
+    for (size_type k = 0; k < ROWS; k++) {
+      for (size_type j = i + 1; j < ROWS; j++)
+        (*this)[i][k] -= U[i][j] * (*this)[j][k];
+      (*this)[i][k] /= U[i][i];
     }
   }
-}
 
-// Direct copy of the determinant function in dune/common/densematrix.hh
+  for (size_type i = ROWS; i > 0;) {
+    --i;
+    if (i != pivot[i])
+      for (size_type j = 0; j < ROWS; ++j)
+        std::swap((*this)[j][pivot[i]], (*this)[j][i]);
+  }
+} // ... invert(..., std::false_type)
+
+// the same operations as above, in the same order
+template <class K, int ROWS, int COLS>
+inline void FieldMatrix<K, ROWS, COLS>::invert(const ThisType& LU, const PivotType& pivot, std::true_type)
+{
+  typedef internal::UnrolledLoop<ROWS> Loop;
+  *this = field_type();
+  Loop::apply(0, ROWS, [&](const auto i) { (*this)[i][i] = 1; });
+  Loop::apply(0, ROWS, [&](const auto i) {
+    Loop::apply(0, i, [&](const auto j) {
+      Loop::apply(0, ROWS, [&](const auto k) { (*this)[i][k] -= LU[i][j] * (*this)[j][k]; });
+    });
+  });
+  Loop::apply_reversed([&](const auto i) {
+    Loop::apply(0, ROWS, [&](const auto k) {
+      Loop::apply(i + 1, ROWS, [&](const auto j) { (*this)[i][k] -= LU[i][j] * (*this)[j][k]; });
+      (*this)[i][k] /= LU[i][i];
+    });
+  });
+  Loop::apply_reversed([&](const auto i) {
+    if (i != pivot[i])
+      for (size_type j = 0; j < ROWS; ++j)
+        std::swap((*this)[j][pivot[i]], (*this)[j][i]);
+  });
+} // ... invert(..., std::true_type)
+
+// Copy of the determinant function in dune/common/densematrix.hh
 // The only (functional) change is the replacement of the luDecomposition of DenseMatrix by our own version.
 // TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), remove this copy once we depend on a
 // suitable version of dune-common (probably 2.7).
@@ -357,8 +515,9 @@ inline typename FieldMatrix<K, ROWS, COLS>::field_type FieldMatrix<K, ROWS, COLS
 }
 
 
-// Direct copy of the solve function in dune/common/densematrix.hh
+// Copy of the solve function in dune/common/densematrix.hh
 // The only (functional) change is the replacement of the luDecomposition of DenseMatrix by our own version.
+// In addition, the back substitution is unrolled for small matrices.
 // TODO: Fixed in dune-common master (see MR !449 in dune-common's gitlab), remove this copy once we depend on a
 // suitable version of dune-common (probably 2.7).
 template <class K, int ROWS, int COLS>
@@ -420,16 +579,32 @@ inline void FieldMatrix<K, ROWS, COLS>::solve(V& x, const W& b) const
     auto A = *this;
 
     this->luDecomposition(A, elim);
+    backsolve(A, x, rhs, Unrolled());
+  }
+}
 
-    // backsolve
-    for (int i = ROWS - 1; i >= 0; i--) {
-      for (size_type j = i + 1; j < ROWS; j++)
-        rhs[i] -= A[i][j] * x[j];
-      x[i] = rhs[i] / A[i][i];
-    }
+template <class K, int ROWS, int COLS>
+template <class V>
+inline void FieldMatrix<K, ROWS, COLS>::backsolve(const ThisType& A, V& x, V& rhs, std::false_type)
+{
+  for (int i = ROWS - 1; i >= 0; i--) {
+    for (size_type j = i + 1; j < ROWS; j++)
+      rhs[i] -= A[i][j] * x[j];
+    x[i] = rhs[i] / A[i][i];
   }
 }
 
+template <class K, int ROWS, int COLS>
+template <class V>
+inline void FieldMatrix<K, ROWS, COLS>::backsolve(const ThisType& A, V& x, V& rhs, std::true_type)
+{
+  typedef internal::UnrolledLoop<ROWS> Loop;
+  Loop::apply_reversed([&](const auto i) {
+    Loop::apply(i + 1, ROWS, [&](const auto j) { rhs[i] -= A[i][j] * x[j]; });
+    x[i] = rhs[i] / A[i][i];
+  });
+}
+
 
 /**
  * \todo We need to implement all operators from the base which return the base, to rather return ourselfes!
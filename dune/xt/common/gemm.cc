@@ -0,0 +1,80 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+#include <limits>
+
+#if HAVE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <dune/xt/common/cblas.hh>
+#include <dune/xt/common/numeric_cast.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+
+#include "gemm.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+
+
+void gemm(const size_t m,
+          const size_t n,
+          const size_t k,
+          const double* a,
+          const size_t lda,
+          const double* b,
+          const size_t ldb,
+          double* c,
+          const size_t ldc)
+{
+  static const size_t max_int = std::numeric_limits<int>::max();
+  if (Cblas::available() && m > 0 && n > 0 && k > 0 && std::max({m, n, k, lda, ldb, ldc}) <= max_int) {
+    Cblas::dgemm(Cblas::row_major(),
+                 Cblas::no_trans(),
+                 Cblas::no_trans(),
+                 numeric_cast<int>(m),
+                 numeric_cast<int>(n),
+                 numeric_cast<int>(k),
+                 1.,
+                 a,
+                 numeric_cast<int>(lda),
+                 b,
+                 numeric_cast<int>(ldb),
+                 0.,
+                 c,
+                 numeric_cast<int>(ldc));
+    return;
+  }
+  typedef internal::GemmBlocking<double> B;
+  // each thread gets whole blocks of rows and packs its own panels of B, so there have to be enough rows
+  const size_t num_blocks = (m + B::mc - 1) / B::mc;
+  const size_t num_chunks = (n * k < B::kc * B::kc) ? 1 : std::min(threadManager().max_threads(), num_blocks);
+  if (num_chunks <= 1) {
+    internal::blocked_gemm(n, k, a, lda, b, ldb, c, ldc, 0, m);
+    return;
+  }
+  const auto gemm_chunk = [&](const size_t chunk) {
+    const size_t row_begin = std::min(m, (chunk * num_blocks / num_chunks) * B::mc);
+    const size_t row_end = std::min(m, ((chunk + 1) * num_blocks / num_chunks) * B::mc);
+    internal::blocked_gemm(n, k, a, lda, b, ldb, c, ldc, row_begin, row_end);
+  };
+#if HAVE_TBB
+  tbb::parallel_for(size_t(0), num_chunks, gemm_chunk);
+#else
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    gemm_chunk(chunk);
+#endif
+} // ... gemm(...)
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
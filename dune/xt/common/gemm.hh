@@ -0,0 +1,186 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_GEMM_HH
+#define DUNE_XT_COMMON_GEMM_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+/**
+ * \brief Block sizes of blocked_gemm.
+ *
+ *        The register tile of mr x nr entries of C is kept in registers while looping over kc, the packed kc x nr
+ *        panel of B is meant to stay in the L1 cache, the packed mc x kc block of A in the L2 cache and the packed
+ *        kc x nc panel of B in the L3 cache.
+ */
+template <class K>
+struct GemmBlocking
+{
+  static const size_t mr = 6;
+  //! 64 bytes, i.e., two AVX2 or one AVX-512 register(s) per row of the register tile
+  static const size_t nr = sizeof(K) >= 64 ? 1 : 64 / sizeof(K);
+  static const size_t kc = 256;
+  static const size_t mc = 96;
+  static const size_t nc = 2048;
+};
+
+// the block sizes are passed to std::min by reference
+template <class K>
+const size_t GemmBlocking<K>::mr;
+template <class K>
+const size_t GemmBlocking<K>::nr;
+template <class K>
+const size_t GemmBlocking<K>::kc;
+template <class K>
+const size_t GemmBlocking<K>::mc;
+template <class K>
+const size_t GemmBlocking<K>::nc;
+
+
+//! C[0:rows, 0:cols] += A B for an mr x kc micro-panel of A and a kc x nr micro-panel of B (both packed)
+template <class K, size_t MR, size_t NR>
+void gemm_micro_kernel(
+    const size_t kc, const K* a, const K* b, K* c, const size_t ldc, const size_t rows, const size_t cols)
+{
+  K tile[MR][NR];
+  for (size_t ii = 0; ii < MR; ++ii)
+    for (size_t jj = 0; jj < NR; ++jj)
+      tile[ii][jj] = K(0);
+  for (size_t pp = 0; pp < kc; ++pp, a += MR, b += NR)
+    for (size_t ii = 0; ii < MR; ++ii)
+      for (size_t jj = 0; jj < NR; ++jj)
+        tile[ii][jj] += a[ii] * b[jj];
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      c[ii * ldc + jj] += tile[ii][jj];
+} // ... gemm_micro_kernel(...)
+
+
+/**
+ * \brief C = A B for the rows [row_begin, row_end) of C (row-major, A is m x k, B is k x n, C is m x n).
+ *
+ *        A cache-blocked and register-tiled kernel along the lines of GotoBLAS/BLIS: the blocks of A and B are packed
+ *        into contiguous micro-panels (padded with zeros), so that the micro kernel only streams through memory and
+ *        its innermost loop (over a row of the register tile) vectorizes.
+ */
+template <class K>
+void blocked_gemm(const size_t n,
+                  const size_t k,
+                  const K* a,
+                  const size_t lda,
+                  const K* b,
+                  const size_t ldb,
+                  K* c,
+                  const size_t ldc,
+                  const size_t row_begin,
+                  const size_t row_end)
+{
+  typedef GemmBlocking<K> B;
+  for (size_t ii = row_begin; ii < row_end; ++ii)
+    std::fill(c + ii * ldc, c + ii * ldc + n, K(0));
+  if (row_begin >= row_end || n == 0 || k == 0)
+    return;
+  std::vector<K> packed_a(B::mc * B::kc);
+  std::vector<K> packed_b(B::kc * ((std::min(n, B::nc) + B::nr - 1) / B::nr) * B::nr);
+  for (size_t jc = 0; jc < n; jc += B::nc) {
+    const size_t nc = std::min(B::nc, n - jc);
+    for (size_t pc = 0; pc < k; pc += B::kc) {
+      const size_t kc = std::min(B::kc, k - pc);
+      // pack the kc x nc panel of B into micro-panels of nr columns
+      for (size_t jr = 0; jr < nc; jr += B::nr) {
+        K* panel = packed_b.data() + jr * kc;
+        const size_t cols = std::min(B::nr, nc - jr);
+        for (size_t pp = 0; pp < kc; ++pp) {
+          const K* b_row = b + (pc + pp) * ldb + jc + jr;
+          for (size_t jj = 0; jj < cols; ++jj)
+            panel[pp * B::nr + jj] = b_row[jj];
+          for (size_t jj = cols; jj < B::nr; ++jj)
+            panel[pp * B::nr + jj] = K(0);
+        }
+      }
+      for (size_t ic = row_begin; ic < row_end; ic += B::mc) {
+        const size_t mc = std::min(B::mc, row_end - ic);
+        // pack the mc x kc block of A into micro-panels of mr rows
+        for (size_t ir = 0; ir < mc; ir += B::mr) {
+          K* panel = packed_a.data() + ir * kc;
+          const size_t rows = std::min(B::mr, mc - ir);
+          for (size_t ii = 0; ii < rows; ++ii) {
+            const K* a_row = a + (ic + ir + ii) * lda + pc;
+            for (size_t pp = 0; pp < kc; ++pp)
+              panel[pp * B::mr + ii] = a_row[pp];
+          }
+          for (size_t ii = rows; ii < B::mr; ++ii)
+            for (size_t pp = 0; pp < kc; ++pp)
+              panel[pp * B::mr + ii] = K(0);
+        }
+        for (size_t jr = 0; jr < nc; jr += B::nr)
+          for (size_t ir = 0; ir < mc; ir += B::mr)
+            gemm_micro_kernel<K, B::mr, B::nr>(kc,
+                                               packed_a.data() + ir * kc,
+                                               packed_b.data() + jr * kc,
+                                               c + (ic + ir) * ldc + jc + jr,
+                                               ldc,
+                                               std::min(B::mr, mc - ir),
+                                               std::min(B::nr, nc - jr));
+      }
+    }
+  }
+} // ... blocked_gemm(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief C = A B for dense row-major matrices (A is m x k, B is k x n, C is m x n, the leading dimensions are the
+ *        distances between two rows).
+ */
+template <class K>
+void gemm(const size_t m,
+          const size_t n,
+          const size_t k,
+          const K* a,
+          const size_t lda,
+          const K* b,
+          const size_t ldb,
+          K* c,
+          const size_t ldc)
+{
+  internal::blocked_gemm(n, k, a, lda, b, ldb, c, ldc, 0, m);
+}
+
+
+/**
+ * \brief C = A B, as above.
+ *
+ *        Uses cblas_dgemm if Cblas::available(), the blocked kernel otherwise, which is split among
+ *        threadManager().max_threads() threads (by rows of C, only with TBB).
+ */
+void gemm(const size_t m,
+          const size_t n,
+          const size_t k,
+          const double* a,
+          const size_t lda,
+          const double* b,
+          const size_t ldb,
+          double* c,
+          const size_t ldc);
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_GEMM_HH
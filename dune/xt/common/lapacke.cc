@@ -11,6 +11,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cmath>
 // without the following lapacke will include <complex.h>, which will break dune/commontypetraits.hh^^
 #include <complex>
@@ -23,6 +24,7 @@
 #  include <lapacke.h>
 #endif
 
+#include <dune/xt/common/blas_fallback.hh>
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/unused.hh>
 
@@ -32,12 +34,32 @@
 #  define DXTC_LAPACKE_ONLY(param) param
 #else
 #  define DXTC_LAPACKE_ONLY(param) DXTC_UNUSED(param)
+// the values of the lapacke standard, which are used by all implementations
+#  define LAPACK_ROW_MAJOR 101
+#  define LAPACK_COL_MAJOR 102
 #endif
 
 namespace Dune {
 namespace XT {
 namespace Common {
 namespace Lapacke {
+#if !(HAVE_MKL || HAVE_LAPACKE)
+namespace {
+
+
+bool valid_layout(const int matrix_layout)
+{
+  return matrix_layout == LAPACK_ROW_MAJOR || matrix_layout == LAPACK_COL_MAJOR;
+}
+
+bool valid_uplo(const char uplo)
+{
+  return uplo == 'U' || uplo == 'u' || uplo == 'L' || uplo == 'l';
+}
+
+
+} // namespace
+#endif // !(HAVE_MKL || HAVE_LAPACKE)
 
 
 bool available()
@@ -52,23 +74,13 @@ bool available()
 
 int row_major()
 {
-#if HAVE_MKL || HAVE_LAPACKE
   return LAPACK_ROW_MAJOR;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
 int col_major()
 {
-#if HAVE_MKL || HAVE_LAPACKE
   return LAPACK_COL_MAJOR;
-#else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
-#endif
 }
 
 
@@ -219,37 +231,33 @@ int dgeevx_work(int DXTC_LAPACKE_ONLY(matrix_layout),
 }
 
 
-int dgeqp3(int DXTC_LAPACKE_ONLY(matrix_layout),
-           int DXTC_LAPACKE_ONLY(m),
-           int DXTC_LAPACKE_ONLY(n),
-           double* DXTC_LAPACKE_ONLY(a),
-           int DXTC_LAPACKE_ONLY(lda),
-           int* DXTC_LAPACKE_ONLY(jpvt),
-           double* DXTC_LAPACKE_ONLY(tau))
+int dgeqp3(int matrix_layout, int m, int n, double* a, int lda, int* jpvt, double* tau)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dgeqp3(matrix_layout, m, n, a, lda, jpvt, tau);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  return internal::fallback_geqp3(matrix_layout == LAPACK_ROW_MAJOR, m, n, a, lda, jpvt, tau);
 #endif
 }
 
-int dgeqp3_work(int DXTC_LAPACKE_ONLY(matrix_layout),
-                int DXTC_LAPACKE_ONLY(m),
-                int DXTC_LAPACKE_ONLY(n),
-                double* DXTC_LAPACKE_ONLY(a),
-                int DXTC_LAPACKE_ONLY(lda),
-                int* DXTC_LAPACKE_ONLY(jpvt),
-                double* DXTC_LAPACKE_ONLY(tau),
-                double* DXTC_LAPACKE_ONLY(work),
-                int DXTC_LAPACKE_ONLY(lwork))
+int dgeqp3_work(int matrix_layout, int m, int n, double* a, int lda, int* jpvt, double* tau, double* work, int lwork)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dgeqp3_work(matrix_layout, m, n, a, lda, jpvt, tau, work, lwork);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  // the fallback needs no workspace, but we require as much as LAPACK does
+  const int min_lwork = 3 * std::max(n, 0) + 1;
+  if (lwork == -1) {
+    work[0] = min_lwork;
+    return 0;
+  }
+  if (lwork < min_lwork)
+    return -9;
+  return internal::fallback_geqp3(matrix_layout == LAPACK_ROW_MAJOR, m, n, a, lda, jpvt, tau);
 #endif
 }
 
@@ -280,42 +288,37 @@ double dlamch(char cmach)
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dlamch(cmach);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1.;
+  return internal::fallback_lamch<double>(cmach);
 #endif
 }
 
-int dorgqr(int DXTC_LAPACKE_ONLY(matrix_layout),
-           int DXTC_LAPACKE_ONLY(m),
-           int DXTC_LAPACKE_ONLY(n),
-           int DXTC_LAPACKE_ONLY(k),
-           double* DXTC_LAPACKE_ONLY(a),
-           int DXTC_LAPACKE_ONLY(lda),
-           const double* DXTC_LAPACKE_ONLY(tau))
+int dorgqr(int matrix_layout, int m, int n, int k, double* a, int lda, const double* tau)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dorgqr(matrix_layout, m, n, k, a, lda, tau);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  return internal::fallback_orgqr(matrix_layout == LAPACK_ROW_MAJOR, m, n, k, a, lda, tau);
 #endif
 }
 
-int dorgqr_work(int DXTC_LAPACKE_ONLY(matrix_layout),
-                int DXTC_LAPACKE_ONLY(m),
-                int DXTC_LAPACKE_ONLY(n),
-                int DXTC_LAPACKE_ONLY(k),
-                double* DXTC_LAPACKE_ONLY(a),
-                int DXTC_LAPACKE_ONLY(lda),
-                const double* DXTC_LAPACKE_ONLY(tau),
-                double* DXTC_LAPACKE_ONLY(work),
-                int DXTC_LAPACKE_ONLY(lwork))
+int dorgqr_work(int matrix_layout, int m, int n, int k, double* a, int lda, const double* tau, double* work, int lwork)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dorgqr_work(matrix_layout, m, n, k, a, lda, tau, work, lwork);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  // the fallback needs no workspace, but we require as much as LAPACK does
+  const int min_lwork = std::max(n, 1);
+  if (lwork == -1) {
+    work[0] = min_lwork;
+    return 0;
+  }
+  if (lwork < min_lwork)
+    return -9;
+  return internal::fallback_orgqr(matrix_layout == LAPACK_ROW_MAJOR, m, n, k, a, lda, tau);
 #endif
 }
 
@@ -363,31 +366,29 @@ int dormqr_work(int DXTC_LAPACKE_ONLY(matrix_layout),
 }
 
 
-int dpotrf(int DXTC_LAPACKE_ONLY(matrix_layout),
-           char DXTC_LAPACKE_ONLY(uplo),
-           int DXTC_LAPACKE_ONLY(n),
-           double* DXTC_LAPACKE_ONLY(a),
-           int DXTC_LAPACKE_ONLY(lda))
+int dpotrf(int matrix_layout, char uplo, int n, double* a, int lda)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dpotrf(matrix_layout, uplo, n, a, lda);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  if (!valid_uplo(uplo))
+    return -2;
+  return internal::fallback_potrf(matrix_layout == LAPACK_ROW_MAJOR, uplo == 'L' || uplo == 'l', n, a, lda);
 #endif
 }
 
-int dpotrf_work(int DXTC_LAPACKE_ONLY(matrix_layout),
-                char DXTC_LAPACKE_ONLY(uplo),
-                int DXTC_LAPACKE_ONLY(n),
-                double* DXTC_LAPACKE_ONLY(a),
-                int DXTC_LAPACKE_ONLY(lda))
+int dpotrf_work(int matrix_layout, char uplo, int n, double* a, int lda)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dpotrf_work(matrix_layout, uplo, n, a, lda);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  if (!valid_uplo(uplo))
+    return -2;
+  return internal::fallback_potrf(matrix_layout == LAPACK_ROW_MAJOR, uplo == 'L' || uplo == 'l', n, a, lda);
 #endif
 }
 
@@ -462,30 +463,24 @@ int dtrcon(int DXTC_LAPACKE_ONLY(matrix_layout),
 }
 
 
-int dpttrf(int DXTC_LAPACKE_ONLY(n), double* DXTC_LAPACKE_ONLY(d), double* DXTC_LAPACKE_ONLY(e))
+int dpttrf(int n, double* d, double* e)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dpttrf(n, d, e);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  return internal::fallback_pttrf(n, d, e);
 #endif
 }
 
 
-int dpttrs(int DXTC_LAPACKE_ONLY(matrix_layout),
-           int DXTC_LAPACKE_ONLY(n),
-           int DXTC_LAPACKE_ONLY(nrhs),
-           const double* DXTC_LAPACKE_ONLY(d),
-           const double* DXTC_LAPACKE_ONLY(e),
-           double* DXTC_LAPACKE_ONLY(b),
-           int DXTC_LAPACKE_ONLY(ldb))
+int dpttrs(int matrix_layout, int n, int nrhs, const double* d, const double* e, double* b, int ldb)
 {
 #if HAVE_MKL || HAVE_LAPACKE
   return LAPACKE_dpttrs(matrix_layout, n, nrhs, d, e, b, ldb);
 #else
-  DUNE_THROW(Exceptions::dependency_missing, "You are missing lapacke or the intel mkl, check available() first!");
-  return 1;
+  if (!valid_layout(matrix_layout))
+    return -1;
+  return internal::fallback_pttrs(matrix_layout == LAPACK_ROW_MAJOR, n, nrhs, d, e, b, ldb);
 #endif
 }
 
@@ -23,7 +23,11 @@ namespace Lapacke {
 
 
 /**
- * \brief If true, calling any of the other methods makes sense.
+ * \brief If true, the methods below are provided by the intel mkl or lapacke.
+ *
+ *        Otherwise, row_major, col_major, dgeqp3, dlamch, dorgqr, dpotrf, dpttrf and dpttrs (and their _work
+ *        variants) use the (slower) kernels of blas_fallback.hh, while all other methods throw
+ *        Exceptions::dependency_missing.
  */
 bool available();
 
@@ -24,9 +24,12 @@ namespace XT {
 namespace Common {
 
 Logging::Logging()
-  : streamIDs_({LOG_ERROR, LOG_DEBUG, LOG_INFO})
+  : rotate_(false)
+  , file_(logfile_.rdbuf())
+  , streamIDs_({LOG_ERROR, LOG_DEBUG, LOG_INFO})
   , logflags_(LOG_NONE)
   , emptyLogStream_(logflags_)
+  , rank_(0)
 {
   for (const auto id : streamIDs_)
     streammap_[id] = Dune::XT::Common::make_unique<EmptyLogStream>(logflags_);
@@ -35,6 +38,12 @@ Logging::Logging()
 void Logging::deinit()
 {
   streammap_.clear();
+  if (async_writer_)
+    async_writer_->flush();
+  // not collective, see enable_rank_aggregation
+  rank_aggregator_.reset();
+  file_.rdbuf(logfile_.rdbuf());
+  rotating_file_.reset();
   if ((logflags_ & LOG_FILE) != 0) {
     logfile_ << std::endl;
     logfile_.close();
@@ -44,6 +53,7 @@ void Logging::deinit()
 Logging::~Logging()
 {
   deinit();
+  async_writer_.reset();
 }
 
 void Logging::create(int logflags, const std::string logfile, const std::string datadir, const std::string _logdir)
@@ -56,21 +66,141 @@ void Logging::create(int logflags, const std::string logfile, const std::string
     log_fn = boost::format("%s_p" + rank + "_%s");
   }
   logflags_ = logflags;
+  rank_ = comm.rank();
   path logdir = path(datadir) / _logdir;
   filename_ = logdir / (log_fn % logfile % ".log").str();
+  aggregated_filename_ = logdir / (logfile + ".log");
   test_create_directory(filename_.string());
   const bool file_logging = ((logflags_ & LOG_FILE) != 0);
-  if (file_logging) {
+  if (logfile_.is_open())
+    logfile_.close();
+  // the previous file is only closed once the streams, which might still write to it, are recreated
+  auto previous_file = std::move(rotating_file_);
+  file_.rdbuf(logfile_.rdbuf());
+  if (file_logging && rotate_) {
+    rotating_file_ = Dune::XT::Common::make_unique<RotatingLogFile>(filename_.string(), rotation_);
+    file_.rdbuf(rotating_file_->rdbuf());
+  } else if (file_logging) {
     logfile_.open(filename_);
     DXT_ASSERT(logfile_.is_open());
   }
 
   for (const auto id : streamIDs_) {
     flagmap_[id] = logflags;
-    streammap_[id] = Dune::XT::Common::make_unique<DualLogStream>(id, flagmap_[id], std::cout, logfile_);
+    create_stream(id);
   }
 } // create
 
+void Logging::create_stream(int streamID)
+{
+  if (rank_aggregator_)
+    streammap_[streamID] =
+        Dune::XT::Common::make_unique<RankAggregatedLogStream>(streamID, flagmap_[streamID], *rank_aggregator_);
+  else
+    streammap_[streamID] = Dune::XT::Common::make_unique<DualLogStream>(
+        streamID, flagmap_[streamID], std::cout, file_, async_writer_.get());
+}
+
+void Logging::recreate_streams()
+{
+  for (const auto id : streamIDs_)
+    if (flagmap_.find(id) != flagmap_.end())
+      create_stream(id);
+}
+
+void Logging::enable_async(const size_t capacity, const AsyncLogOverflow overflow)
+{
+  flush();
+  auto previous_writer = std::move(async_writer_);
+  async_writer_ = Dune::XT::Common::make_unique<AsyncLogWriter>(capacity, overflow);
+  // the previous streams (which might still use the previous writer) are destroyed here
+  recreate_streams();
+}
+
+void Logging::disable_async()
+{
+  flush();
+  auto previous_writer = std::move(async_writer_);
+  recreate_streams();
+}
+
+size_t Logging::dropped_records() const
+{
+  return async_writer_ ? async_writer_->dropped() : 0;
+}
+
+void Logging::enable_rank_aggregation(const double send_interval, const double max_delay)
+{
+  flush();
+  const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+  if ((logflags_ & LOG_FILE) != 0 && comm.size() > 1 && filename_ != aggregated_filename_) {
+    file_.rdbuf(logfile_.rdbuf());
+    rotating_file_.reset();
+    logfile_.close();
+    if (boost::filesystem::exists(filename_) && boost::filesystem::is_empty(filename_))
+      boost::filesystem::remove(filename_);
+    if (comm.rank() == 0) {
+      filename_ = aggregated_filename_;
+      if (rotate_) {
+        rotating_file_ = Dune::XT::Common::make_unique<RotatingLogFile>(filename_.string(), rotation_);
+        file_.rdbuf(rotating_file_->rdbuf());
+      } else {
+        logfile_.open(filename_);
+        DXT_ASSERT(logfile_.is_open());
+      }
+    }
+  }
+  auto previous_aggregator = std::move(rank_aggregator_);
+  rank_aggregator_ = Dune::XT::Common::make_unique<RankLogAggregator>(
+      std::vector<std::ostream*>{&std::cout, &file_}, Dune::MPIHelper::getCommunicator(), send_interval, max_delay);
+  // the previous streams (which might still use the previous aggregator) are destroyed here
+  recreate_streams();
+  if (previous_aggregator)
+    previous_aggregator->finish();
+} // ... enable_rank_aggregation(...)
+
+void Logging::disable_rank_aggregation()
+{
+  if (!rank_aggregator_)
+    return;
+  auto previous_aggregator = std::move(rank_aggregator_);
+  recreate_streams();
+  previous_aggregator->finish();
+}
+
+void Logging::enable_rotation(const LogRotation& rotation)
+{
+  if (!log_compression_available(rotation.compression))
+    DUNE_THROW(Dune::NotImplemented, "The requested log compression is not available in this build!");
+  flush();
+  rotate_ = true;
+  rotation_ = rotation;
+  // there is no file without LOG_FILE or on the ranks which do not write the aggregated log
+  if (!logfile_.is_open() && !rotating_file_)
+    return;
+  if (logfile_.is_open()) {
+    file_.rdbuf(logfile_.rdbuf());
+    logfile_.close();
+    if (boost::filesystem::exists(filename_) && boost::filesystem::is_empty(filename_))
+      boost::filesystem::remove(filename_);
+  }
+  auto previous_file = std::move(rotating_file_);
+  rotating_file_ = Dune::XT::Common::make_unique<RotatingLogFile>(filename_.string(), rotation_);
+  file_.rdbuf(rotating_file_->rdbuf());
+} // ... enable_rotation(...)
+
+void Logging::disable_rotation()
+{
+  flush();
+  rotate_ = false;
+  if (!rotating_file_)
+    return;
+  file_.rdbuf(logfile_.rdbuf());
+  rotating_file_.reset();
+  logfile_.open(filename_);
+  DXT_ASSERT(logfile_.is_open());
+}
+
 void Logging::set_prefix(std::string prefix)
 {
   deinit();
@@ -111,6 +241,12 @@ void Logging::flush()
     DXT_ASSERT(pair.second);
     pair.second->flush();
   }
+  if (async_writer_)
+    async_writer_->flush();
+  if (rank_aggregator_)
+    rank_aggregator_->flush();
+  if (rotating_file_)
+    rotating_file_->write_out();
 } // flush
 
 int Logging::add_stream(int flags)
@@ -120,8 +256,7 @@ int Logging::add_stream(int flags)
   int streamID = streamID_int;
   streamIDs_.push_back(streamID);
   flagmap_[streamID] = (flags | streamID);
-  streammap_[streamID] =
-      Dune::XT::Common::make_unique<DualLogStream>(streamID, flagmap_[streamID], std::cout, logfile_);
+  create_stream(streamID);
   return streamID_int;
 } // add_stream
 
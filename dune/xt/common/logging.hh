@@ -27,7 +27,10 @@
 #include <boost/filesystem/fstream.hpp>
 #include <dune/xt/common/reenable_warnings.hh>
 
+#include <dune/xt/common/async_log_writer.hh>
 #include <dune/xt/common/logstreams.hh>
+#include <dune/xt/common/rank_log_aggregator.hh>
+#include <dune/xt/common/rotating_log_file.hh>
 
 namespace Dune {
 namespace XT {
@@ -58,6 +61,58 @@ public:
               const std::string datadir = "data",
               const std::string _logdir = std::string("log"));
 
+  /** \brief Write the output of all streams from a background thread from now on.
+   *
+   *        The streams only queue complete records (everything streamed up to a flush, e.g. by std::endl), so logging
+   *        threads are not stalled by slow consoles or file systems. flush() waits until everything queued before
+   *        has been written, as does the destruction of the Logger().
+   *  \param capacity maximal number of queued records
+   *  \param overflow what to do with records which do not fit into the queue
+   *  \note  The streams are recreated (any references to them are invalidated and suspensions are lifted), so this
+   *         is best called right after create().
+   **/
+  void enable_async(const size_t capacity = 4096, const AsyncLogOverflow overflow = AsyncLogOverflow::block);
+
+  //! write from the logging threads again, \sa enable_async
+  void disable_async();
+
+  //! number of records dropped so far since the queue was full, \sa enable_async
+  size_t dropped_records() const;
+
+  /** \brief Collective, send the output of all streams of all ranks to rank 0 from now on.
+   *
+   *        Rank 0 writes the lines of all ranks (ordered by time, tagged with the ranks which logged them and with
+   *        identical lines of several ranks merged) to the console and to a single log file (without the rank in its
+   *        name, the empty files of the other ranks are removed). The streams do not communicate themselves, but hand
+   *        their lines to a RankLogAggregator, which sends them at most every send_interval seconds.
+   *  \note  Call disable_rank_aggregation() before MPI is finalized, otherwise each rank writes the lines which
+   *         have not been sent yet itself at exit.
+   *  \note  The streams are recreated (\sa enable_async), their output is not written asynchronously from now on.
+   **/
+  void enable_rank_aggregation(const double send_interval = 1., const double max_delay = 10.);
+
+  //! collective, writes everything logged so far on rank 0 and lets each rank write its output itself again
+  void disable_rank_aggregation();
+
+  /** \brief Split the log file into several (optionally compressed) files by size or age from now on.
+   *
+   *        The file of create() is replaced by a RotatingLogFile (e.g. "dune_xt_common_log.0000.log.gz", ...), to
+   *        which the streams only append in memory while a background thread compresses and writes it. flush() waits
+   *        until everything has been written to the file.
+   *  \note  Stays enabled for subsequent calls of create(). If the streams of all ranks are aggregated, only rank 0
+   *         writes files (\sa enable_rank_aggregation).
+   **/
+  void enable_rotation(const LogRotation& rotation);
+
+  //! write to a single file again (the one of create(), which is truncated), \sa enable_rotation
+  void disable_rotation();
+
+  //! the rank of this process (as of create(), 0 before), \sa DXTC_LOG_INFO_0
+  int rank() const
+  {
+    return rank_;
+  }
+
   //! \attention This will probably not do wht we want it to!
   void set_prefix(std::string prefix);
   void set_stream_flags(int streamID, int flags);
@@ -93,7 +148,7 @@ public:
     return emptyLogStream_;
   }
 
-  //! flush all active streams
+  //! flush all active streams (and wait for their output to be written, \sa enable_async)
   void flush();
   //! creates a new LogStream with given flags, returns new ID
   int add_stream(int flags);
@@ -134,9 +189,19 @@ public:
   };
 
 private:
+  //! (re)creates the stream streamID according to its flags
+  void create_stream(int streamID);
+  //! recreates all streams which have been created by create() or add_stream()
+  void recreate_streams();
+
   boost::filesystem::path filename_;
   boost::filesystem::path filenameWoTime_;
   boost::filesystem::ofstream logfile_;
+  std::unique_ptr<RotatingLogFile> rotating_file_;
+  bool rotate_;
+  LogRotation rotation_;
+  //! what the streams write to, the buffer of either logfile_ or rotating_file_
+  std::ostream file_;
   typedef std::map<int, int> FlagMap;
   FlagMap flagmap_;
   typedef std::map<int, std::unique_ptr<LogStream>> StreamMap;
@@ -145,6 +210,11 @@ private:
   IdVec streamIDs_;
   int logflags_;
   EmptyLogStream emptyLogStream_;
+  std::unique_ptr<AsyncLogWriter> async_writer_;
+  std::unique_ptr<RankLogAggregator> rank_aggregator_;
+  //! the log file written by rank 0 if the streams are aggregated
+  boost::filesystem::path aggregated_filename_;
+  int rank_;
 
   friend Logging& Logger();
   // satisfy stricter warnings wrt copying
@@ -168,11 +238,8 @@ DUNE_EXPORT inline Logging& Logger()
 #define DXTC_LOG_ERROR DXTC_LOG.error()
 #define DXTC_LOG_DEVNULL DXTC_LOG.devnull()
 
-#define DXTC_LOG_INFO_0                                                                                                \
-  (Dune::MPIHelper::getCollectiveCommunication().rank() == 0 ? DXTC_LOG.info() : DXTC_LOG.devnull())
-#define DXTC_LOG_DEBUG_0                                                                                               \
-  (Dune::MPIHelper::getCollectiveCommunication().rank() == 0 ? DXTC_LOG.debug() : DXTC_LOG.devnull())
-#define DXTC_LOG_ERROR_0                                                                                               \
-  (Dune::MPIHelper::getCollectiveCommunication().rank() == 0 ? DXTC_LOG.error() : DXTC_LOG.devnull())
+#define DXTC_LOG_INFO_0 (DXTC_LOG.rank() == 0 ? DXTC_LOG.info() : DXTC_LOG.devnull())
+#define DXTC_LOG_DEBUG_0 (DXTC_LOG.rank() == 0 ? DXTC_LOG.debug() : DXTC_LOG.devnull())
+#define DXTC_LOG_ERROR_0 (DXTC_LOG.rank() == 0 ? DXTC_LOG.error() : DXTC_LOG.devnull())
 
 #endif // DUNE_XT_COMMON_LOGGING_HH
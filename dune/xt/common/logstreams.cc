@@ -12,12 +12,37 @@
 
 #include "config.h"
 #include "logstreams.hh"
+#include "async_log_writer.hh"
+#include "rank_log_aggregator.hh"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 
 #include <dune/common/unused.hh>
 
 namespace Dune {
 namespace XT {
 namespace Common {
+namespace {
+
+
+std::atomic<uint64_t> next_suspendable_str_buffer_id(1);
+
+//! the line buffers of the calling thread in the buffers it wrote to last, id 0 marks an empty entry
+struct CachedThreadLine
+{
+  uint64_t buffer_id;
+  std::string* line;
+};
+thread_local std::array<CachedThreadLine, 8> cached_thread_lines{};
+thread_local size_t next_cached_thread_line = 0;
+
+
+} // namespace
+
 
 SuspendableStrBuffer::SuspendableStrBuffer(int loglevel, int& logflags)
   : logflags_(logflags)
@@ -25,7 +50,12 @@ SuspendableStrBuffer::SuspendableStrBuffer(int loglevel, int& logflags)
   , suspended_logflags_(logflags)
   , is_suspended_(false)
   , suspend_priority_(default_suspend_priority)
-{}
+  , id_(next_suspendable_str_buffer_id++)
+  , closed_(false)
+{
+  // without a put area, every character goes through xsputn() or overflow()
+  setp(nullptr, nullptr);
+}
 
 void SuspendableStrBuffer::suspend(PriorityType priority)
 {
@@ -52,20 +82,79 @@ void SuspendableStrBuffer::resume(PriorityType priority)
 
 std::streamsize SuspendableStrBuffer::xsputn(const char_type* s, std::streamsize count)
 {
-  if (enabled()) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    return BaseType::xsputn(s, count);
-  }
-  // pretend everything was written
+  if (enabled() && count > 0)
+    append(s, static_cast<size_t>(count));
+  // if disabled, pretend everything was written
   return std::streamsize(count);
 }
 
 SuspendableStrBuffer::int_type SuspendableStrBuffer::overflow(SuspendableStrBuffer::int_type ch)
 {
-  if (enabled())
-    return BaseType::overflow(ch);
+  if (enabled() && !traits_type::eq_int_type(ch, traits_type::eof())) {
+    const char_type c = traits_type::to_char_type(ch);
+    append(&c, 1);
+  }
   // anything not equal to traits::eof is considered a success
-  return traits_type::eof() + 1;
+  return traits_type::not_eof(ch);
+}
+
+std::string& SuspendableStrBuffer::thread_line()
+{
+  for (const auto& cached : cached_thread_lines)
+    if (cached.buffer_id == id_)
+      return *cached.line;
+  std::string* line = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto& slot = partial_lines_[std::this_thread::get_id()];
+    if (!slot)
+      slot = make_unique<std::string>();
+    line = slot.get();
+  }
+  cached_thread_lines[next_cached_thread_line] = {id_, line};
+  next_cached_thread_line = (next_cached_thread_line + 1) % cached_thread_lines.size();
+  return *line;
+} // ... thread_line(...)
+
+void SuspendableStrBuffer::append(const char_type* s, const size_t count)
+{
+  auto& line = thread_line();
+  line.append(s, count);
+  if (std::memchr(s, '\n', count)) {
+    const auto end_of_last_line = line.rfind('\n') + 1;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      published_lines_.append(line, 0, end_of_last_line);
+    }
+    line.erase(0, end_of_last_line);
+  }
+} // ... append(...)
+
+std::string SuspendableStrBuffer::take_lines()
+{
+  auto& line = thread_line();
+  std::string ret;
+  std::lock_guard<std::mutex> guard(mutex_);
+  ret.swap(published_lines_);
+  // the incomplete lines of the other threads are left alone while they may still be continued
+  if (closed_) {
+    for (auto& entry : partial_lines_) {
+      if (entry.second.get() != &line && !entry.second->empty()) {
+        ret.append(*entry.second);
+        ret.push_back('\n');
+        entry.second->clear();
+      }
+    }
+  }
+  ret.append(line);
+  line.clear();
+  return ret;
+} // ... take_lines(...)
+
+void SuspendableStrBuffer::close()
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  closed_ = true;
 }
 
 int SuspendableStrBuffer::pubsync()
@@ -80,54 +169,72 @@ TimedPrefixedStreamBuffer::TimedPrefixedStreamBuffer(const Timer& timer, const s
   , prefix_(prefix)
   , out_(out)
   , prefix_needed_(true)
+  , elapsed_time_seconds_(0)
 {}
 
 int TimedPrefixedStreamBuffer::sync()
 {
   DUNE_UNUSED std::lock_guard<std::mutex> guard(mutex_);
-  const std::string tmp_str = str();
-  if (prefix_needed_ && !tmp_str.empty()) {
-    out_ << elapsed_time_str() << prefix_;
+  // the lines are scanned within the put area and assembled in output_, whose capacity is kept for the next sync
+  const char* pos = pbase();
+  const char* const end = pptr();
+  output_.clear();
+  if (prefix_needed_ && pos != end) {
+    output_ += elapsed_time_str();
+    output_ += prefix_;
     prefix_needed_ = false;
   }
-  auto lines = tokenize(tmp_str, "\n", boost::algorithm::token_compress_off);
-  DXT_ASSERT(lines.size() > 0);
-  out_ << lines[0];
-  for (size_t ii = 1; ii < lines.size() - 1; ++ii)
-    out_ << "\n" << elapsed_time_str() << prefix_ << lines[ii];
-  if (lines.size() > 1) {
-    out_ << "\n";
-    const auto& last = lines.back();
-    if (last.empty())
+  while (pos != end) {
+    const auto* newline = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (!newline) {
+      output_.append(pos, end);
+      break;
+    }
+    output_.append(pos, newline + 1);
+    pos = newline + 1;
+    if (pos == end)
       prefix_needed_ = true;
-    else
-      out_ << elapsed_time_str() << prefix_ << last;
+    else {
+      output_ += elapsed_time_str();
+      output_ += prefix_;
+    }
   }
+  // everything is written at once, so that output of other threads to out_ does not end up within our lines
+  out_.write(output_.data(), static_cast<std::streamsize>(output_.size()));
   out_.flush();
   str("");
   return 0;
 } // ... sync(...)
 
-std::string TimedPrefixedStreamBuffer::elapsed_time_str() const
-{
-  const double secs_per_week = 604800;
-  const double secs_per_day = 86400;
-  const double secs_per_hour = 3600;
-  const double elapsed = timer_.elapsed();
-  const size_t weeks(elapsed / secs_per_week);
-  const size_t days((elapsed - weeks * secs_per_week) / secs_per_day);
-  const size_t hours((elapsed - weeks * secs_per_week - days * secs_per_day) / 3600.0);
-  const size_t minutes((elapsed - weeks * secs_per_week - days * secs_per_day - hours * secs_per_hour) / 60.0);
-  const size_t seconds(elapsed - weeks * secs_per_week - days * secs_per_day - hours * secs_per_hour - minutes * 60);
+const std::string& TimedPrefixedStreamBuffer::elapsed_time_str()
+{
+  const size_t secs_per_week = 604800;
+  const size_t secs_per_day = 86400;
+  const size_t secs_per_hour = 3600;
+  const size_t elapsed(timer_.elapsed());
+  // only formatted once per second
+  if (elapsed == elapsed_time_seconds_ && !elapsed_time_str_.empty())
+    return elapsed_time_str_;
+  elapsed_time_seconds_ = elapsed;
+  const size_t weeks = elapsed / secs_per_week;
+  const size_t days = (elapsed % secs_per_week) / secs_per_day;
+  const size_t hours = (elapsed % secs_per_day) / secs_per_hour;
+  const size_t minutes = (elapsed % secs_per_hour) / 60;
+  const size_t seconds = elapsed % 60;
+  char buffer[64];
+  int length = 0;
   if (elapsed > secs_per_week) // more than a week
-    return (boost::format("%02dw %02dd %02d:%02d:%02d|") % weeks % days % hours % minutes % seconds).str();
+    length = std::snprintf(
+        buffer, sizeof(buffer), "%02zuw %02zud %02zu:%02zu:%02zu|", weeks, days, hours, minutes, seconds);
   else if (elapsed > secs_per_day) // less than a week, more than a day
-    return (boost::format("%02dd %02d:%02d:%02d|") % days % hours % minutes % seconds).str();
+    length = std::snprintf(buffer, sizeof(buffer), "%02zud %02zu:%02zu:%02zu|", days, hours, minutes, seconds);
   else if (elapsed > secs_per_hour) // less than a day, more than one hour
-    return (boost::format("%02d:%02d:%02d|") % hours % minutes % seconds).str();
+    length = std::snprintf(buffer, sizeof(buffer), "%02zu:%02zu:%02zu|", hours, minutes, seconds);
   else // less than one hour
-    return (boost::format("%02d:%02d|") % minutes % seconds).str();
-} // ... elapsed_time(...)
+    length = std::snprintf(buffer, sizeof(buffer), "%02zu:%02zu|", minutes, seconds);
+  elapsed_time_str_.assign(buffer, static_cast<size_t>(std::max(length, 0)));
+  return elapsed_time_str_;
+} // ... elapsed_time_str(...)
 
 LogStream& LogStream::flush()
 {
@@ -149,18 +256,37 @@ int OstreamBuffer::sync()
 {
   // flush buffer into stream
   std::lock_guard<std::mutex> guard(sync_mutex_);
-  out_ << str();
-  out_.flush();
-  str("");
+  std::string lines = take_lines();
+  if (writer_) {
+    if (!lines.empty())
+      writer_->write(out_, std::move(lines));
+  } else {
+    out_.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    out_.flush();
+  }
+  return 0;
+}
+
+int RankAggregatingBuffer::sync()
+{
+  std::lock_guard<std::mutex> guard(sync_mutex_);
+  aggregator_.add(take_lines());
   return 0;
 }
 
 int EmptyBuffer::sync()
 {
-  str("");
+  take_lines();
   return 0;
 }
 
+void CombinedBuffer::close()
+{
+  for (auto&& buffer_ptr : buffer_)
+    buffer_ptr->close();
+  SuspendableStrBuffer::close();
+}
+
 int CombinedBuffer::pubsync()
 {
   if (!enabled())
@@ -195,15 +321,20 @@ int CombinedBuffer::sync()
   return ret;
 }
 
-DualLogStream::DualLogStream(int loglevel, int& logflags, std::ostream& outstream, std::ofstream& file)
-  : LogStream(new CombinedBuffer(
-        loglevel,
-        logflags,
-        {new OstreamBuffer(loglevel, logflags, outstream), new OstreamBuffer(loglevel, logflags, file)}))
+DualLogStream::DualLogStream(
+    int loglevel, int& logflags, std::ostream& outstream, std::ostream& file, AsyncLogWriter* writer)
+  : LogStream(new CombinedBuffer(loglevel,
+                                 logflags,
+                                 {new OstreamBuffer(loglevel, logflags, outstream, writer),
+                                  new OstreamBuffer(loglevel, logflags, file, writer)}))
+{}
+
+OstreamLogStream::OstreamLogStream(int loglevel, int& logflags, std::ostream& outstream, AsyncLogWriter* writer)
+  : LogStream(new OstreamBuffer(loglevel, logflags, outstream, writer))
 {}
 
-OstreamLogStream::OstreamLogStream(int loglevel, int& logflags, std::ostream& outstream)
-  : LogStream(new OstreamBuffer(loglevel, logflags, outstream))
+RankAggregatedLogStream::RankAggregatedLogStream(int loglevel, int& logflags, RankLogAggregator& aggregator)
+  : LogStream(new RankAggregatingBuffer(loglevel, logflags, aggregator))
 {}
 
 EmptyLogStream::EmptyLogStream(int& logflags)
@@ -13,12 +13,15 @@
 #ifndef DUNE_XT_COMMON_LOGSTREAMS_HH
 #define DUNE_XT_COMMON_LOGSTREAMS_HH
 
+#include <cstdint>
 #include <ostream>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <type_traits>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include <dune/common/timer.hh>
 
@@ -43,7 +46,19 @@ static constexpr auto LogMax = LOG_INFO | LOG_ERROR | LOG_DEBUG | LOG_CONSOLE |
 static constexpr auto LogDefault = LOG_INFO | LOG_ERROR | LOG_CONSOLE;
 
 class CombinedBuffer;
+class AsyncLogWriter;
+class RankLogAggregator;
 
+/**
+ * \brief Base of the buffers of LogStream.
+ *
+ *        Each thread appends to its own line buffer without locking. Only complete lines are published (at once, the
+ *        only time a lock is taken) to the lines which are written to the sink on the next sync, which additionally
+ *        publishes the incomplete line of the syncing thread. Thus, lines written concurrently by several threads do
+ *        not get mixed up. The incomplete lines of other threads are only published once the stream is closed.
+ * \note  The contents of the underlying std::stringbuf are not used, derived classes obtain the published lines by
+ *        take_lines().
+ */
 class SuspendableStrBuffer : public std::basic_stringbuf<char, std::char_traits<char>>
 {
   typedef std::basic_stringbuf<char, std::char_traits<char>> BaseType;
@@ -67,17 +82,29 @@ public:
 
   int pubsync();
 
+  //! no other thread writes anymore, so that the next sync also publishes their incomplete lines
+  virtual void close();
+
 protected:
   friend class CombinedBuffer;
   virtual std::streamsize xsputn(const char_type* s, std::streamsize count);
   virtual int_type overflow(int_type ch = traits_type::eof());
 
+  //! the published lines and the incomplete lines of all threads, which are removed from the buffer
+  std::string take_lines();
+
 private:
   inline bool enabled() const
   {
     return (!is_suspended_) && (logflags_ & loglevel_);
   }
 
+  //! appends count characters to the line buffer of the calling thread and publishes its complete lines
+  void append(const char_type* s, size_t count);
+
+  //! the line buffer of the calling thread, only accessed by this thread (until the stream is closed)
+  std::string& thread_line();
+
   SuspendableStrBuffer(const SuspendableStrBuffer&) = delete;
 
   int& logflags_;
@@ -85,26 +112,58 @@ private:
   int suspended_logflags_;
   bool is_suspended_;
   PriorityType suspend_priority_;
+  //! identifies the buffer in the per thread caches of thread_line(), never reused
+  const uint64_t id_;
+  //! the line buffer of each thread which wrote to this buffer
+  std::unordered_map<std::thread::id, std::unique_ptr<std::string>> partial_lines_;
+  std::string published_lines_;
+  bool closed_;
+  //! guards partial_lines_ (but not the line buffers), published_lines_ and closed_
   std::mutex mutex_;
 }; // class SuspendableStrBuffer
 
 
+/**
+ * \brief Writes its contents to out on each sync, either directly or (if writer is given) by queuing them to be
+ *        written by the background thread of writer.
+ */
 class OstreamBuffer : public SuspendableStrBuffer
 {
 public:
-  OstreamBuffer(int loglevel, int& logflags, std::ostream& out)
+  OstreamBuffer(int loglevel, int& logflags, std::ostream& out, AsyncLogWriter* writer = nullptr)
     : SuspendableStrBuffer(loglevel, logflags)
     , out_(out)
+    , writer_(writer)
   {}
 
 private:
   std::ostream& out_;
+  AsyncLogWriter* writer_;
+  //! keeps the order of the lines taken by concurrent syncs
   std::mutex sync_mutex_;
 
 protected:
   virtual int sync();
 }; // class FileBuffer
 
+//! Hands its contents to aggregator on each sync, \sa RankLogAggregator
+class RankAggregatingBuffer : public SuspendableStrBuffer
+{
+public:
+  RankAggregatingBuffer(int loglevel, int& logflags, RankLogAggregator& aggregator)
+    : SuspendableStrBuffer(loglevel, logflags)
+    , aggregator_(aggregator)
+  {}
+
+private:
+  RankLogAggregator& aggregator_;
+  //! keeps the order of the lines taken by concurrent syncs
+  std::mutex sync_mutex_;
+
+protected:
+  virtual int sync();
+}; // class RankAggregatingBuffer
+
 class CombinedBuffer : public SuspendableStrBuffer
 {
 public:
@@ -118,6 +177,8 @@ public:
 
   int pubsync();
 
+  virtual void close();
+
 protected:
   virtual std::streamsize xsputn(const char_type* s, std::streamsize count);
   virtual int_type overflow(int_type ch = traits_type::eof());
@@ -157,12 +218,16 @@ public:
 private:
   TimedPrefixedStreamBuffer(const TimedPrefixedStreamBuffer&) = delete;
 
-  std::string elapsed_time_str() const;
+  //! the elapsed time in whole seconds, formatted once per second
+  const std::string& elapsed_time_str();
 
   const Timer& timer_;
   const std::string prefix_;
   std::ostream& out_;
   bool prefix_needed_;
+  size_t elapsed_time_seconds_;
+  std::string elapsed_time_str_;
+  std::string output_;
   std::mutex mutex_;
 }; // class TimedPrefixedStreamBuffer
 
@@ -184,6 +249,7 @@ public:
 
   virtual ~LogStream()
   {
+    this->access().close();
     flush();
   }
 
@@ -248,16 +314,23 @@ public:
 class OstreamLogStream : public LogStream
 {
 public:
-  OstreamLogStream(int loglevel, int& logflags, std::ostream& out);
+  OstreamLogStream(int loglevel, int& logflags, std::ostream& out, AsyncLogWriter* writer = nullptr);
 }; // class OstreamLogStream
 
 //! ostream compatible class wrapping file and console output
 class DualLogStream : public LogStream
 {
 public:
-  DualLogStream(int loglevel, int& logflags, std::ostream& out, std::ofstream& file);
+  DualLogStream(int loglevel, int& logflags, std::ostream& out, std::ostream& file, AsyncLogWriter* writer = nullptr);
 }; // class OstreamLogStream
 
+//! ostream compatible class whose output is written by rank 0 of all ranks, \sa RankLogAggregator
+class RankAggregatedLogStream : public LogStream
+{
+public:
+  RankAggregatedLogStream(int loglevel, int& logflags, RankLogAggregator& aggregator);
+}; // class RankAggregatedLogStream
+
 //! /dev/null
 class EmptyLogStream : public LogStream
 {
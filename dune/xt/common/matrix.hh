@@ -14,13 +14,16 @@
 #ifndef DUNE_XT_COMMON_MATRIX_HH
 #define DUNE_XT_COMMON_MATRIX_HH
 
+#include <algorithm>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 #include <dune/common/dynmatrix.hh>
 #include <dune/common/fmatrix.hh>
 
 #include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/gemm.hh>
 #include <dune/xt/common/numeric_cast.hh>
 #include <dune/xt/common/type_traits.hh>
 
@@ -524,19 +527,42 @@ std::basic_ostream<CharType, CharTraits>& output_matrix(std::basic_ostream<CharT
 } // namespace XT
 
 
+/**
+ * \note The rows of a DynamicMatrix are not stored contiguously, so all but small products are computed by copying
+ *       both factors into contiguous buffers and calling XT::Common::gemm (i.e., a blocked kernel or BLAS).
+ */
 template <class K>
 Dune::DynamicMatrix<K> operator*(const Dune::DynamicMatrix<K>& lhs, const Dune::DynamicMatrix<K>& rhs)
 {
-  Dune::DynamicMatrix<K> ret(lhs.rows(), rhs.cols(), 0.);
-  for (size_t ii = 0; ii < lhs.rows(); ++ii) {
-    for (size_t jj = 0; jj < rhs.cols(); ++jj) {
-      ret[ii][jj] = 0.;
-      for (size_t kk = 0; kk < lhs.cols(); ++kk)
-        ret[ii][jj] += lhs[ii][kk] * rhs[kk][jj];
-    }
+  const size_t m = lhs.rows();
+  const size_t k = lhs.cols();
+  const size_t n = rhs.cols();
+  DUNE_THROW_IF(rhs.rows() != k,
+                XT::Common::Exceptions::shapes_do_not_match,
+                "lhs.cols() = " << k << "\n rhs.rows() = " << rhs.rows());
+  Dune::DynamicMatrix<K> ret(m, n, 0.);
+  if (m * n * k <= 32 * 32 * 32) {
+    // the innermost loop runs along the rows of rhs and ret
+    for (size_t ii = 0; ii < m; ++ii)
+      for (size_t kk = 0; kk < k; ++kk) {
+        const K lhs_ik = lhs[ii][kk];
+        for (size_t jj = 0; jj < n; ++jj)
+          ret[ii][jj] += lhs_ik * rhs[kk][jj];
+      }
+    return ret;
   }
+  std::vector<K> a(m * k);
+  std::vector<K> b(k * n);
+  std::vector<K> c(m * n);
+  for (size_t ii = 0; ii < m; ++ii)
+    std::copy(lhs[ii].begin(), lhs[ii].end(), a.begin() + ii * k);
+  for (size_t kk = 0; kk < k; ++kk)
+    std::copy(rhs[kk].begin(), rhs[kk].end(), b.begin() + kk * n);
+  XT::Common::gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+  for (size_t ii = 0; ii < m; ++ii)
+    std::copy(c.begin() + ii * n, c.begin() + (ii + 1) * n, ret[ii].begin());
   return ret;
-}
+} // ... operator*(...)
 
 template <class K>
 Dune::DynamicMatrix<K> operator+(const Dune::DynamicMatrix<K>& lhs, const Dune::DynamicMatrix<K>& rhs)
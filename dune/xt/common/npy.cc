@@ -0,0 +1,175 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <cctype>
+
+#include <dune/xt/common/string.hh>
+
+#include "npy.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+static const char npy_magic[] = "\x93NUMPY";
+static const size_t npy_magic_size = 6;
+
+
+bool npy_little_endian()
+{
+  const std::uint16_t one = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+
+std::string npy_header(const std::string& descr, const bool fortran_order, const std::vector<size_t>& shape)
+{
+  std::string dict = "{'descr': '" + descr + "', 'fortran_order': " + (fortran_order ? "True" : "False")
+                     + ", 'shape': (";
+  for (size_t ii = 0; ii < shape.size(); ++ii)
+    dict += (ii > 0 ? ", " : "") + std::to_string(shape[ii]);
+  if (shape.size() == 1)
+    dict += ','; // (n) would not be a tuple
+  dict += ')';
+  dict += ", }";
+  // the data has to start at a multiple of 64 bytes, the header ends with a newline
+  const size_t preamble_size = npy_magic_size + 2 + 2;
+  const size_t total_size = ((preamble_size + dict.size() + 1 + 63) / 64) * 64;
+  if (total_size - preamble_size > 65535)
+    DUNE_THROW(Dune::IOError, "The shape has too many dimensions to be written to a .npy file!");
+  dict.append(total_size - preamble_size - dict.size() - 1, ' ');
+  dict += '\n';
+  const auto header_size = static_cast<std::uint16_t>(dict.size());
+  std::string ret(npy_magic, npy_magic_size);
+  ret += '\x01'; // version 1.0
+  ret += '\x00';
+  ret += static_cast<char>(header_size & 0xff); // little endian, regardless of the platform
+  ret += static_cast<char>(header_size >> 8);
+  ret += dict;
+  return ret;
+} // ... npy_header(...)
+
+
+namespace {
+
+
+void skip_npy_space(const char*& pos, const char* last)
+{
+  while (pos != last && std::isspace(static_cast<unsigned char>(*pos)))
+    ++pos;
+}
+
+// the value of key in the python dict [first, last), which ends at the next ',' or '}' outside of parentheses
+std::string npy_dict_value(const char* first, const char* last, const std::string& key, const std::string& filename)
+{
+  for (const char quote : {'\'', '"'}) {
+    const std::string quoted_key = quote + key + quote;
+    const auto found = std::search(first, last, quoted_key.begin(), quoted_key.end());
+    if (found == last)
+      continue;
+    const char* pos = found + quoted_key.size();
+    skip_npy_space(pos, last);
+    if (pos == last || *pos != ':')
+      break;
+    ++pos;
+    skip_npy_space(pos, last);
+    const char* value_end = pos;
+    if (value_end != last && *value_end == '(')
+      value_end = std::find(value_end, last, ')');
+    else if (value_end != last && (*value_end == '\'' || *value_end == '"'))
+      value_end = std::find(value_end + 1, last, *value_end);
+    else
+      while (value_end != last && *value_end != ',' && *value_end != '}')
+        ++value_end;
+    if (value_end != last && (*value_end == ')' || *value_end == '\'' || *value_end == '"'))
+      ++value_end;
+    std::string value(pos, value_end);
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+      value.pop_back();
+    return value;
+  }
+  DUNE_THROW(Dune::IOError, "The header of '" << filename << "' does not contain '" << key << "'!");
+  return "";
+} // ... npy_dict_value(...)
+
+
+} // namespace
+
+
+NpyHeader read_npy_header(const char* first, const char* last, const std::string& filename)
+{
+  const size_t size = static_cast<size_t>(last - first);
+  if (size < npy_magic_size + 4 || std::memcmp(first, npy_magic, npy_magic_size) != 0)
+    DUNE_THROW(Dune::IOError, "'" << filename << "' is not a .npy file!");
+  const auto major_version = static_cast<unsigned char>(first[npy_magic_size]);
+  const auto* bytes = reinterpret_cast<const unsigned char*>(first + npy_magic_size + 2);
+  size_t header_size = 0;
+  size_t preamble_size = 0;
+  if (major_version == 1) {
+    header_size = bytes[0] | (size_t(bytes[1]) << 8);
+    preamble_size = npy_magic_size + 2 + 2;
+  } else if ((major_version == 2 || major_version == 3) && size >= npy_magic_size + 6) {
+    header_size = bytes[0] | (size_t(bytes[1]) << 8) | (size_t(bytes[2]) << 16) | (size_t(bytes[3]) << 24);
+    preamble_size = npy_magic_size + 2 + 4;
+  } else
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' has the unsupported .npy format version " << int(major_version) << "!");
+  if (preamble_size + header_size > size)
+    DUNE_THROW(Dune::IOError, "'" << filename << "' is truncated!");
+  const char* dict_begin = first + preamble_size;
+  const char* dict_end = dict_begin + header_size;
+  NpyHeader ret;
+  ret.data_offset = preamble_size + header_size;
+  ret.descr = npy_dict_value(dict_begin, dict_end, "descr", filename);
+  if (ret.descr.size() < 2 || (ret.descr.front() != '\'' && ret.descr.front() != '"'))
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' contains a structured array, which is not supported (" << ret.descr << ")!");
+  ret.descr = ret.descr.substr(1, ret.descr.size() - 2);
+  const auto fortran_order = npy_dict_value(dict_begin, dict_end, "fortran_order", filename);
+  if (fortran_order != "True" && fortran_order != "False")
+    DUNE_THROW(Dune::IOError, "'" << filename << "' contains an invalid fortran_order: " << fortran_order << "!");
+  ret.fortran_order = (fortran_order == "True");
+  const auto shape = npy_dict_value(dict_begin, dict_end, "shape", filename);
+  if (shape.size() < 2 || shape.front() != '(' || shape.back() != ')')
+    DUNE_THROW(Dune::IOError, "'" << filename << "' contains an invalid shape: " << shape << "!");
+  const char* pos = shape.data() + 1;
+  const char* const shape_end = shape.data() + shape.size() - 1;
+  while (true) {
+    skip_npy_space(pos, shape_end);
+    if (pos == shape_end)
+      break;
+    size_t extent = 0;
+    const char* extent_end = pos;
+    if (parse_number(pos, shape_end, extent, &extent_end) != std::errc() || extent_end == pos)
+      DUNE_THROW(Dune::IOError, "'" << filename << "' contains an invalid shape: " << shape << "!");
+    ret.shape.push_back(extent);
+    pos = extent_end;
+    skip_npy_space(pos, shape_end);
+    if (pos != shape_end && *pos++ != ',')
+      DUNE_THROW(Dune::IOError, "'" << filename << "' contains an invalid shape: " << shape << "!");
+  }
+  const std::string item_size = ret.descr.substr(std::min(ret.descr.size(), size_t(2)));
+  size_t bytes_per_element = 0;
+  if (ret.descr.size() < 3 || parse_number(item_size.data(), item_size.data() + item_size.size(), bytes_per_element)
+                                  != std::errc())
+    DUNE_THROW(Dune::IOError, "'" << filename << "' contains the unsupported data type '" << ret.descr << "'!");
+  if (ret.data_offset + ret.num_elements() * bytes_per_element > size)
+    DUNE_THROW(Dune::IOError, "'" << filename << "' is truncated!");
+  return ret;
+} // ... read_npy_header(...)
+
+
+} // namespace internal
+} // namespace Common
+} // namespace XT
+} // namespace Dune
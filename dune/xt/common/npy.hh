@@ -0,0 +1,471 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+/**
+ * \file  npy.hh
+ * \brief Reading and writing of vectors and matrices in the binary .npy format of numpy.
+ * \sa    https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+ **/
+#ifndef DUNE_XT_COMMON_NPY_HH
+#define DUNE_XT_COMMON_NPY_HH
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/xt/common/debug.hh>
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/filesystem.hh>
+#include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/type_traits.hh>
+#include <dune/xt/common/vector.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+struct NpyHeader
+{
+  std::string descr;
+  bool fortran_order;
+  std::vector<size_t> shape;
+  //! offset of the data from the beginning of the file
+  size_t data_offset;
+
+  size_t num_elements() const
+  {
+    size_t ret = 1;
+    for (const auto& extent : shape)
+      ret *= extent;
+    return ret;
+  }
+}; // struct NpyHeader
+
+bool npy_little_endian();
+
+//! the numpy dtype string of S, e.g. '<f8' for double
+template <class S>
+std::string npy_descr()
+{
+  static_assert(std::is_arithmetic<S>::value || is_complex<S>::value, "Only numbers can be stored in .npy files!");
+  char kind = 'u';
+  if (std::is_same<S, bool>::value)
+    kind = 'b';
+  else if (is_complex<S>::value)
+    kind = 'c';
+  else if (std::is_floating_point<S>::value)
+    kind = 'f';
+  else if (std::is_signed<S>::value)
+    kind = 'i';
+  const char byte_order = (sizeof(S) == 1) ? '|' : (npy_little_endian() ? '<' : '>');
+  return std::string(1, byte_order) + kind + std::to_string(sizeof(S));
+}
+
+//! the complete header (magic string, version, length and dictionary) for the given array
+std::string npy_header(const std::string& descr, const bool fortran_order, const std::vector<size_t>& shape);
+
+//! \throws Dune::IOError if [first, last) does not start with a valid header
+NpyHeader read_npy_header(const char* first, const char* last, const std::string& filename);
+
+template <class S, class T, class F>
+bool visit_npy_data_as(const char* data, const size_t num_elements, F& f)
+{
+  T value;
+  for (size_t ii = 0; ii < num_elements; ++ii) {
+    std::memcpy(&value, data + ii * sizeof(T), sizeof(T));
+    f(ii, static_cast<S>(value));
+  }
+  return true;
+}
+
+template <class S, class F>
+bool visit_npy_data(const std::string& type, const char* data, const size_t num_elements, F& f, std::true_type)
+{
+  if (type == "c8")
+    return visit_npy_data_as<S, std::complex<float>>(data, num_elements, f);
+  if (type == "c16")
+    return visit_npy_data_as<S, std::complex<double>>(data, num_elements, f);
+  return false;
+}
+
+template <class S, class F>
+bool visit_npy_data(const std::string& type, const char* data, const size_t num_elements, F& f, std::false_type)
+{
+  if (type == "f4")
+    return visit_npy_data_as<S, float>(data, num_elements, f);
+  if (type == "f8")
+    return visit_npy_data_as<S, double>(data, num_elements, f);
+  if (type == "i1")
+    return visit_npy_data_as<S, std::int8_t>(data, num_elements, f);
+  if (type == "i2")
+    return visit_npy_data_as<S, std::int16_t>(data, num_elements, f);
+  if (type == "i4")
+    return visit_npy_data_as<S, std::int32_t>(data, num_elements, f);
+  if (type == "i8")
+    return visit_npy_data_as<S, std::int64_t>(data, num_elements, f);
+  if (type == "u1")
+    return visit_npy_data_as<S, std::uint8_t>(data, num_elements, f);
+  if (type == "u2")
+    return visit_npy_data_as<S, std::uint16_t>(data, num_elements, f);
+  if (type == "u4")
+    return visit_npy_data_as<S, std::uint32_t>(data, num_elements, f);
+  if (type == "u8")
+    return visit_npy_data_as<S, std::uint64_t>(data, num_elements, f);
+  if (type == "b1")
+    return visit_npy_data_as<S, bool>(data, num_elements, f);
+  return false;
+}
+
+/**
+ * \brief Calls f(ii, value) for each of the num_elements entries in data, converting from the type given by descr.
+ * \return false if descr is not supported (only native byte order is)
+ */
+template <class S, class F>
+bool visit_npy_data(const std::string& descr, const char* data, const size_t num_elements, F&& f)
+{
+  if (descr.size() < 3 || (descr[0] != '|' && descr[0] != '=' && descr[0] != (npy_little_endian() ? '<' : '>')))
+    return false;
+  return visit_npy_data<S>(descr.substr(1), data, num_elements, f, is_complex<S>());
+}
+
+static inline std::ofstream open_npy_file(const std::string& filename, const std::string& header)
+{
+  test_create_directory(filename);
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file)
+    DUNE_THROW(Dune::IOError, "Could not open '" << filename << "' for writing!");
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  return file;
+}
+
+static inline void close_npy_file(std::ofstream& file, const std::string& filename)
+{
+  file.close();
+  if (!file)
+    DUNE_THROW(Dune::IOError, "Could not write '" << filename << "'!");
+}
+
+//! writes contiguous data with a single write
+template <class S>
+void write_npy_data(std::ofstream& file, const S* data, const size_t num_elements)
+{
+  file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(num_elements * sizeof(S)));
+}
+
+//! writes get_entry(0), ..., get_entry(num_elements - 1) through a buffer of limited size
+template <class S, class GetEntryType>
+void write_npy_entries(std::ofstream& file, const size_t num_elements, GetEntryType&& get_entry)
+{
+  std::vector<S> buffer(std::min(num_elements, size_t(1) << 16));
+  for (size_t offset = 0; offset < num_elements; offset += buffer.size()) {
+    const size_t count = std::min(buffer.size(), num_elements - offset);
+    for (size_t ii = 0; ii < count; ++ii)
+      buffer[ii] = get_entry(offset + ii);
+    write_npy_data(file, buffer.data(), count);
+  }
+}
+
+template <class S>
+[[noreturn]] void throw_unsupported_npy_type(const NpyHeader& header, const std::string& filename)
+{
+  DUNE_THROW(Dune::IOError,
+             "Data type '" << header.descr << "' of '" << filename << "' cannot be read as " << Typename<S>::value()
+                           << "!");
+}
+
+//! copies data of the same type at once, converts all others
+template <class S>
+void read_npy_data(const NpyHeader& header, const char* data, const std::string& filename, S* target)
+{
+  const auto set_entry = [&](const size_t ii, const S& value) { target[ii] = value; };
+  if (header.descr == npy_descr<S>())
+    std::memcpy(target, data, header.num_elements() * sizeof(S));
+  else if (!visit_npy_data<S>(header.descr, data, header.num_elements(), set_entry))
+    throw_unsupported_npy_type<S>(header, filename);
+}
+
+template <class S, class SetEntryType>
+void read_npy_entries(const NpyHeader& header, const char* data, const std::string& filename, SetEntryType&& set_entry)
+{
+  if (!visit_npy_data<S>(header.descr, data, header.num_elements(), set_entry))
+    throw_unsupported_npy_type<S>(header, filename);
+}
+
+
+// the storage of VectorType is contiguous
+template <class VectorType>
+void write_npy_vector(std::ofstream& file, const VectorType& vec, std::true_type)
+{
+  if (vec.size() > 0)
+    write_npy_data(file, VectorAbstraction<VectorType>::data(vec), vec.size());
+}
+
+template <class VectorType>
+void write_npy_vector(std::ofstream& file, const VectorType& vec, std::false_type)
+{
+  using V = VectorAbstraction<VectorType>;
+  write_npy_entries<typename V::S>(file, vec.size(), [&](const size_t ii) { return V::get_entry(vec, ii); });
+}
+
+template <class VectorType>
+void read_npy_vector(const NpyHeader& header,
+                     const char* data,
+                     const std::string& filename,
+                     VectorType& vec,
+                     std::true_type)
+{
+  if (vec.size() > 0)
+    read_npy_data(header, data, filename, VectorAbstraction<VectorType>::data(vec));
+}
+
+template <class VectorType>
+void read_npy_vector(const NpyHeader& header,
+                     const char* data,
+                     const std::string& filename,
+                     VectorType& vec,
+                     std::false_type)
+{
+  using V = VectorAbstraction<VectorType>;
+  read_npy_entries<typename V::S>(
+      header, data, filename, [&](const size_t ii, const typename V::S& value) { V::set_entry(vec, ii, value); });
+}
+
+
+template <class MatrixType>
+struct npy_matrix_is_dense
+  : public std::integral_constant<bool,
+                                  MatrixAbstraction<MatrixType>::storage_layout == StorageLayout::dense_row_major
+                                      || MatrixAbstraction<MatrixType>::storage_layout
+                                             == StorageLayout::dense_column_major>
+{};
+
+template <class MatrixType>
+void write_npy_matrix(std::ofstream& file, const MatrixType& mat, const size_t rows, const size_t cols, std::true_type)
+{
+  if (rows * cols > 0)
+    write_npy_data(file, MatrixAbstraction<MatrixType>::data(mat), rows * cols);
+}
+
+template <class MatrixType>
+void write_npy_matrix(std::ofstream& file, const MatrixType& mat, const size_t rows, const size_t cols, std::false_type)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  if (cols > 0)
+    write_npy_entries<typename M::S>(
+        file, rows * cols, [&](const size_t ii) { return M::get_entry(mat, ii / cols, ii % cols); });
+}
+
+template <class MatrixType>
+void read_npy_matrix_entries(const NpyHeader& header, const char* data, const std::string& filename, MatrixType& mat)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  const size_t rows = header.shape[0];
+  const size_t cols = header.shape[1];
+  read_npy_entries<typename M::S>(header, data, filename, [&](const size_t ii, const typename M::S& value) {
+    if (header.fortran_order)
+      M::set_entry(mat, ii % rows, ii / rows, value);
+    else
+      M::set_entry(mat, ii / cols, ii % cols, value);
+  });
+}
+
+template <class MatrixType>
+void read_npy_matrix(const NpyHeader& header,
+                     const char* data,
+                     const std::string& filename,
+                     MatrixType& mat,
+                     std::true_type)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  const bool column_major = (M::storage_layout == StorageLayout::dense_column_major);
+  if (header.fortran_order != column_major)
+    read_npy_matrix_entries(header, data, filename, mat);
+  else if (header.num_elements() > 0)
+    read_npy_data(header, data, filename, M::data(mat));
+}
+
+template <class MatrixType>
+void read_npy_matrix(const NpyHeader& header,
+                     const char* data,
+                     const std::string& filename,
+                     MatrixType& mat,
+                     std::false_type)
+{
+  read_npy_matrix_entries(header, data, filename, mat);
+}
+
+
+} // namespace internal
+
+
+/**
+ * \brief Writes a vector as one-dimensional array to a .npy file.
+ *
+ *        Contiguous vectors are written with a single write, all others are gathered in chunks.
+ */
+template <class VectorType>
+typename std::enable_if<is_vector<VectorType>::value>::type write_npy(const std::string& filename,
+                                                                        const VectorType& vec)
+{
+  using V = VectorAbstraction<VectorType>;
+  auto file = internal::open_npy_file(
+      filename, internal::npy_header(internal::npy_descr<typename V::S>(), false, {vec.size()}));
+  internal::write_npy_vector(file, vec, std::integral_constant<bool, V::is_contiguous>());
+  internal::close_npy_file(file, filename);
+}
+
+
+/**
+ * \brief Writes a matrix as two-dimensional array to a .npy file.
+ *
+ *        Matrices with dense storage are written with a single write (column major ones with fortran_order set), all
+ *        others are gathered row-wise in chunks.
+ */
+template <class MatrixType>
+typename std::enable_if<is_matrix<MatrixType>::value>::type write_npy(const std::string& filename,
+                                                                        const MatrixType& mat)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  const size_t rows = M::rows(mat);
+  const size_t cols = M::cols(mat);
+  const bool fortran_order = (M::storage_layout == StorageLayout::dense_column_major);
+  auto file = internal::open_npy_file(
+      filename, internal::npy_header(internal::npy_descr<typename M::S>(), fortran_order, {rows, cols}));
+  internal::write_npy_matrix(file, mat, rows, cols, internal::npy_matrix_is_dense<MatrixType>());
+  internal::close_npy_file(file, filename);
+}
+
+
+/**
+ * \brief Reads a vector from a one-dimensional array in a .npy file.
+ *
+ *        The file is mapped into memory, data of the same type is copied into contiguous vectors at once, other data
+ *        types are converted (if possible).
+ * \throws Dune::IOError if the file cannot be read or contains an array of a different shape or an unsupported type
+ * \sa     MappedNpyArray to access the data without copying
+ */
+template <class VectorType>
+typename std::enable_if<is_vector<VectorType>::value, VectorType>::type read_npy(const std::string& filename)
+{
+  using V = VectorAbstraction<VectorType>;
+  const MappedFile file(filename);
+  const auto header = internal::read_npy_header(file.begin(), file.end(), filename);
+  if (header.shape.size() != 1)
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' contains a " << header.shape.size() << "-dimensional array, not a vector!");
+  const size_t size = header.shape[0];
+  if (V::has_static_size && size != V::static_size)
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' contains a vector of size " << size << ", but " << V::static_size
+                   << " is required for " << Typename<VectorType>::value() << "!");
+  VectorType ret = V::create(size);
+  internal::read_npy_vector(
+      header, file.begin() + header.data_offset, filename, ret, std::integral_constant<bool, V::is_contiguous>());
+  return ret;
+} // ... read_npy(...)
+
+
+/**
+ * \brief Reads a matrix from a two-dimensional array in a .npy file.
+ * \sa    read_npy for vectors
+ */
+template <class MatrixType>
+typename std::enable_if<is_matrix<MatrixType>::value, MatrixType>::type read_npy(const std::string& filename)
+{
+  using M = MatrixAbstraction<MatrixType>;
+  const MappedFile file(filename);
+  const auto header = internal::read_npy_header(file.begin(), file.end(), filename);
+  if (header.shape.size() != 2)
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' contains a " << header.shape.size() << "-dimensional array, not a matrix!");
+  const size_t rows = header.shape[0];
+  const size_t cols = header.shape[1];
+  if (M::has_static_size && (rows != M::static_rows || cols != M::static_cols))
+    DUNE_THROW(Dune::IOError,
+               "'" << filename << "' contains a " << rows << "x" << cols << " matrix, but " << M::static_rows << "x"
+                   << M::static_cols << " is required for " << Typename<MatrixType>::value() << "!");
+  MatrixType ret = M::create(rows, cols);
+  internal::read_npy_matrix(
+      header, file.begin() + header.data_offset, filename, ret, internal::npy_matrix_is_dense<MatrixType>());
+  return ret;
+} // ... read_npy(...)
+
+
+/**
+ * \brief Read-only view on the array in a .npy file, which is mapped into memory and not copied.
+ *
+ * \code
+MappedNpyArray<double> snapshots("snapshots.npy");
+for (size_t ii = 0; ii < snapshots.shape()[0]; ++ii)
+  do_something(snapshots.data()[ii * snapshots.shape()[1]]);
+\endcode
+ * \throws Dune::IOError if the file does not contain an array of type S
+ */
+template <class S>
+class MappedNpyArray
+{
+public:
+  explicit MappedNpyArray(const std::string& filename)
+    : file_(std::make_unique<MappedFile>(filename))
+    , header_(internal::read_npy_header(file_->begin(), file_->end(), filename))
+  {
+    if (header_.descr != internal::npy_descr<S>())
+      DUNE_THROW(Dune::IOError,
+                 "'" << filename << "' contains data of type '" << header_.descr << "', not "
+                     << Typename<S>::value() << " ('" << internal::npy_descr<S>() << "')!");
+    if (reinterpret_cast<std::uintptr_t>(file_->begin() + header_.data_offset) % alignof(S) != 0)
+      DUNE_THROW(Dune::IOError, "The data in '" << filename << "' is not properly aligned to be mapped!");
+  }
+
+  const S* data() const
+  {
+    return reinterpret_cast<const S*>(file_->begin() + header_.data_offset);
+  }
+
+  const std::vector<size_t>& shape() const
+  {
+    return header_.shape;
+  }
+
+  size_t size() const
+  {
+    return header_.num_elements();
+  }
+
+  bool fortran_order() const
+  {
+    return header_.fortran_order;
+  }
+
+  //! entry (row, col) of a two-dimensional array
+  const S& operator()(const size_t row, const size_t col) const
+  {
+    DXT_ASSERT(header_.shape.size() == 2);
+    return header_.fortran_order ? data()[col * header_.shape[0] + row] : data()[row * header_.shape[1] + col];
+  }
+
+private:
+  std::unique_ptr<MappedFile> file_;
+  internal::NpyHeader header_;
+}; // class MappedNpyArray
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_NPY_HH
@@ -0,0 +1,393 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+#include <dune/common/unused.hh>
+
+#include "rank_log_aggregator.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+std::string format_rank_ranges(const std::vector<int>& ranks)
+{
+  std::string ret;
+  for (size_t ii = 0; ii < ranks.size();) {
+    size_t jj = ii;
+    while (jj + 1 < ranks.size() && ranks[jj + 1] == ranks[jj] + 1)
+      ++jj;
+    if (!ret.empty())
+      ret += ',';
+    ret += std::to_string(ranks[ii]);
+    if (jj > ii)
+      ret += '-' + std::to_string(ranks[jj]);
+    ii = jj + 1;
+  }
+  return ret;
+} // ... format_rank_ranges(...)
+
+
+std::string format_rank_log_entries(const std::vector<RankLogEntry>& entries)
+{
+  struct Line
+  {
+    double time;
+    std::vector<int> ranks;
+    std::string text;
+  };
+  std::vector<Line> lines;
+  // the n-th occurrence of a text on a rank is merged with the n-th line of that text
+  struct Occurrences
+  {
+    std::vector<size_t> lines;
+    std::unordered_map<int, size_t> per_rank;
+  };
+  std::unordered_map<std::string, Occurrences> occurrences;
+  for (const auto& entry : entries) {
+    size_t begin = 0;
+    while (begin < entry.lines.size()) {
+      size_t end = entry.lines.find('\n', begin);
+      if (end == std::string::npos)
+        end = entry.lines.size();
+      std::string text = entry.lines.substr(begin, end - begin);
+      begin = end + 1;
+      auto& occurrence = occurrences[text];
+      const size_t nth = occurrence.per_rank[entry.rank]++;
+      if (nth < occurrence.lines.size())
+        lines[occurrence.lines[nth]].ranks.push_back(entry.rank);
+      else {
+        occurrence.lines.push_back(lines.size());
+        lines.push_back({entry.time, {entry.rank}, std::move(text)});
+      }
+    }
+  }
+  std::string ret;
+  char time[32];
+  for (auto& line : lines) {
+    std::sort(line.ranks.begin(), line.ranks.end());
+    std::snprintf(time, sizeof(time), "[%9.3fs|r", line.time);
+    ret += time;
+    ret += format_rank_ranges(line.ranks);
+    ret += "] ";
+    ret += line.text;
+    ret += '\n';
+  }
+  return ret;
+} // ... format_rank_log_entries(...)
+
+
+} // namespace internal
+namespace {
+
+
+template <class T>
+void append_raw(std::string& buffer, const T& value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+T read_raw(const std::string& buffer, size_t& pos)
+{
+  T ret;
+  std::memcpy(&ret, buffer.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return ret;
+}
+
+
+} // namespace
+
+
+RankLogAggregator::RankLogAggregator(std::vector<std::ostream*> outs,
+                                     CommunicatorType comm,
+                                     const double send_interval,
+                                     const double max_delay)
+  : outs_(std::move(outs))
+  , send_interval_(send_interval)
+  , max_delay_(max_delay)
+  , rank_(0)
+  , size_(1)
+  , communicate_(false)
+  , thread_multiple_(true)
+  , owner_(std::this_thread::get_id())
+  , next_progress_(send_interval)
+  , finished_(false)
+#if HAVE_MPI
+  , comm_(MPI_COMM_NULL)
+  , request_(MPI_REQUEST_NULL)
+#endif
+{
+#if HAVE_MPI
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized) {
+    MPI_Comm_dup(comm, &comm_);
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &size_);
+    communicate_ = (size_ > 1);
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    thread_multiple_ = (provided == MPI_THREAD_MULTIPLE);
+    // the times of all ranks start (roughly) together
+    MPI_Barrier(comm_);
+  }
+#else
+  DUNE_UNUSED_PARAMETER(comm);
+#endif
+  start_ = std::chrono::steady_clock::now();
+  sent_until_.assign(size_, 0.);
+} // RankLogAggregator(...)
+
+RankLogAggregator::~RankLogAggregator()
+{
+#if HAVE_MPI
+  int finalized = 0;
+  if (communicate_)
+    MPI_Finalized(&finalized);
+  if (finalized)
+    communicate_ = false;
+#endif
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  if (!finished_) {
+    if (rank_ == 0) {
+      collect(false);
+      write_pending(std::numeric_limits<double>::infinity());
+    }
+    std::lock_guard<std::mutex> entries_lock(mutex_);
+    write_local();
+  }
+#if HAVE_MPI
+  if (communicate_) {
+    if (request_ != MPI_REQUEST_NULL) {
+      // guaranteed to return, even if rank 0 never receives
+      MPI_Cancel(&request_);
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+    MPI_Comm_free(&comm_);
+  }
+#endif
+} // ~RankLogAggregator(...)
+
+int RankLogAggregator::rank() const
+{
+  return rank_;
+}
+
+int RankLogAggregator::size() const
+{
+  return size_;
+}
+
+void RankLogAggregator::add(std::string&& lines)
+{
+  if (lines.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the time is taken under the lock, so that the entries are ordered
+    entries_.push_back({elapsed(), rank_, std::move(lines)});
+    if (finished_) {
+      write_local();
+      return;
+    }
+  }
+  if (size_ == 1 || elapsed() >= next_progress_.load(std::memory_order_relaxed))
+    progress(false);
+} // ... add(...)
+
+void RankLogAggregator::flush()
+{
+  progress(true);
+}
+
+void RankLogAggregator::finish()
+{
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  if (finished_)
+    return;
+#if HAVE_MPI
+  if (communicate_ && rank_ != 0) {
+    if (request_ != MPI_REQUEST_NULL)
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    send(true);
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  }
+#endif
+  if (rank_ == 0) {
+    collect(true);
+    write_pending(std::numeric_limits<double>::infinity());
+  }
+  std::lock_guard<std::mutex> entries_lock(mutex_);
+  finished_ = true;
+  // whatever was added after sending
+  write_local();
+#if HAVE_MPI
+  if (comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&comm_);
+  communicate_ = false;
+#endif
+} // ... finish(...)
+
+double RankLogAggregator::elapsed() const
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+bool RankLogAggregator::may_communicate() const
+{
+  return size_ == 1 || thread_multiple_ || std::this_thread::get_id() == owner_;
+}
+
+void RankLogAggregator::progress(const bool force)
+{
+  if (!may_communicate())
+    return;
+  std::unique_lock<std::mutex> lock(progress_mutex_, std::defer_lock);
+  if (force)
+    lock.lock();
+  else if (!lock.try_lock())
+    return; // someone else is at it
+  if (finished_)
+    return;
+  const double now = elapsed();
+  if (!force && size_ > 1 && now < next_progress_.load(std::memory_order_relaxed))
+    return;
+  next_progress_.store(now + send_interval_, std::memory_order_relaxed);
+  if (rank_ == 0) {
+    collect(false);
+    const double sent_by_all = *std::min_element(sent_until_.begin(), sent_until_.end());
+    write_pending(std::max(sent_by_all, now - max_delay_));
+  } else {
+#if HAVE_MPI
+    if (request_ != MPI_REQUEST_NULL) {
+      int done = 0;
+      MPI_Test(&request_, &done, MPI_STATUS_IGNORE);
+      if (!done)
+        return; // we try again next time
+    }
+    send(false);
+#endif
+  }
+} // ... progress(...)
+
+void RankLogAggregator::collect(const bool wait_for_all)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sent_until_[0] = wait_for_all ? std::numeric_limits<double>::infinity() : elapsed();
+    std::move(entries_.begin(), entries_.end(), std::back_inserter(pending_));
+    entries_.clear();
+  }
+#if HAVE_MPI
+  if (!communicate_)
+    return;
+  const auto all_finished = [&]() {
+    return std::all_of(sent_until_.begin(), sent_until_.end(), [](const double& sent_until) {
+      return sent_until == std::numeric_limits<double>::infinity();
+    });
+  };
+  while (true) {
+    MPI_Status status;
+    if (wait_for_all) {
+      if (all_finished())
+        break;
+      MPI_Probe(MPI_ANY_SOURCE, 0, comm_, &status);
+    } else {
+      int available = 0;
+      MPI_Iprobe(MPI_ANY_SOURCE, 0, comm_, &available, &status);
+      if (!available)
+        break;
+    }
+    int count = 0;
+    MPI_Get_count(&status, MPI_BYTE, &count);
+    buffer_.resize(count);
+    MPI_Recv(&buffer_[0], count, MPI_BYTE, status.MPI_SOURCE, 0, comm_, MPI_STATUS_IGNORE);
+    size_t pos = 0;
+    const auto sent_until = read_raw<double>(buffer_, pos);
+    const auto final = read_raw<std::uint8_t>(buffer_, pos);
+    while (pos < buffer_.size()) {
+      const auto time = read_raw<double>(buffer_, pos);
+      const auto size = read_raw<std::uint32_t>(buffer_, pos);
+      pending_.push_back({time, status.MPI_SOURCE, buffer_.substr(pos, size)});
+      pos += size;
+    }
+    sent_until_[status.MPI_SOURCE] = final ? std::numeric_limits<double>::infinity() : sent_until;
+  }
+#else
+  DUNE_UNUSED_PARAMETER(wait_for_all);
+#endif
+} // ... collect(...)
+
+void RankLogAggregator::write_pending(const double until)
+{
+  using internal::RankLogEntry;
+  std::stable_sort(pending_.begin(), pending_.end(), [](const RankLogEntry& a, const RankLogEntry& b) {
+    return a.time < b.time || (a.time == b.time && a.rank < b.rank);
+  });
+  const auto ready_end = std::find_if(
+      pending_.begin(), pending_.end(), [&](const RankLogEntry& entry) { return entry.time > until; });
+  if (ready_end == pending_.begin())
+    return;
+  const std::vector<RankLogEntry> ready(std::make_move_iterator(pending_.begin()), std::make_move_iterator(ready_end));
+  pending_.erase(pending_.begin(), ready_end);
+  const auto text = internal::format_rank_log_entries(ready);
+  for (auto* out : outs_) {
+    out->write(text.data(), static_cast<std::streamsize>(text.size()));
+    out->flush();
+  }
+} // ... write_pending(...)
+
+void RankLogAggregator::send(const bool final)
+{
+#if HAVE_MPI
+  buffer_.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    append_raw(buffer_, elapsed());
+    append_raw(buffer_, static_cast<std::uint8_t>(final));
+    for (const auto& entry : entries_) {
+      append_raw(buffer_, entry.time);
+      append_raw(buffer_, static_cast<std::uint32_t>(entry.lines.size()));
+      buffer_ += entry.lines;
+    }
+    entries_.clear();
+  }
+  MPI_Isend(&buffer_[0], static_cast<int>(buffer_.size()), MPI_BYTE, 0, 0, comm_, &request_);
+#else
+  DUNE_UNUSED_PARAMETER(final);
+#endif
+} // ... send(...)
+
+void RankLogAggregator::write_local()
+{
+  if (entries_.empty())
+    return;
+  const auto text = internal::format_rank_log_entries(entries_);
+  entries_.clear();
+  for (auto* out : outs_) {
+    out->write(text.data(), static_cast<std::streamsize>(text.size()));
+    out->flush();
+  }
+} // ... write_local(...)
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
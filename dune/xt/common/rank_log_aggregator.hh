@@ -0,0 +1,170 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_RANK_LOG_AGGREGATOR_HH
+#define DUNE_XT_COMMON_RANK_LOG_AGGREGATOR_HH
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#if HAVE_MPI
+#  include <mpi.h>
+#endif
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+
+
+//! lines logged by one rank at one time
+struct RankLogEntry
+{
+  double time;
+  int rank;
+  std::string lines;
+};
+
+
+//! "0-3,5,7-8"
+std::string format_rank_ranges(const std::vector<int>& ranks);
+
+
+/**
+ * \brief The lines of the entries, each line tagged with the time and the ranks which logged it.
+ *
+ *        Identical lines of different ranks are only written once (at the time they were logged first), tagged with
+ *        all these ranks: the n-th occurrence of a line on each rank is merged. The entries have to be sorted by time.
+ */
+std::string format_rank_log_entries(const std::vector<RankLogEntry>& entries);
+
+
+} // namespace internal
+
+
+/**
+ * \brief Collects the log lines of all ranks on rank 0, which writes them to one output.
+ *
+ *        Each rank appends complete lines (without any communication) to a local buffer, which is sent to rank 0 with
+ *        a nonblocking send at most every send_interval seconds. Rank 0 merges the lines of all ranks by time and
+ *        writes them tagged with the ranks which logged them, identical lines of several ranks are written only once:
+\code
+[    0.012s|r0-127] starting the assembly
+[    1.530s|r17] warning: negative jacobian determinant in element 42
+[    2.001s|r0-16,18-127] assembly done
+\endcode
+ *        The lines of a rank are written once all other ranks have sent everything up to the same time (to keep the
+ *        order), but after max_delay seconds at the latest. Sending and receiving only happens in add() and flush()
+ *        (i.e., whenever something is logged), at the end finish() has to be called collectively on all ranks.
+ * \note  Unless MPI provides MPI_THREAD_MULTIPLE, only the thread which created the aggregator communicates, lines
+ *        logged by other threads are sent along the next time it logs.
+ * \note  The times of the ranks are relative to the (collective) construction, so they are only as synchronous as
+ *        the clocks of the nodes.
+ * \sa    Logging::enable_rank_aggregation
+ */
+class RankLogAggregator
+{
+public:
+  using CommunicatorType = MPIHelper::MPICommunicator;
+
+  /**
+   * \brief Collective on comm.
+   * \param outs the streams rank 0 writes to (which have to outlive the aggregator), unused on all other ranks
+   */
+  RankLogAggregator(std::vector<std::ostream*> outs,
+                    CommunicatorType comm = MPIHelper::getCommunicator(),
+                    const double send_interval = 1.,
+                    const double max_delay = 10.);
+
+  /**
+   * \brief Writes all lines which have not been sent or written locally, if finish() was not called.
+   * \note  Not collective, so this is safe to happen after MPI_Finalize (e.g., for the global Logger()).
+   */
+  ~RankLogAggregator();
+
+  int rank() const;
+
+  int size() const;
+
+  //! queues complete lines to be sent to rank 0, communicates if send_interval has passed
+  void add(std::string&& lines);
+
+  //! sends the lines of this rank (on rank 0: writes everything which is ready), regardless of send_interval
+  void flush();
+
+  /**
+   * \brief Collective, sends all remaining lines to rank 0, which writes everything.
+   *
+   *        Lines added afterwards are written directly on each rank.
+   */
+  void finish();
+
+private:
+  RankLogAggregator(const RankLogAggregator&) = delete;
+  RankLogAggregator& operator=(const RankLogAggregator&) = delete;
+
+  double elapsed() const;
+
+  //! whether the calling thread may communicate
+  bool may_communicate() const;
+
+  void progress(const bool force);
+
+  //! rank 0: moves the own entries to the pending ones and receives what has been sent (blocking until all ranks have
+  //! finished if wait_for_all)
+  void collect(const bool wait_for_all);
+
+  //! rank 0: writes all pending lines logged up to the given time
+  void write_pending(const double until);
+
+  //! all other ranks: sends the own entries (the previous send has to be completed)
+  void send(const bool final);
+
+  //! writes the own entries directly (without any communication), mutex_ has to be locked
+  void write_local();
+
+  std::vector<std::ostream*> outs_;
+  const double send_interval_;
+  const double max_delay_;
+  int rank_;
+  int size_;
+  //! false without MPI, for a single rank and after finish(), guarded by progress_mutex_
+  bool communicate_;
+  bool thread_multiple_;
+  const std::thread::id owner_;
+  std::chrono::steady_clock::time_point start_;
+  //! elapsed() at which the next send (or receive on rank 0) is due
+  std::atomic<double> next_progress_;
+  std::atomic<bool> finished_;
+  //! guards entries_
+  std::mutex mutex_;
+  std::vector<internal::RankLogEntry> entries_;
+  //! guards everything below (and the communication)
+  std::mutex progress_mutex_;
+  //! rank 0: the received entries which have not been written yet, and up to which time each rank has sent
+  std::vector<internal::RankLogEntry> pending_;
+  std::vector<double> sent_until_;
+  std::string buffer_;
+#if HAVE_MPI
+  MPI_Comm comm_;
+  MPI_Request request_;
+#endif
+}; // class RankLogAggregator
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_RANK_LOG_AGGREGATOR_HH
@@ -0,0 +1,434 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <fstream>
+#include <iostream>
+
+#include <boost/format.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/unused.hh>
+
+#if HAVE_ZLIB
+#  include <zlib.h>
+#endif
+#if HAVE_ZSTD
+#  include <zstd.h>
+#endif
+
+#include "exceptions.hh"
+#include "filesystem.hh"
+#include "rotating_log_file.hh"
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace internal {
+namespace {
+
+
+class PlainLogFileSink : public LogFileSink
+{
+public:
+  explicit PlainLogFileSink(const std::string& filename)
+    : file_(filename, std::ios::binary | std::ios::trunc)
+  {
+    if (!file_.is_open())
+      DUNE_THROW(Dune::IOError, "Could not open '" << filename << "' for writing!");
+  }
+
+  virtual void write(const char* data, const size_t size) override final
+  {
+    file_.write(data, static_cast<std::streamsize>(size));
+  }
+
+  virtual void flush() override final
+  {
+    file_.flush();
+  }
+
+private:
+  std::ofstream file_;
+}; // class PlainLogFileSink
+
+
+#if HAVE_ZLIB
+
+
+class GzipLogFileSink : public LogFileSink
+{
+public:
+  explicit GzipLogFileSink(const std::string& filename)
+    : file_(filename, std::ios::binary | std::ios::trunc)
+    , out_(1 << 16)
+  {
+    if (!file_.is_open())
+      DUNE_THROW(Dune::IOError, "Could not open '" << filename << "' for writing!");
+    stream_.zalloc = Z_NULL;
+    stream_.zfree = Z_NULL;
+    stream_.opaque = Z_NULL;
+    // 15 + 16: the default window with a gzip header, so that the files can be read by gunzip and zcat
+    if (deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      DUNE_THROW(Dune::IOError, "Could not initialize the compression of '" << filename << "'!");
+  }
+
+  virtual ~GzipLogFileSink()
+  {
+    deflate(nullptr, 0, Z_FINISH);
+    deflateEnd(&stream_);
+  }
+
+  virtual void write(const char* data, const size_t size) override final
+  {
+    deflate(data, size, Z_NO_FLUSH);
+  }
+
+  virtual void flush() override final
+  {
+    deflate(nullptr, 0, Z_SYNC_FLUSH);
+    file_.flush();
+  }
+
+private:
+  void deflate(const char* data, const size_t size, const int mode)
+  {
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream_.avail_in = static_cast<uInt>(size);
+    do {
+      stream_.next_out = out_.data();
+      stream_.avail_out = static_cast<uInt>(out_.size());
+      ::deflate(&stream_, mode);
+      file_.write(reinterpret_cast<const char*>(out_.data()),
+                  static_cast<std::streamsize>(out_.size() - stream_.avail_out));
+    } while (stream_.avail_out == 0);
+  } // ... deflate(...)
+
+  std::ofstream file_;
+  std::vector<Bytef> out_;
+  z_stream stream_;
+}; // class GzipLogFileSink
+
+
+#endif // HAVE_ZLIB
+#if HAVE_ZSTD
+
+
+class ZstdLogFileSink : public LogFileSink
+{
+public:
+  explicit ZstdLogFileSink(const std::string& filename)
+    : file_(filename, std::ios::binary | std::ios::trunc)
+    , out_(ZSTD_CStreamOutSize())
+    , stream_(ZSTD_createCStream())
+  {
+    if (!file_.is_open())
+      DUNE_THROW(Dune::IOError, "Could not open '" << filename << "' for writing!");
+    if (!stream_ || ZSTD_isError(ZSTD_initCStream(stream_, 3))) {
+      ZSTD_freeCStream(stream_);
+      DUNE_THROW(Dune::IOError, "Could not initialize the compression of '" << filename << "'!");
+    }
+  }
+
+  virtual ~ZstdLogFileSink()
+  {
+    finish(ZSTD_endStream);
+    ZSTD_freeCStream(stream_);
+  }
+
+  virtual void write(const char* data, const size_t size) override final
+  {
+    ZSTD_inBuffer in{data, size, 0};
+    while (in.pos < in.size) {
+      ZSTD_outBuffer out{out_.data(), out_.size(), 0};
+      if (ZSTD_isError(ZSTD_compressStream(stream_, &out, &in)))
+        return;
+      file_.write(out_.data(), static_cast<std::streamsize>(out.pos));
+    }
+  }
+
+  virtual void flush() override final
+  {
+    finish(ZSTD_flushStream);
+    file_.flush();
+  }
+
+private:
+  //! calls ZSTD_flushStream or ZSTD_endStream until they are done
+  template <class F>
+  void finish(F&& function)
+  {
+    size_t remaining = 1;
+    while (remaining > 0) {
+      ZSTD_outBuffer out{out_.data(), out_.size(), 0};
+      remaining = function(stream_, &out);
+      if (ZSTD_isError(remaining))
+        return;
+      file_.write(out_.data(), static_cast<std::streamsize>(out.pos));
+    }
+  }
+
+  std::ofstream file_;
+  std::vector<char> out_;
+  ZSTD_CStream* stream_;
+}; // class ZstdLogFileSink
+
+
+#endif // HAVE_ZSTD
+
+
+LogCompression resolve(const LogCompression compression)
+{
+  return compression == LogCompression::best_available ? best_available_log_compression() : compression;
+}
+
+std::string compression_extension(const LogCompression compression)
+{
+  switch (compression) {
+    case LogCompression::gzip:
+      return ".gz";
+    case LogCompression::zstd:
+      return ".zst";
+    default:
+      return "";
+  }
+}
+
+std::unique_ptr<LogFileSink> make_sink(const std::string& filename, const LogCompression compression)
+{
+#if HAVE_ZSTD
+  if (compression == LogCompression::zstd)
+    return std::unique_ptr<LogFileSink>(new ZstdLogFileSink(filename));
+#endif
+#if HAVE_ZLIB
+  if (compression == LogCompression::gzip)
+    return std::unique_ptr<LogFileSink>(new GzipLogFileSink(filename));
+#endif
+  DXT_ASSERT(compression == LogCompression::none);
+  return std::unique_ptr<LogFileSink>(new PlainLogFileSink(filename));
+}
+
+
+} // namespace
+
+
+RotatingLogFileBuffer::RotatingLogFileBuffer(const std::string& filename, const LogRotation& rotation)
+  : rotation_({rotation.max_bytes, rotation.max_seconds, rotation.max_files, resolve(rotation.compression)})
+  , flush_interval_(500)
+  , queued_bytes_(0)
+  , write_out_requests_(0)
+  , written_out_(0)
+  , file_index_(0)
+  , stop_(false)
+  , file_bytes_(0)
+{
+  if (!log_compression_available(rotation_.compression))
+    DUNE_THROW(Dune::NotImplemented, "The requested log compression is not available in this build!");
+  const boost::filesystem::path path(filename);
+  prefix_ = (path.parent_path() / path.stem()).string();
+  suffix_ = path.extension().string() + compression_extension(rotation_.compression);
+  test_create_directory(filename);
+  current_.reserve(chunk_size);
+  // no put area, every write has to go through xsputn() or overflow()
+  setp(nullptr, nullptr);
+  thread_ = std::thread([this]() { run(); });
+} // RotatingLogFileBuffer(...)
+
+RotatingLogFileBuffer::~RotatingLogFileBuffer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void RotatingLogFileBuffer::write_out()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  const size_t request = ++write_out_requests_;
+  wake_.notify_one();
+  progress_.wait(lock, [&]() { return written_out_ >= request; });
+}
+
+std::string RotatingLogFileBuffer::current_filename() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return filename(file_index_);
+}
+
+std::streamsize RotatingLogFileBuffer::xsputn(const char_type* s, std::streamsize count)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  current_.append(s, static_cast<size_t>(count));
+  if (current_.size() >= chunk_size)
+    hand_over(lock);
+  return count;
+}
+
+RotatingLogFileBuffer::int_type RotatingLogFileBuffer::overflow(int_type ch)
+{
+  if (traits_type::eq_int_type(ch, traits_type::eof()))
+    return traits_type::not_eof(ch);
+  const char_type character = traits_type::to_char_type(ch);
+  xsputn(&character, 1);
+  return ch;
+}
+
+void RotatingLogFileBuffer::hand_over(std::unique_lock<std::mutex>& lock)
+{
+  progress_.wait(lock, [&]() { return queued_bytes_ < max_queued_bytes; });
+  queue_current();
+}
+
+void RotatingLogFileBuffer::queue_current()
+{
+  queued_bytes_ += current_.size();
+  queue_.push_back(std::move(current_));
+  current_.clear();
+  if (!unused_.empty()) {
+    current_ = std::move(unused_.back());
+    unused_.pop_back();
+  }
+  wake_.notify_one();
+} // ... queue_current(...)
+
+void RotatingLogFileBuffer::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto last_flush = std::chrono::steady_clock::now();
+  bool unflushed = false;
+  while (true) {
+    wake_.wait_for(lock, flush_interval_, [&]() {
+      return stop_ || !queue_.empty() || write_out_requests_ > written_out_;
+    });
+    // this also fetches what is too small to be handed over after some time
+    const size_t requested = write_out_requests_;
+    const bool due =
+        stop_ || requested > written_out_ || std::chrono::steady_clock::now() - last_flush >= flush_interval_;
+    if (due && !current_.empty())
+      queue_current();
+    while (!queue_.empty()) {
+      std::string chunk = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      write_chunk(chunk);
+      unflushed = true;
+      lock.lock();
+      queued_bytes_ -= chunk.size();
+      chunk.clear();
+      if (unused_.size() < 4)
+        unused_.push_back(std::move(chunk));
+      progress_.notify_all();
+    }
+    if (due) {
+      lock.unlock();
+      if (sink_ && unflushed)
+        sink_->flush();
+      unflushed = false;
+      last_flush = std::chrono::steady_clock::now();
+      lock.lock();
+      written_out_ = requested;
+      progress_.notify_all();
+    }
+    if (stop_ && queue_.empty() && current_.empty())
+      break;
+  }
+  lock.unlock();
+  sink_.reset();
+} // ... run(...)
+
+void RotatingLogFileBuffer::write_chunk(const std::string& chunk)
+{
+  if (!sink_) {
+    std::string name;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      name = filename(file_index_);
+    }
+    try {
+      sink_ = make_sink(name, rotation_.compression);
+    } catch (Dune::Exception& e) {
+      // there is no one to throw to, dropping the log is better than terminating
+      std::cerr << e.what() << std::endl;
+      return;
+    }
+    file_bytes_ = 0;
+    file_opened_ = std::chrono::steady_clock::now();
+    files_.push_back(name);
+    while (rotation_.max_files > 0 && files_.size() > rotation_.max_files) {
+      boost::system::error_code ignored;
+      boost::filesystem::remove(files_.front(), ignored);
+      files_.pop_front();
+    }
+  }
+  sink_->write(chunk.data(), chunk.size());
+  file_bytes_ += chunk.size();
+  if (chunk.empty() || chunk.back() != '\n')
+    return;
+  const double age = std::chrono::duration<double>(std::chrono::steady_clock::now() - file_opened_).count();
+  if ((rotation_.max_bytes > 0 && file_bytes_ >= rotation_.max_bytes)
+      || (rotation_.max_seconds > 0 && age >= rotation_.max_seconds)) {
+    // the next file is only opened once there is something to write to it
+    sink_.reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++file_index_;
+  }
+} // ... write_chunk(...)
+
+std::string RotatingLogFileBuffer::filename(const size_t index) const
+{
+  return prefix_ + (boost::format(".%04d") % index).str() + suffix_;
+}
+
+
+} // namespace internal
+
+
+bool log_compression_available(const LogCompression compression)
+{
+  switch (compression) {
+    case LogCompression::gzip:
+      return HAVE_ZLIB;
+    case LogCompression::zstd:
+      return HAVE_ZSTD;
+    default:
+      return true;
+  }
+}
+
+LogCompression best_available_log_compression()
+{
+  if (HAVE_ZSTD)
+    return LogCompression::zstd;
+  if (HAVE_ZLIB)
+    return LogCompression::gzip;
+  return LogCompression::none;
+}
+
+
+RotatingLogFile::RotatingLogFile(const std::string& filename, const LogRotation& rotation)
+  : StorageBaseType(new internal::RotatingLogFileBuffer(filename, rotation))
+  , std::ostream(&this->access())
+{}
+
+void RotatingLogFile::write_out()
+{
+  this->access().write_out();
+}
+
+std::string RotatingLogFile::current_filename() const
+{
+  return this->access().current_filename();
+}
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
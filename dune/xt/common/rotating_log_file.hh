@@ -0,0 +1,180 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_ROTATING_LOG_FILE_HH
+#define DUNE_XT_COMMON_ROTATING_LOG_FILE_HH
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/common/memory.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+
+
+enum class LogCompression
+{
+  none,
+  //! gzip (requires zlib)
+  gzip,
+  //! zstd (requires libzstd)
+  zstd,
+  //! zstd or gzip, if available, none otherwise
+  best_available
+};
+
+//! whether the compression is available in this build (best_available and none always are)
+bool log_compression_available(const LogCompression compression);
+
+//! zstd or gzip, if available, none otherwise
+LogCompression best_available_log_compression();
+
+
+struct LogRotation
+{
+  //! start a new file once the current one contains this many (uncompressed) bytes, 0 for no limit
+  size_t max_bytes = 0;
+  //! start a new file once the current one is this many seconds old, 0 for no limit
+  double max_seconds = 0;
+  //! remove the oldest files, if there are more, 0 to keep all
+  size_t max_files = 0;
+  LogCompression compression = LogCompression::none;
+};
+
+
+namespace internal {
+
+
+//! where the background thread of a RotatingLogFileBuffer writes to, \sa rotating_log_file.cc
+class LogFileSink
+{
+public:
+  virtual ~LogFileSink() = default;
+
+  virtual void write(const char* data, const size_t size) = 0;
+
+  //! makes everything written so far readable from the file
+  virtual void flush() = 0;
+};
+
+
+/**
+ * \brief Collects the output in memory, a background thread compresses and writes it to the current file.
+ *
+ *        There is no put area, each write locks a mutex and appends to the current chunk, which is handed to the
+ *        background thread once it is large enough (and fetched by it every flush_interval otherwise). A new file is
+ *        only started after a chunk ending with a newline, so lines are never split between files.
+ */
+class RotatingLogFileBuffer : public std::streambuf
+{
+public:
+  RotatingLogFileBuffer(const std::string& filename, const LogRotation& rotation);
+
+  //! writes everything and closes the current file
+  virtual ~RotatingLogFileBuffer();
+
+  //! blocks until everything written so far is readable from the file
+  void write_out();
+
+  //! the file which is currently (or will next be) written to
+  std::string current_filename() const;
+
+protected:
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize count) override final;
+
+  virtual int_type overflow(int_type ch = traits_type::eof()) override final;
+
+private:
+  //! the compressed chunk is written after this size
+  static const size_t chunk_size = 1 << 16;
+  //! the writing threads wait, if the background thread falls this far behind
+  static const size_t max_queued_bytes = 1 << 26;
+
+  //! queues current_ once there is room in the queue, lock has to hold mutex_
+  void hand_over(std::unique_lock<std::mutex>& lock);
+
+  //! queues current_ regardless of the queued bytes, mutex_ has to be locked
+  void queue_current();
+
+  void run();
+
+  //! called by the background thread only
+  void write_chunk(const std::string& chunk);
+  std::string filename(const size_t index) const;
+
+  const LogRotation rotation_;
+  const std::chrono::milliseconds flush_interval_;
+  std::string prefix_;
+  std::string suffix_;
+  //! guards everything below
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable progress_;
+  std::string current_;
+  std::deque<std::string> queue_;
+  //! the storage of written chunks, to be reused by current_
+  std::vector<std::string> unused_;
+  size_t queued_bytes_;
+  size_t write_out_requests_;
+  size_t written_out_;
+  size_t file_index_;
+  bool stop_;
+  //! the state of the background thread
+  std::unique_ptr<LogFileSink> sink_;
+  size_t file_bytes_;
+  std::chrono::steady_clock::time_point file_opened_;
+  std::deque<std::string> files_;
+  std::thread thread_;
+}; // class RotatingLogFileBuffer
+
+
+} // namespace internal
+
+
+/**
+ * \brief A log file which is split into several files by size or age and (optionally) compressed.
+ *
+ *        The files are named after the given one with a running number in front of the extension and the extension of
+ *        the compression appended, e.g. "log/run.0000.log.gz", "log/run.0001.log.gz", .... Writing only appends to a
+ *        buffer in memory, the compression and the writing to disk is done by a background thread. Thus, flush() does
+ *        not wait for the file to be written, write_out() does.
+ * \sa    Logging::enable_rotation
+ */
+class RotatingLogFile : private StorageProvider<internal::RotatingLogFileBuffer>, public std::ostream
+{
+  typedef StorageProvider<internal::RotatingLogFileBuffer> StorageBaseType;
+
+public:
+  /**
+   * \param filename the name of the first file is derived from it, the directory has to exist
+   * \throws Dune::NotImplemented if the compression is not available in this build
+   */
+  RotatingLogFile(const std::string& filename, const LogRotation& rotation);
+
+  //! blocks until everything written so far is readable from the file
+  void write_out();
+
+  //! the file which is currently (or will next be) written to
+  std::string current_filename() const;
+}; // class RotatingLogFile
+
+
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_ROTATING_LOG_FILE_HH
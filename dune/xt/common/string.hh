@@ -20,8 +20,11 @@
 #define DUNE_XT_COMMON_STRING_HH
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <ctime>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -29,6 +32,9 @@
 #include <boost/algorithm/string/constants.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
+#if __cplusplus < 201703L
+#include <boost/utility/string_ref.hpp>
+#endif
 #include <dune/xt/common/reenable_warnings.hh>
 
 namespace Dune {
@@ -77,15 +83,33 @@ static constexpr const std::size_t default_to_string_precision = 6u;
  *             ignored if T is a vector or scalar type).
  */
 template <class T>
-static inline T from_string(std::string ss, const size_t size = 0, const size_t cols = 0)
+static inline T from_string(const std::string& ss, const size_t size = 0, const size_t cols = 0)
 {
   return internal::convert_from_string<T>(ss, size, cols);
 }
 
+//! \sa from_string, reads scalars without copying ss
+template <class T>
+static inline T from_string(const char* ss, const size_t size = 0, const size_t cols = 0)
+{
+  return internal::convert_from_chars<T>(ss, ss + std::strlen(ss), size, cols);
+}
+
+#if __cplusplus >= 201703L
+//! \sa from_string, reads scalars without copying ss
+template <class T>
+static inline T from_string(std::string_view ss, const size_t size = 0, const size_t cols = 0)
+{
+  return internal::convert_from_chars<T>(ss.data(), ss.data() + ss.size(), size, cols);
+}
+#endif
+
 
 /**
  * \brief Converts an object to string.
  * \sa    internal::convert_to_string for implementations
+ * \param precision number of significant digits of floating point numbers, pass round_trip_to_string_precision to
+ *                  obtain the shortest representation which reads back exactly
  */
 template <class T>
 static inline std::string to_string(const T& ss, const size_t precision = default_to_string_precision)
@@ -94,6 +118,17 @@ static inline std::string to_string(const T& ss, const size_t precision = defaul
 }
 
 
+/**
+ * \brief Appends the string representation of an object to out, numbers are written without temporary strings.
+ * \sa    to_string
+ */
+template <class T>
+static inline void append_to_string(std::string& out, const T& ss, const size_t precision = default_to_string_precision)
+{
+  internal::append_to_string(out, ss, precision);
+}
+
+
 /**
  * \brief Converts each character of a string to lower case using std::tolower.
  * \note  This might not do what you expect, given your locale.
@@ -137,30 +172,196 @@ std::string whitespaceify(const T& t, const char whitespace = ' ')
 } // ... whitespaceify(...)
 
 
+//! non-owning reference to a sequence of characters, std::string_view if available
+#if __cplusplus >= 201703L
+typedef std::string_view StringView;
+#else
+typedef boost::string_ref StringView;
+#endif
+
+
+/**
+ * \brief Range over the tokens of a string, which are only determined while iterating.
+ *
+ *        Splits like tokenize(), but neither copies the string nor allocates: the tokens are views into msg, which has
+ *        to outlive the tokenizer.
+ * \sa    lazy_tokenize
+ */
+class Tokenizer
+{
+public:
+  class Iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef StringView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const StringView* pointer;
+    typedef const StringView& reference;
+
+    //! the end iterator
+    Iterator()
+      : tokenizer_(nullptr)
+      , token_begin_(nullptr)
+      , token_end_(nullptr)
+    {}
+
+    explicit Iterator(const Tokenizer& tokenizer)
+      : tokenizer_(&tokenizer)
+      , token_begin_(tokenizer.first_)
+      , token_end_(tokenizer.find_separator(tokenizer.first_))
+      , token_(token_begin_, token_end_ - token_begin_)
+    {}
+
+    reference operator*() const
+    {
+      return token_;
+    }
+
+    pointer operator->() const
+    {
+      return &token_;
+    }
+
+    Iterator& operator++()
+    {
+      if (token_end_ == tokenizer_->last_) {
+        *this = Iterator();
+        return *this;
+      }
+      token_begin_ = token_end_ + 1;
+      if (tokenizer_->compress_)
+        while (token_begin_ != tokenizer_->last_ && tokenizer_->is_separator(*token_begin_))
+          ++token_begin_;
+      token_end_ = tokenizer_->find_separator(token_begin_);
+      token_ = StringView(token_begin_, token_end_ - token_begin_);
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator ret = *this;
+      ++(*this);
+      return ret;
+    }
+
+    bool operator==(const Iterator& other) const
+    {
+      return tokenizer_ == other.tokenizer_ && token_begin_ == other.token_begin_ && token_end_ == other.token_end_;
+    }
+
+    bool operator!=(const Iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    const Tokenizer* tokenizer_;
+    const char* token_begin_;
+    const char* token_end_;
+    StringView token_;
+  }; // class Iterator
+
+  Tokenizer(const StringView msg,
+            const StringView separators,
+            const boost::algorithm::token_compress_mode_type mode = boost::algorithm::token_compress_off)
+    : first_(msg.data())
+    , last_(msg.data() + msg.size())
+    , compress_(mode == boost::algorithm::token_compress_on)
+    , single_separator_(separators.size() == 1 ? separators[0] : '\0')
+    , use_single_separator_(separators.size() == 1)
+  {
+    is_separator_.fill(false);
+    for (const char separator : separators)
+      is_separator_[static_cast<unsigned char>(separator)] = true;
+  }
+
+  Iterator begin() const
+  {
+    return Iterator(*this);
+  }
+
+  Iterator end() const
+  {
+    return Iterator();
+  }
+
+private:
+  bool is_separator(const char cc) const
+  {
+    return is_separator_[static_cast<unsigned char>(cc)];
+  }
+
+  const char* find_separator(const char* first) const
+  {
+    if (first == last_)
+      return last_;
+    if (use_single_separator_) {
+      const auto* found = static_cast<const char*>(std::memchr(first, single_separator_, last_ - first));
+      return found ? found : last_;
+    }
+    while (first != last_ && !is_separator(*first))
+      ++first;
+    return first;
+  }
+
+  const char* first_;
+  const char* last_;
+  bool compress_;
+  char single_separator_;
+  bool use_single_separator_;
+  std::array<bool, 256> is_separator_;
+}; // class Tokenizer
+
+
+/**
+ * \brief Splits msg like tokenize() does, but lazily and without allocating.
+ * \note  msg has to outlive the returned range (in particular, do not pass a temporary std::string).
+ * \code
+for (const auto& line : lazy_tokenize(text, "\n"))
+  std::cout << line << std::endl;
+\endcode
+ */
+inline Tokenizer
+lazy_tokenize(const StringView msg,
+              const StringView separators,
+              const boost::algorithm::token_compress_mode_type mode = boost::algorithm::token_compress_off)
+{
+  return Tokenizer(msg, separators, mode);
+}
+
+
+/**
+ * \brief Splits msg like tokenize() does and converts the tokens directly into ret (which is cleared before).
+ *
+ *        Empty tokens are stored as T(), only the container itself allocates (which it does not, if it already has
+ *        enough capacity), since scalar tokens are converted in place.
+ * \return the number of tokens
+ */
+template <class T, class ContainerType>
+inline size_t
+tokenize_into(const StringView msg,
+              const StringView separators,
+              ContainerType& ret,
+              const boost::algorithm::token_compress_mode_type mode = boost::algorithm::token_compress_off)
+{
+  ret.clear();
+  for (const auto& token : lazy_tokenize(msg, separators, mode))
+    ret.push_back(token.empty() ? T() : internal::convert_from_chars<T>(token.data(), token.data() + token.size()));
+  return ret.size();
+} // ... tokenize_into(...)
+
+
 template <class T>
 inline std::vector<T>
 tokenize(const std::string& msg, const std::string& separators, const boost::algorithm::token_compress_mode_type mode)
 {
-  std::vector<std::string> strings;
-  boost::algorithm::split(strings, msg, boost::algorithm::is_any_of(separators), mode);
-  std::vector<T> ret(strings.size());
-  size_t i = 0;
-  // special case for empty strings to avoid non-default init
-  std::generate(
-      std::begin(ret), std::end(ret), [&]() { return strings[i++].empty() ? T() : from_string<T>(strings[i - 1]); });
+  std::vector<T> ret;
+  tokenize_into<T>(msg, separators, ret, mode);
   return ret;
 } // ... tokenize(...)
 
 
-template <>
-inline std::vector<std::string>
-tokenize(const std::string& msg, const std::string& separators, const boost::algorithm::token_compress_mode_type mode)
-{
-  std::vector<std::string> strings;
-  boost::algorithm::split(strings, msg, boost::algorithm::is_any_of(separators), mode);
-  return strings;
-}
-
 /**
   \brief Removes whitespace from front and back of each string in the vector.
   \param[in]  v Vector of strings to be trimmed
@@ -14,12 +14,37 @@
 #ifndef DUNE_XT_COMMON_STRING_INTERNAL_HH
 #define DUNE_XT_COMMON_STRING_INTERNAL_HH
 
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <cmath>
+#include <complex>
 #include <iomanip>
+#include <limits>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 #include <string>
 
+#if __cplusplus >= 201703L
+#include <string_view>
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+#endif
+
+#if !defined(__cpp_lib_to_chars)
+#include <locale.h>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#endif
+
 #include <dune/xt/common/disable_warnings.hh>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
@@ -47,9 +72,15 @@ tokenize(const std::string& msg,
          const boost::algorithm::token_compress_mode_type mode = boost::algorithm::token_compress_off);
 #endif // DUNE_XT_COMMON_STRING_HH
 
+/**
+ * \brief Pass as precision to to_string to obtain the shortest representation of a floating point number which reads
+ *        back to the same value.
+ */
+static constexpr const std::size_t round_trip_to_string_precision = std::numeric_limits<std::size_t>::max();
+
 namespace internal {
 
-static inline std::string trim_copy_safely(std::string str_in)
+static inline std::string trim_copy_safely(const std::string& str_in)
 {
   const std::string str_out = boost::algorithm::trim_copy(str_in);
   if (str_out.find(";") != std::string::npos)
@@ -62,100 +93,266 @@ static inline std::string trim_copy_safely(std::string str_in)
 } // ... trim_copy_safely(...)
 
 template <class T>
-static inline T convert_safely(std::string ss)
+static inline T convert_safely(const char* first, const char* last)
 {
   try {
-    return boost::lexical_cast<T, std::string>(ss);
+    return boost::lexical_cast<T>(first, static_cast<std::size_t>(last - first));
   } catch (boost::bad_lexical_cast& e) {
     DUNE_THROW(Exceptions::conversion_error,
-               "Error in boost while converting the string '" << ss << "' to type '" << Typename<T>::value() << "':\n"
+               "Error in boost while converting the string '" << std::string(first, last) << "' to type '"
+                                                              << Typename<T>::value() << "':\n"
                                                               << e.what());
   } catch (std::exception& e) {
     DUNE_THROW(Exceptions::conversion_error,
-               "Error in the stl while converting the string '" << ss << "' to type '" << Typename<T>::value() << "':\n"
+               "Error in the stl while converting the string '" << std::string(first, last) << "' to type '"
+                                                                << Typename<T>::value() << "':\n"
                                                                 << e.what());
   }
   return T();
 } // ... convert_safely(...)
 
+template <class T>
+static inline T convert_safely(const std::string& ss)
+{
+  return convert_safely<T>(ss.data(), ss.data() + ss.size());
+}
+
+static inline bool is_space(const char cc)
+{
+  return cc == ' ' || cc == '\t' || cc == '\n' || cc == '\v' || cc == '\f' || cc == '\r';
+}
+
+/**
+ * \brief Skips leading white space and a leading '+', as std::strto* do.
+ * \return nullptr if the '+' is followed by another sign
+ */
+static inline const char* skip_space_and_plus(const char* first, const char* last)
+{
+  while (first != last && is_space(*first))
+    ++first;
+  if (first != last && *first == '+') {
+    ++first;
+    if (first != last && (*first == '+' || *first == '-'))
+      return nullptr;
+  }
+  return first;
+}
+
+#if defined(__cpp_lib_to_chars)
+
+template <class T>
+static inline typename std::enable_if<std::is_integral<T>::value, std::errc>::type
+parse_number_(const char* first, const char* last, T& value, const char*& end)
+{
+  const auto result = std::from_chars(first, last, value);
+  end = result.ptr;
+  return result.ec;
+}
+
+template <class T>
+static inline typename std::enable_if<std::is_floating_point<T>::value, std::errc>::type
+parse_number_(const char* first, const char* last, T& value, const char*& end)
+{
+  // std::from_chars does not understand the 0x prefix of hexadecimal floats, std::strtod does
+  const bool negative = (first != last && *first == '-');
+  const char* digits = first + negative;
+  if (last - digits > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X') && digits[2] != '-') {
+    const auto result = std::from_chars(digits + 2, last, value, std::chars_format::hex);
+    if (result.ec != std::errc::invalid_argument) {
+      if (negative)
+        value = -value;
+      end = result.ptr;
+      return result.ec;
+    }
+  }
+  const auto result = std::from_chars(first, last, value);
+  end = result.ptr;
+  return result.ec;
+}
+
+#else // defined(__cpp_lib_to_chars)
+
+//! the "C" locale, the std::strto* functions would use the current one (e.g. with ',' as decimal point)
+static inline locale_t c_locale()
+{
+  static const locale_t locale = newlocale(LC_ALL_MASK, "C", locale_t(0));
+  return locale;
+}
+
+static inline long long c_strto(const char* str, char** str_end, long long)
+{
+  return strtoll_l(str, str_end, 10, c_locale());
+}
+
+static inline unsigned long long c_strto(const char* str, char** str_end, unsigned long long)
+{
+  return strtoull_l(str, str_end, 10, c_locale());
+}
+
+static inline float c_strto(const char* str, char** str_end, float)
+{
+  return strtof_l(str, str_end, c_locale());
+}
+
+static inline double c_strto(const char* str, char** str_end, double)
+{
+  return strtod_l(str, str_end, c_locale());
+}
+
+static inline long double c_strto(const char* str, char** str_end, long double)
+{
+  return strtold_l(str, str_end, c_locale());
+}
+
+template <class T>
+static inline std::errc parse_number_(const char* first, const char* last, T& value, const char*& end)
+{
+  using C = typename std::conditional<
+      std::is_floating_point<T>::value,
+      T,
+      typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type>::type;
+  end = first;
+  // std::strtoull silently wraps negative numbers around
+  if (first == last || (std::is_unsigned<T>::value && *first == '-'))
+    return std::errc::invalid_argument;
+  // the std::strto* functions require a null terminated string
+  const std::string str(first, last);
+  char* str_end = nullptr;
+  errno = 0;
+  const C result = c_strto(str.c_str(), &str_end, C());
+  if (str_end == str.c_str())
+    return std::errc::invalid_argument;
+  end = first + (str_end - str.c_str());
+  if (errno == ERANGE || (std::is_integral<T>::value && (result < C(std::numeric_limits<T>::lowest())
+                                                         || result > C(std::numeric_limits<T>::max()))))
+    return std::errc::result_out_of_range;
+  value = static_cast<T>(result);
+  return std::errc();
+}
+
+#endif // defined(__cpp_lib_to_chars)
+
+/**
+ * \brief Reads a number from [first, last), neither allocating nor throwing (if std::from_chars is available).
+ *
+ *        Accepts the same input as the std::sto* family: leading white space and a leading '+' are skipped, parsing
+ *        stops at the first character not belonging to the number. In contrast to the latter, the result does not
+ *        depend on the current locale and unsigned types do not accept negative numbers.
+ * \param end if given, points to the first character not belonging to the number afterwards
+ * \return std::errc() on success, std::errc::invalid_argument or std::errc::result_out_of_range otherwise (value is
+ *         left untouched in both cases)
+ */
+template <class T>
+static inline typename std::enable_if<std::is_arithmetic<T>::value, std::errc>::type
+parse_number(const char* first, const char* last, T& value, const char** end = nullptr)
+{
+  const char* number_end = first;
+  const char* number_begin = skip_space_and_plus(first, last);
+  const auto error = number_begin ? parse_number_(number_begin, last, value, number_end) : std::errc::invalid_argument;
+  if (end)
+    *end = (error == std::errc::invalid_argument) ? first : number_end;
+  return error;
+} // ... parse_number(...)
+
 // unspecialized variant
 template <class T, bool anything = true>
 struct Helper
 {
-  static inline T convert_from_string(std::string ss)
+  static inline T convert_from_string(const char* first, const char* last)
+  {
+    return convert_safely<T>(first, last);
+  }
+
+  static inline T convert_from_string(const std::string& ss)
   {
-    return convert_safely<T>(ss);
+    return convert_from_string(ss.data(), ss.data() + ss.size());
   }
 }; // struct Helper
 
+// variant for std::string, to take the token as is
+template <bool anything>
+struct Helper<std::string, anything>
+{
+  static inline std::string convert_from_string(const char* first, const char* last)
+  {
+    return std::string(first, last);
+  }
+
+  static inline std::string convert_from_string(const std::string& ss)
+  {
+    return ss;
+  }
+}; // struct Helper< std::string, ... >
+
+static inline bool equals_lower_case(const char* first, const char* last, const char* lower_case)
+{
+  for (; first != last; ++first, ++lower_case)
+    if (*lower_case == '\0' || std::tolower(static_cast<unsigned char>(*first)) != *lower_case)
+      return false;
+  return *lower_case == '\0';
+}
+
 // variant for bool, to correctly parse true and false
 template <bool anything>
 struct Helper<bool, anything>
 {
-  static inline bool convert_from_string(std::string ss)
+  static inline bool convert_from_string(const char* first, const char* last)
   {
-    std::string ss_lower_case = ss;
-    std::transform(ss_lower_case.begin(), ss_lower_case.end(), ss_lower_case.begin(), ::tolower);
-    if (ss_lower_case == "true")
+    if (equals_lower_case(first, last, "true"))
       return true;
-    else if (ss_lower_case == "false")
+    else if (equals_lower_case(first, last, "false"))
       return false;
     else
-      return convert_safely<bool>(ss);
+      return convert_safely<bool>(first, last);
+  }
+
+  static inline bool convert_from_string(const std::string& ss)
+  {
+    return convert_from_string(ss.data(), ss.data() + ss.size());
   }
 }; // struct Helper< bool, ... >
 
-// variant for all basic types supported by std::sto*
-#define DUNE_XT_COMMON_STRING_GENERATE_HELPER(tn, tns)                                                                 \
+// variant for all arithmetic types supported by parse_number
+#define DUNE_XT_COMMON_STRING_GENERATE_HELPER(tn)                                                                      \
   template <bool anything>                                                                                             \
   struct Helper<tn, anything>                                                                                          \
   {                                                                                                                    \
-    static inline tn convert_from_string(std::string ss)                                                               \
+    static inline tn convert_from_string(const char* first, const char* last)                                          \
     {                                                                                                                  \
-      try {                                                                                                            \
-        return std::sto##tns(ss);                                                                                      \
-      } catch (const std::exception& ee) {                                                                             \
+      tn ret = 0;                                                                                                      \
+      const auto error = parse_number(first, last, ret);                                                               \
+      if (error != std::errc())                                                                                        \
         DUNE_THROW(Exceptions::conversion_error,                                                                       \
-                   "in stl when converting '" << ss << "' to '" << Typename<tn>::value() << "': " << ee.what());       \
-      }                                                                                                                \
+                   "in stl when converting '" << std::string(first, last) << "' to '" << Typename<tn>::value()         \
+                                              << "': "                                                                 \
+                                              << std::make_error_code(error).message());                               \
+      return ret;                                                                                                      \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline tn convert_from_string(const std::string& ss)                                                        \
+    {                                                                                                                  \
+      return convert_from_string(ss.data(), ss.data() + ss.size());                                                    \
     }                                                                                                                  \
   };
 
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(int, i)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(long, l)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(long long, ll)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(unsigned long, ul)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(unsigned long long, ull)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(float, f)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(double, d)
-DUNE_XT_COMMON_STRING_GENERATE_HELPER(long double, ld)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(int)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(unsigned int)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(long)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(long long)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(unsigned long)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(unsigned long long)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(float)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(double)
+DUNE_XT_COMMON_STRING_GENERATE_HELPER(long double)
 
 #undef DUNE_XT_COMMON_STRING_GENERATE_HELPER
 
-// variant for unsigned int as there is no stoui
-template <bool anything>
-struct Helper<unsigned int, anything>
-{
-  static inline unsigned int convert_from_string(std::string ss)
-  {
-    try {
-      return XT::Common::numeric_cast<unsigned int>(std::stoul(ss));
-    } catch (const XT::Common::Exceptions::external_error& ee) {
-      DUNE_THROW(Exceptions::conversion_error,
-                 "in XT::Common::numeric_cast when converting '" << ss << "' to '" << Typename<unsigned int>::value()
-                                                                 << "': " << ee.what());
-    } catch (const std::exception& ee) {
-      DUNE_THROW(Exceptions::conversion_error,
-                 "in stl when converting '" << ss << "' to '" << Typename<unsigned long>::value()
-                                            << "': " << ee.what());
-    }
-  }
-};
-
 // variant for everything that is not a matrix or a vector or complex value
 template <class T>
 static inline typename std::enable_if<!is_vector<T>::value && !is_matrix<T>::value && !is_complex<T>::value, T>::type
-convert_from_string(std::string ss, const size_t DXTC_DEBUG_ONLY(rows) = 0, const size_t DXTC_DEBUG_ONLY(cols) = 0)
+convert_from_string(const std::string& ss,
+                    const size_t DXTC_DEBUG_ONLY(rows) = 0,
+                    const size_t DXTC_DEBUG_ONLY(cols) = 0)
 {
   DXT_ASSERT(rows == 0);
   DXT_ASSERT(cols == 0);
@@ -184,25 +381,115 @@ convert_from_string(std::string ss, const size_t /*size*/ = 0, const size_t /*co
   return V(re, im);
 }
 
+static inline const char* trim_begin(const char* first, const char* last)
+{
+  while (first != last && is_space(*first))
+    ++first;
+  return first;
+}
+
+static inline const char* trim_end(const char* first, const char* last)
+{
+  while (last != first && is_space(*(last - 1)))
+    --last;
+  return last;
+}
+
+/**
+ * \brief Calls f(token_begin, token_end) for each token of [first, last) separated by (runs of) separator, until f
+ *        returns false.
+ * \note  Yields the same tokens as boost::algorithm::split with token_compress_on, without copying them.
+ */
+template <class F>
+static inline void for_each_token(const char* first, const char* last, const char separator, F&& f)
+{
+  while (true) {
+    const auto* found = static_cast<const char*>(std::memchr(first, separator, static_cast<size_t>(last - first)));
+    const char* token_end = found ? found : last;
+    if (!f(first, token_end) || token_end == last)
+      return;
+    first = token_end + 1;
+    while (first != last && *first == separator)
+      ++first;
+  }
+} // ... for_each_token(...)
+
+static inline size_t count_tokens(const char* first, const char* last, const char separator)
+{
+  size_t count = 0;
+  for_each_token(first, last, separator, [&](const char*, const char*) {
+    ++count;
+    return true;
+  });
+  return count;
+}
+
+template <class S>
+static inline typename std::enable_if<!is_complex<S>::value, S>::type convert_entry_(const char* first,
+                                                                                      const char* last)
+{
+  return Helper<S>::convert_from_string(first, last);
+}
+
+template <class S>
+static inline typename std::enable_if<is_complex<S>::value, S>::type convert_entry_(const char* first,
+                                                                                     const char* last)
+{
+  return convert_from_string<S>(std::string(first, last));
+}
+
+/**
+ * \brief Converts one entry of a vector or matrix expression, reporting its position on failure.
+ */
+template <class S>
+static inline S
+convert_entry(const char* first, const char* last, const std::string& expression, const size_t row, const size_t col)
+{
+  first = trim_begin(first, last);
+  last = trim_end(first, last);
+  if (std::memchr(first, ';', static_cast<size_t>(last - first)))
+    DUNE_THROW(Exceptions::conversion_error,
+               "There was an error while parsing the string below. "
+                   << "The value contained a ';': '" << std::string(first, last) << "'!\n"
+                   << "This usually happens if you try to get a matrix expression with a vector type "
+                   << "or if you are missing the white space after the ';' in a matrix expression!\n"
+                   << "'" << expression << "'");
+  try {
+    return convert_entry_<S>(first, last);
+  } catch (const Exceptions::conversion_error& ee) {
+    DUNE_THROW(Exceptions::conversion_error,
+               "Could not convert entry '" << std::string(first, last) << "' in row " << row << ", column " << col
+                                           << " of the expression below:\n"
+                                           << "'" << expression << "'\n"
+                                           << ee.what());
+  }
+} // ... convert_entry(...)
+
+static inline bool is_bracketed(const std::string& ss)
+{
+  return ss.size() >= 2 && ss.front() == '[' && ss.back() == ']';
+}
+
 template <class VectorType>
 static inline typename std::enable_if<is_vector<VectorType>::value, VectorType>::type
-convert_from_string(std::string ss, const size_t size, const size_t DXTC_DEBUG_ONLY(cols) = 0)
+convert_from_string(const std::string& ss, const size_t size, const size_t DXTC_DEBUG_ONLY(cols) = 0)
 {
-  auto vector_str = ss;
   typedef typename VectorAbstraction<VectorType>::S S;
   DXT_ASSERT(cols == 0);
   // check if this is a vector
-  if (vector_str.substr(0, 1) == "[" && vector_str.substr(vector_str.size() - 1, 1) == "]") {
-    vector_str = vector_str.substr(1, vector_str.size() - 2);
-    // we treat this as a vector and split along ' '
-    const auto tokens = tokenize<std::string>(vector_str, " ", boost::algorithm::token_compress_on);
-    if (size > 0 && tokens.size() < size)
+  if (is_bracketed(ss)) {
+    // we treat this as a vector, the entries are separated by ' '
+    const char* const first = ss.data() + 1;
+    const char* const last = ss.data() + ss.size() - 1;
+    // determine the size first, so that we can allocate once
+    const size_t num_tokens = count_tokens(first, last, ' ');
+    if (size > 0 && num_tokens < size)
       DUNE_THROW(Exceptions::conversion_error,
-                 "Vector expression (see below) has only " << tokens.size() << " elements but " << size
+                 "Vector expression (see below) has only " << num_tokens << " elements but " << size
                                                            << " elements were requested!"
                                                            << "\n"
-                                                           << "'[" << vector_str << "]'");
-    const size_t automatic_size = (size > 0) ? std::min(tokens.size(), size) : tokens.size();
+                                                           << "'" << ss << "'");
+    const size_t automatic_size = (size > 0) ? std::min(num_tokens, size) : num_tokens;
     const size_t actual_size =
         VectorAbstraction<VectorType>::has_static_size ? VectorAbstraction<VectorType>::static_size : automatic_size;
     if (actual_size > automatic_size)
@@ -211,14 +498,20 @@ convert_from_string(std::string ss, const size_t size, const size_t DXTC_DEBUG_O
                                                            << " elements are required for this VectorType ("
                                                            << Typename<VectorType>::value() << ")!"
                                                            << "\n"
-                                                           << "'[" << vector_str << "]'");
+                                                           << "'" << ss << "'");
     VectorType ret = VectorAbstraction<VectorType>::create(actual_size);
-    for (size_t ii = 0; ii < actual_size; ++ii)
-      ret[ii] = convert_from_string<S>(trim_copy_safely(tokens[ii]));
+    size_t ii = 0;
+    for_each_token(first, last, ' ', [&](const char* token_begin, const char* token_end) {
+      if (ii == actual_size)
+        return false;
+      ret[ii] = convert_entry<S>(token_begin, token_end, ss, 0, ii);
+      ++ii;
+      return true;
+    });
     return ret;
   } else {
     // we treat this as a scalar
-    const auto val = convert_from_string<S>(trim_copy_safely(vector_str));
+    const auto val = convert_entry<S>(ss.data(), ss.data() + ss.size(), ss, 0, 0);
     const size_t automatic_size = (size == 0 ? 1 : size);
     const size_t actual_size =
         VectorAbstraction<VectorType>::has_static_size ? VectorAbstraction<VectorType>::static_size : automatic_size;
@@ -228,7 +521,7 @@ convert_from_string(std::string ss, const size_t size, const size_t DXTC_DEBUG_O
                                                            << " elements are required for this VectorType ("
                                                            << Typename<VectorType>::value() << ")!"
                                                            << "\n"
-                                                           << "'[" << vector_str << "]'");
+                                                           << "'[" << ss << "]'");
     VectorType ret = VectorAbstraction<VectorType>::create(actual_size);
     for (size_t ii = 0; ii < std::min(actual_size, ret.size()); ++ii)
       ret[ii] = val;
@@ -238,21 +531,23 @@ convert_from_string(std::string ss, const size_t size, const size_t DXTC_DEBUG_O
 
 template <class MatrixType>
 static inline typename std::enable_if<is_matrix<MatrixType>::value, MatrixType>::type
-convert_from_string(std::string matrix_str, const size_t rows, const size_t cols)
+convert_from_string(const std::string& matrix_str, const size_t rows, const size_t cols)
 {
   typedef typename MatrixAbstraction<MatrixType>::S S;
   // check if this is a matrix
-  if (matrix_str.substr(0, 1) == "[" && matrix_str.substr(matrix_str.size() - 1, 1) == "]") {
-    matrix_str = matrix_str.substr(1, matrix_str.size() - 2);
-    // we treat this as a matrix and split along ';' to obtain the rows
-    const auto row_tokens = tokenize<std::string>(matrix_str, ";", boost::algorithm::token_compress_on);
-    if (rows > 0 && row_tokens.size() < rows)
+  if (is_bracketed(matrix_str)) {
+    // we treat this as a matrix, the rows are separated by ';' and the entries of each row by ' '
+    const char* const first = matrix_str.data() + 1;
+    const char* const last = matrix_str.data() + matrix_str.size() - 1;
+    // determine the dimensions first, so that we can allocate once
+    const size_t num_rows = count_tokens(first, last, ';');
+    if (rows > 0 && num_rows < rows)
       DUNE_THROW(Exceptions::conversion_error,
-                 "Matrix expression (see below) has only " << row_tokens.size() << " rows but " << rows
+                 "Matrix expression (see below) has only " << num_rows << " rows but " << rows
                                                            << " rows were requested!"
                                                            << "\n"
-                                                           << "'[" << matrix_str << "]'");
-    const size_t automatic_rows = (rows > 0) ? std::min(row_tokens.size(), rows) : row_tokens.size();
+                                                           << "'" << matrix_str << "'");
+    const size_t automatic_rows = (rows > 0) ? std::min(num_rows, rows) : num_rows;
     const size_t actual_rows =
         MatrixAbstraction<MatrixType>::has_static_size ? MatrixAbstraction<MatrixType>::static_rows : automatic_rows;
     if (actual_rows > automatic_rows)
@@ -261,21 +556,23 @@ convert_from_string(std::string matrix_str, const size_t rows, const size_t cols
                                                            << " rows are required for this MatrixType ("
                                                            << Typename<MatrixType>::value() << ")!"
                                                            << "\n"
-                                                           << "'[" << matrix_str << "]'");
-    // compute the number of columns the matrix will have
+                                                           << "'" << matrix_str << "'");
+    // the number of columns is the minimum over all rows we use
     size_t min_cols = std::numeric_limits<size_t>::max();
-    for (size_t rr = 0; rr < actual_rows; ++rr) {
-      const auto row_token = boost::algorithm::trim_copy(row_tokens[rr]);
-      // we treat this as a vector, so we split along ' '
-      const auto column_tokens = tokenize<std::string>(row_token, " ", boost::algorithm::token_compress_on);
-      min_cols = std::min(min_cols, column_tokens.size());
-    }
+    size_t rr = 0;
+    for_each_token(first, last, ';', [&](const char* row_begin, const char* row_end) {
+      if (rr++ == actual_rows)
+        return false;
+      row_begin = trim_begin(row_begin, row_end);
+      min_cols = std::min(min_cols, count_tokens(row_begin, trim_end(row_begin, row_end), ' '));
+      return true;
+    });
     if (cols > 0 && min_cols < cols)
       DUNE_THROW(Exceptions::conversion_error,
                  "Matrix expression (see below) has only " << min_cols << " columns but " << cols
                                                            << " columns were requested!"
                                                            << "\n"
-                                                           << "'[" << matrix_str << "]'");
+                                                           << "'" << matrix_str << "'");
     const auto automatic_cols = (cols > 0) ? std::min(min_cols, cols) : min_cols;
     const size_t actual_cols =
         MatrixAbstraction<MatrixType>::has_static_size ? MatrixAbstraction<MatrixType>::static_cols : automatic_cols;
@@ -285,20 +582,30 @@ convert_from_string(std::string matrix_str, const size_t rows, const size_t cols
                                                            << " cols are required for this MatrixType ("
                                                            << Typename<MatrixType>::value() << ")!"
                                                            << "\n"
-                                                           << "'[" << matrix_str << "]'");
+                                                           << "'" << matrix_str << "'");
     MatrixType ret = MatrixAbstraction<MatrixType>::create(actual_rows, actual_cols);
-    // now we do the same again and build the actual matrix
-    for (size_t rr = 0; rr < actual_rows; ++rr) {
-      const std::string row_token = boost::algorithm::trim_copy(row_tokens[rr]);
-      const auto column_tokens = tokenize<std::string>(row_token, " ", boost::algorithm::token_compress_on);
-      for (size_t cc = 0; cc < actual_cols; ++cc)
+    // now we walk through the expression again and write the entries
+    rr = 0;
+    for_each_token(first, last, ';', [&](const char* row_begin, const char* row_end) {
+      if (rr == actual_rows)
+        return false;
+      row_begin = trim_begin(row_begin, row_end);
+      size_t cc = 0;
+      for_each_token(row_begin, trim_end(row_begin, row_end), ' ', [&](const char* entry_begin, const char* entry_end) {
+        if (cc == actual_cols)
+          return false;
         MatrixAbstraction<MatrixType>::set_entry(
-            ret, rr, cc, convert_from_string<S>(trim_copy_safely(column_tokens[cc])));
-    }
+            ret, rr, cc, convert_entry<S>(entry_begin, entry_end, matrix_str, rr, cc));
+        ++cc;
+        return true;
+      });
+      ++rr;
+      return true;
+    });
     return ret;
   } else {
     // we treat this as a scalar
-    const S val = convert_from_string<S>(trim_copy_safely(matrix_str));
+    const S val = convert_entry<S>(matrix_str.data(), matrix_str.data() + matrix_str.size(), matrix_str, 0, 0);
     const size_t automatic_rows = (rows == 0 ? 1 : rows);
     const size_t actual_rows =
         MatrixAbstraction<MatrixType>::has_static_size ? MatrixAbstraction<MatrixType>::static_rows : automatic_rows;
@@ -327,27 +634,182 @@ convert_from_string(std::string matrix_str, const size_t rows, const size_t cols
   }
 } // ... convert_from_string(...)
 
+// variant for character ranges, only scalars are read in place
+template <class T>
+static inline typename std::enable_if<!is_vector<T>::value && !is_matrix<T>::value && !is_complex<T>::value, T>::type
+convert_from_chars(const char* first,
+                   const char* last,
+                   const size_t DXTC_DEBUG_ONLY(rows) = 0,
+                   const size_t DXTC_DEBUG_ONLY(cols) = 0)
+{
+  DXT_ASSERT(rows == 0);
+  DXT_ASSERT(cols == 0);
+  return Helper<T>::convert_from_string(first, last);
+}
+
+template <class T>
+static inline typename std::enable_if<is_vector<T>::value || is_matrix<T>::value || is_complex<T>::value, T>::type
+convert_from_chars(const char* first, const char* last, const size_t rows = 0, const size_t cols = 0)
+{
+  return convert_from_string<T>(std::string(first, last), rows, cols);
+}
+
+// types written by format_number, all others go through an std::ostream
+template <class T>
+struct formats_as_number
+  : public std::integral_constant<bool,
+                                  std::is_floating_point<T>::value
+                                      || (std::is_integral<T>::value && !std::is_same<T, bool>::value
+                                          && sizeof(T) > 1
+                                          && !std::is_same<T, wchar_t>::value
+                                          && !std::is_same<T, char16_t>::value
+                                          && !std::is_same<T, char32_t>::value)>
+{};
+
+/**
+ * \brief Number of characters format_number may write at most.
+ */
+template <class T>
+static inline std::size_t max_formatted_size(const std::size_t precision)
+{
+  if (std::is_integral<T>::value)
+    return std::numeric_limits<T>::digits10 + 3;
+  // sign, digits, point and either the zeros of 0.0001 or the exponent
+  return (precision == round_trip_to_string_precision ? std::numeric_limits<T>::max_digits10 : precision) + 16;
+}
+
+#if defined(__cpp_lib_to_chars)
+
+template <class T>
+static inline typename std::enable_if<std::is_integral<T>::value, char*>::type
+format_number_(char* first, char* last, const T& value, const std::size_t /*precision*/)
+{
+  return std::to_chars(first, last, value).ptr;
+}
+
+template <class T>
+static inline typename std::enable_if<std::is_floating_point<T>::value, char*>::type
+format_number_(char* first, char* last, const T& value, const std::size_t precision)
+{
+  if (precision == round_trip_to_string_precision)
+    return std::to_chars(first, last, value).ptr;
+  return std::to_chars(first, last, value, std::chars_format::general, static_cast<int>(precision)).ptr;
+}
+
+#else // defined(__cpp_lib_to_chars)
+
+static inline int c_format(char* first, char* last, long long value, const int /*precision*/)
+{
+  return std::snprintf(first, last - first, "%lld", value);
+}
+
+static inline int c_format(char* first, char* last, unsigned long long value, const int /*precision*/)
+{
+  return std::snprintf(first, last - first, "%llu", value);
+}
+
+static inline int c_format(char* first, char* last, double value, const int precision)
+{
+  return std::snprintf(first, last - first, "%.*g", precision, value);
+}
+
+static inline int c_format(char* first, char* last, long double value, const int precision)
+{
+  return std::snprintf(first, last - first, "%.*Lg", precision, value);
+}
+
+template <class T>
+static inline char* format_number_(char* first, char* last, const T& value, const std::size_t precision)
+{
+  using C = typename std::conditional<
+      std::is_same<T, long double>::value,
+      long double,
+      typename std::conditional<std::is_floating_point<T>::value,
+                                double,
+                                typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::
+                                    type>::type>::type;
+  int written = 0;
+  if (std::is_floating_point<T>::value && precision == round_trip_to_string_precision) {
+    // increase the precision until the value reads back exactly, std::snprintf may write the terminating '\0'
+    for (int digits = std::numeric_limits<T>::digits10; digits <= std::numeric_limits<T>::max_digits10; ++digits) {
+      written = c_format(first, last, C(value), digits);
+      T read_back;
+      if (written < 0 || written >= last - first || parse_number(first, first + written, read_back) != std::errc()
+          || read_back == value || std::isnan(value))
+        break;
+    }
+  } else
+    written = c_format(first, last, C(value), static_cast<int>(precision));
+  return (written < 0 || written >= last - first) ? last : first + written;
+}
+
+#endif // defined(__cpp_lib_to_chars)
+
+/**
+ * \brief Writes value to [first, last) as printf("%.*g") would (or as short as possible while reading back to the same
+ *        value, if precision is round_trip_to_string_precision), without allocating.
+ * \note  [first, last) has to provide room for max_formatted_size<T>(precision) characters.
+ * \return the end of the written characters
+ */
+template <class T>
+static inline typename std::enable_if<formats_as_number<T>::value, char*>::type
+format_number(char* first, char* last, const T& value, const std::size_t precision)
+{
+  return format_number_(first, last, value, precision);
+}
+
 // variant for everything that is not a matrix, a vector or any of the types specified below
 template <class T>
-static inline typename std::enable_if<!is_vector<T>::value && !is_matrix<T>::value, std::string>::type
-convert_to_string(const T& ss, const std::size_t precision)
+static inline
+    typename std::enable_if<!is_vector<T>::value && !is_matrix<T>::value && !formats_as_number<T>::value,
+                            std::string>::type
+    convert_to_string(const T& ss, const std::size_t precision)
 {
   std::ostringstream out;
-  out << std::setprecision(boost::numeric_cast<int>(precision)) << ss;
+  out << std::setprecision(precision == round_trip_to_string_precision
+                               ? std::numeric_limits<long double>::max_digits10
+                               : boost::numeric_cast<int>(precision))
+      << ss;
   return out.str();
 }
 
+template <class T>
+static inline typename std::enable_if<formats_as_number<T>::value>::type
+append_to_string(std::string& out, const T& value, const std::size_t precision)
+{
+  const auto old_size = out.size();
+  out.resize(old_size + max_formatted_size<T>(precision));
+  char* const first = &out[old_size];
+  const char* const end = format_number(first, first + (out.size() - old_size), value, precision);
+  out.resize(old_size + static_cast<std::size_t>(end - first));
+}
+
+template <class T>
+static inline typename std::enable_if<!formats_as_number<T>::value>::type
+append_to_string(std::string& out, const T& value, const std::size_t precision);
+
+// variant for arithmetic types
+template <class T>
+static inline typename std::enable_if<formats_as_number<T>::value, std::string>::type
+convert_to_string(const T& value, const std::size_t precision)
+{
+  std::string ret;
+  append_to_string(ret, value, precision);
+  return ret;
+}
+
 template <typename T>
 static inline std::string convert_to_string(const std::complex<T>& val, const std::size_t precision)
 {
-  using namespace std;
-  stringstream os;
-  const auto im = imag(val);
-  const string sign = signum(im) < 0 ? "" : "+";
-  const auto real_str = convert_to_string(real(val), precision);
-  const auto imag_str = convert_to_string(im, precision);
-  os << real_str << sign << imag_str << "i";
-  return os.str();
+  const auto im = std::imag(val);
+  std::string ret;
+  ret.reserve(2 * max_formatted_size<T>(precision) + 2);
+  append_to_string(ret, std::real(val), precision);
+  if (!(signum(im) < 0))
+    ret += '+';
+  append_to_string(ret, im, precision);
+  ret += 'i';
+  return ret;
 }
 
 template <int size>
@@ -373,22 +835,44 @@ inline std::string convert_to_string(const std::string ss, const std::size_t /*p
   return std::string(ss);
 }
 
-// forward such that vectors of matrices can be converted
+// forward such that vectors of vectors or matrices can be converted
+template <class V>
+static inline typename std::enable_if<is_vector<V>::value, std::string>::type
+convert_to_string(const V& /*vec*/, const std::size_t /*precision*/);
+
 template <class M>
 static inline typename std::enable_if<is_matrix<M>::value, std::string>::type
 convert_to_string(const M& /*mat*/, const std::size_t /*precision*/);
 
+template <class T>
+static inline typename std::enable_if<!formats_as_number<T>::value>::type
+append_to_string(std::string& out, const T& value, const std::size_t precision)
+{
+  out += convert_to_string(value, precision);
+}
+
+// guess of the number of characters an entry will need
+template <class T>
+static inline std::size_t formatted_size_hint(const std::size_t precision)
+{
+  return formats_as_number<T>::value ? std::min(precision, std::size_t(17)) + 6 : 8;
+}
+
 template <class V>
 static inline typename std::enable_if<is_vector<V>::value, std::string>::type
 convert_to_string(const V& vec, const std::size_t precision)
 {
-  std::string ret = "[";
-  for (auto ii : value_range(vec.size())) {
+  using S = typename std::decay<decltype(vec[0])>::type;
+  const auto size = vec.size();
+  std::string ret;
+  ret.reserve(2 + size * (formatted_size_hint<S>(precision) + 1));
+  ret += '[';
+  for (auto ii : value_range(size)) {
     if (ii > 0)
-      ret += " ";
-    ret += convert_to_string(vec[ii], precision);
+      ret += ' ';
+    append_to_string(ret, vec[ii], precision);
   }
-  ret += "]";
+  ret += ']';
   return ret;
 } // ... convert_to_string(...)
 
@@ -396,17 +880,22 @@ template <class M>
 static inline typename std::enable_if<is_matrix<M>::value, std::string>::type
 convert_to_string(const M& mat, const std::size_t precision)
 {
-  std::string ret = "[";
-  for (auto rr : value_range(MatrixAbstraction<M>::rows(mat))) {
+  using S = typename std::decay<decltype(MatrixAbstraction<M>::get_entry(mat, 0, 0))>::type;
+  const auto rows = MatrixAbstraction<M>::rows(mat);
+  const auto cols = MatrixAbstraction<M>::cols(mat);
+  std::string ret;
+  ret.reserve(2 + rows * (cols * (formatted_size_hint<S>(precision) + 1) + 1));
+  ret += '[';
+  for (auto rr : value_range(rows)) {
     if (rr > 0)
       ret += "; ";
-    for (auto cc : value_range(MatrixAbstraction<M>::cols(mat))) {
+    for (auto cc : value_range(cols)) {
       if (cc > 0)
-        ret += " ";
-      ret += convert_to_string(MatrixAbstraction<M>::get_entry(mat, rr, cc), precision);
+        ret += ' ';
+      append_to_string(ret, MatrixAbstraction<M>::get_entry(mat, rr, cc), precision);
     }
   }
-  ret += "]";
+  ret += ']';
   return ret;
 } // ... convert_to_string(...)
 
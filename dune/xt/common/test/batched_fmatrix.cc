@@ -0,0 +1,125 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Needs to come first, include the config.h.
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <dune/xt/common/batched_fmatrix.hh>
+
+using namespace Dune::XT::Common;
+
+
+template <class K, int N, size_t W>
+std::array<Dune::FieldMatrix<K, N, N>, W> random_matrices(std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::array<Dune::FieldMatrix<K, N, N>, W> ret;
+  for (auto& mat : ret) {
+    for (size_t ii = 0; ii < N; ++ii)
+      for (size_t jj = 0; jj < N; ++jj)
+        mat[ii][jj] = K(distribution(generator));
+    // keep them well conditioned
+    for (size_t ii = 0; ii < N; ++ii)
+      mat[ii][ii] += K(N);
+  }
+  // needs pivoting
+  if (N > 1)
+    std::swap(ret[0][0], ret[0][N - 1]);
+  return ret;
+} // ... random_matrices(...)
+
+
+template <class K, int N, size_t W>
+void check_batched_kernels()
+{
+  std::mt19937 generator(N);
+  const auto matrices = random_matrices<K, N, W>(generator);
+  BatchedFieldMatrix<K, N, N, W> batch(matrices);
+  BatchedFieldVector<K, N, W> b(K(1));
+  for (size_t ll = 0; ll < W; ++ll)
+    b[0][ll] = K(ll + 1.);
+  BatchedFieldVector<K, N, W> y;
+  batch.mv(b, y);
+  BatchedFieldVector<K, N, W> x;
+  batch.solve(x, b);
+  const auto det = batch.determinant();
+  auto inverse = batch;
+  inverse.invert();
+  const auto inverse_det = inverse.determinant();
+  for (size_t ll = 0; ll < W; ++ll) {
+    const FieldMatrix<K, N, N> mat = matrices[ll];
+    EXPECT_EQ(mat, batch.lane(ll));
+    FieldVector<K, N> expected;
+    mat.mv(b.lane(ll), expected);
+    EXPECT_TRUE(FloatCmp::eq(expected, y.lane(ll))) << expected << "\n" << y.lane(ll);
+    FieldVector<K, N> mat_x;
+    mat.mv(x.lane(ll), mat_x);
+    EXPECT_TRUE(FloatCmp::eq(b.lane(ll), mat_x, 1e-12)) << b.lane(ll) << "\n" << mat_x;
+    for (size_t ii = 0; ii < N; ++ii)
+      for (size_t jj = 0; jj < N; ++jj) {
+        K identity_ij(0);
+        for (size_t kk = 0; kk < N; ++kk)
+          identity_ij += mat[ii][kk] * inverse[kk][jj][ll];
+        EXPECT_TRUE(FloatCmp::eq(K(ii == jj ? 1 : 0), identity_ij, 1e-12, 1e-12)) << identity_ij;
+      }
+    EXPECT_TRUE(FloatCmp::eq(K(1), det[ll] * inverse_det[ll], 1e-12)) << det[ll] << " vs. " << inverse_det[ll];
+  }
+  // the determinant of a row permutation of a diagonal matrix
+  BatchedFieldMatrix<K, N, N, W> permuted;
+  K expected_det(N % 4 == 2 || N % 4 == 3 ? -1 : 1);
+  for (size_t ii = 0; ii < N; ++ii) {
+    permuted[N - 1 - ii][ii].fill(K(ii + 1.));
+    expected_det *= K(ii + 1.);
+  }
+  for (const auto& permuted_det : permuted.determinant())
+    EXPECT_TRUE(FloatCmp::eq(expected_det, permuted_det)) << expected_det << " vs. " << permuted_det;
+  // one singular lane spoils the batch
+  auto singular = batch;
+  auto zero_row = matrices[W / 2];
+  for (size_t jj = 0; jj < N; ++jj)
+    zero_row[N - 1][jj] = K(0);
+  singular.set_lane(W / 2, zero_row);
+  EXPECT_THROW(singular.invert(), Dune::FMatrixError);
+  EXPECT_THROW(singular.solve(x, b), Dune::FMatrixError);
+  EXPECT_EQ(K(0), singular.determinant()[W / 2]);
+} // ... check_batched_kernels(...)
+
+
+GTEST_TEST(dune_xt_common_batched_field_matrix, conversions)
+{
+  std::mt19937 generator(42);
+  const auto matrices = random_matrices<double, 3, 4>(generator);
+  BatchedFieldMatrix<double, 3, 3, 4> batch(matrices);
+  for (size_t ll = 0; ll < 4; ++ll)
+    for (size_t ii = 0; ii < 3; ++ii)
+      for (size_t jj = 0; jj < 3; ++jj)
+        EXPECT_EQ(matrices[ll][ii][jj], batch[ii][jj][ll]);
+  batch.set_lane(2, matrices[0]);
+  EXPECT_EQ((FieldMatrix<double, 3, 3>(matrices[0])), batch.lane(2));
+  EXPECT_EQ(size_t(8), size_t(BatchedFieldMatrix<double, 3, 3>::width));
+  EXPECT_EQ(size_t(16), size_t(BatchedFieldVector<float, 3>::width));
+}
+
+GTEST_TEST(dune_xt_common_batched_field_matrix, kernels)
+{
+  check_batched_kernels<double, 1, 8>();
+  check_batched_kernels<double, 2, 8>();
+  check_batched_kernels<double, 3, 8>();
+  check_batched_kernels<double, 4, 8>();
+  check_batched_kernels<double, 5, 4>();
+  check_batched_kernels<double, 7, 3>();
+}
+
+GTEST_TEST(dune_xt_common_batched_field_matrix, scalar_fallback)
+{
+  check_batched_kernels<std::complex<double>, 4, 4>();
+  check_batched_kernels<std::complex<double>, 5, 2>();
+}
+
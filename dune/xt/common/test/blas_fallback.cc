@@ -0,0 +1,538 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Needs to come first, include the config.h.
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <dune/xt/common/blas_fallback.hh>
+#include <dune/xt/common/cblas.hh>
+#include <dune/xt/common/lapacke.hh>
+
+using namespace Dune::XT::Common;
+using namespace Dune::XT::Common::internal;
+
+typedef std::complex<double> C;
+
+
+double random_entry(std::mt19937& generator, double)
+{
+  return std::uniform_real_distribution<double>(-1., 1.)(generator);
+}
+
+C random_entry(std::mt19937& generator, C)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  return C(distribution(generator), distribution(generator));
+}
+
+template <class K>
+std::vector<K> random_vector(const size_t size, std::mt19937& generator)
+{
+  std::vector<K> ret(size);
+  for (auto& entry : ret)
+    entry = random_entry(generator, K());
+  return ret;
+}
+
+
+//! op(A)(ii, jj) for A stored in a with leading dimension lda
+template <class K>
+K op_entry(const bool row_major, const bool trans, const bool conjugate, const K* a, const int lda, int ii, int jj)
+{
+  if (trans)
+    std::swap(ii, jj);
+  const K a_ij = row_major ? a[ii * lda + jj] : a[ii + jj * lda];
+  return conjugate ? conj_if(a_ij, std::true_type()) : a_ij;
+}
+
+template <class K>
+void expect_near(const K& expected, const K& actual, const double tolerance = 1e-12)
+{
+  EXPECT_LE(std::abs(expected - actual), tolerance * std::max(1., std::abs(expected)))
+      << "expected: " << expected << "\nactual:   " << actual;
+}
+
+
+template <class K>
+void check_level_1()
+{
+  std::mt19937 generator(42);
+  const int n = 21;
+  const auto x = random_vector<K>(3 * n, generator);
+  auto y = random_vector<K>(2 * n, generator);
+  for (const int incx : {1, 3, -3})
+    for (const int incy : {1, -2}) {
+      // the ii-th logical entry
+      const auto x_ii = [&](int ii) { return x[incx > 0 ? ii * incx : (n - 1 - ii) * -incx]; };
+      const auto y_ii = [&](int ii) -> K& { return y[incy > 0 ? ii * incy : (n - 1 - ii) * -incy]; };
+      K dot(0), dotc(0);
+      double norm = 0;
+      for (int ii = 0; ii < n; ++ii) {
+        dot += x_ii(ii) * y_ii(ii);
+        dotc += conj_if(x_ii(ii), std::true_type()) * y_ii(ii);
+        norm += std::norm(x_ii(ii));
+      }
+      expect_near(dot, fallback_dot(n, x.data(), incx, y.data(), incy));
+      expect_near(dotc, fallback_dot(n, x.data(), incx, y.data(), incy, true));
+      // non-positive increments give 0, as for scal below
+      expect_near(incx > 0 ? std::sqrt(norm) : 0., fallback_nrm2(n, x.data(), incx));
+      const K alpha = random_entry(generator, K());
+      std::vector<K> expected(n);
+      for (int ii = 0; ii < n; ++ii)
+        expected[ii] = y_ii(ii) + alpha * x_ii(ii);
+      fallback_axpy(n, alpha, x.data(), incx, y.data(), incy);
+      for (int ii = 0; ii < n; ++ii)
+        expect_near(expected[ii], y_ii(ii));
+    }
+  auto z = x;
+  fallback_scal(n, K(2), z.data(), 3);
+  for (int ii = 0; ii < 3 * n; ++ii)
+    expect_near(ii % 3 == 0 ? K(2) * x[ii] : x[ii], z[ii]);
+  for (const int incx : {0, -1}) {
+    EXPECT_EQ(0., fallback_nrm2(n, x.data(), incx));
+    auto untouched = x;
+    fallback_scal(n, K(2), untouched.data(), incx);
+    EXPECT_EQ(x, untouched);
+  }
+  EXPECT_EQ(K(0), fallback_dot(0, x.data(), 1, y.data(), 1));
+} // ... check_level_1(...)
+
+GTEST_TEST(dune_xt_common_blas_fallback, level_1)
+{
+  check_level_1<double>();
+  check_level_1<C>();
+  // no overflow or underflow of the sum of squares
+  for (const double scale : {1e-200, 1e200}) {
+    const std::vector<double> x = {3. * scale, 4. * scale};
+    expect_near(5. * scale, fallback_nrm2(2, x.data(), 1));
+  }
+  const std::vector<double> zero(3, 0.);
+  EXPECT_EQ(0., fallback_nrm2(3, zero.data(), 1));
+  // the same convention for non-positive increments as the library
+  const std::vector<double> x = {3., 4., 12.};
+  for (const int incx : {1, 0, -1}) {
+    EXPECT_EQ(incx > 0 ? 13. : 0., Cblas::dnrm2(3, x.data(), incx));
+    auto y = x;
+    Cblas::dscal(3, 2., y.data(), incx);
+    EXPECT_EQ(incx > 0 ? 6. : 3., y[0]);
+  }
+}
+
+
+template <class K>
+void check_gemv(const bool row_major, const bool trans, const bool conjugate, const int incx, const int incy)
+{
+  std::mt19937 generator(42);
+  const int m = 37;
+  const int n = 23;
+  const int lda = (row_major ? n : m) + 3;
+  const auto a = random_vector<K>(size_t(lda) * (row_major ? m : n), generator);
+  const int rows = trans ? n : m;
+  const int cols = trans ? m : n;
+  const auto x = random_vector<K>(cols * std::abs(incx), generator);
+  auto y = random_vector<K>(rows * std::abs(incy), generator);
+  const K alpha = random_entry(generator, K());
+  const K beta = random_entry(generator, K());
+  std::vector<K> expected(rows);
+  for (int ii = 0; ii < rows; ++ii) {
+    K ax(0);
+    for (int jj = 0; jj < cols; ++jj)
+      ax += op_entry(row_major, trans, conjugate, a.data(), lda, ii, jj)
+            * x[incx > 0 ? jj * incx : (cols - 1 - jj) * -incx];
+    expected[ii] = alpha * ax + beta * y[incy > 0 ? ii * incy : (rows - 1 - ii) * -incy];
+  }
+  fallback_gemv(row_major, trans, conjugate, m, n, alpha, a.data(), lda, x.data(), incx, beta, y.data(), incy);
+  for (int ii = 0; ii < rows; ++ii)
+    expect_near(expected[ii], y[incy > 0 ? ii * incy : (rows - 1 - ii) * -incy]);
+} // ... check_gemv(...)
+
+GTEST_TEST(dune_xt_common_blas_fallback, gemv)
+{
+  for (const bool row_major : {true, false})
+    for (const bool trans : {false, true}) {
+      check_gemv<double>(row_major, trans, false, 1, 1);
+      check_gemv<double>(row_major, trans, false, -2, 3);
+      check_gemv<C>(row_major, trans, trans, 1, 1);
+      check_gemv<C>(row_major, trans, false, 2, -1);
+    }
+}
+
+
+//! a well conditioned triangular matrix, also with a unit diagonal (the other triangle must not be referenced)
+template <class K>
+std::vector<K> random_triangular(const int k, const int lda, std::mt19937& generator)
+{
+  auto a = random_vector<K>(size_t(k) * lda, generator);
+  for (auto& entry : a)
+    entry /= K(k);
+  for (int ii = 0; ii < k; ++ii)
+    a[ii * lda + ii] += K(2);
+  return a;
+}
+
+//! op(A)(ii, jj), respecting the triangle and the unit diagonal
+template <class K>
+K triangular_entry(const bool row_major,
+                   const bool lower,
+                   const bool trans,
+                   const bool conjugate,
+                   const bool unit,
+                   const K* a,
+                   const int lda,
+                   const int ii,
+                   const int jj)
+{
+  // the entry of A
+  const int rr = trans ? jj : ii;
+  const int cc = trans ? ii : jj;
+  if (rr == cc && unit)
+    return K(1);
+  if (lower ? cc > rr : cc < rr)
+    return K(0);
+  return op_entry(row_major, trans, conjugate, a, lda, ii, jj);
+}
+
+
+template <class K>
+void check_trsv(const bool row_major, const bool lower, const bool trans, const bool conjugate, const bool unit)
+{
+  std::mt19937 generator(42);
+  const int n = 29;
+  const int lda = n + 2;
+  const auto a = random_triangular<K>(n, lda, generator);
+  for (const int incx : {1, -2}) {
+    const auto b = random_vector<K>(n * std::abs(incx), generator);
+    auto x = b;
+    fallback_trsv(row_major, lower, trans, conjugate, unit, n, a.data(), lda, x.data(), incx);
+    const auto entry = [&](const std::vector<K>& v, const int ii) { return v[incx > 0 ? ii : (n - 1 - ii) * -incx]; };
+    for (int ii = 0; ii < n; ++ii) {
+      K ax(0);
+      for (int jj = 0; jj < n; ++jj)
+        ax += triangular_entry(row_major, lower, trans, conjugate, unit, a.data(), lda, ii, jj) * entry(x, jj);
+      expect_near(entry(b, ii), ax, 1e-11);
+    }
+  }
+} // ... check_trsv(...)
+
+
+template <class K>
+void check_trsm(const bool row_major,
+                const bool left,
+                const bool lower,
+                const bool trans,
+                const bool conjugate,
+                const bool unit,
+                const int m,
+                const int n)
+{
+  std::mt19937 generator(42);
+  const int k = left ? m : n;
+  const int lda = k + 1;
+  const int ldb = (row_major ? n : m) + 2;
+  const auto a = random_triangular<K>(k, lda, generator);
+  const auto b = random_vector<K>(size_t(ldb) * (row_major ? m : n), generator);
+  const K alpha = random_entry(generator, K());
+  auto x = b;
+  fallback_trsm(row_major, left, lower, trans, conjugate, unit, m, n, alpha, a.data(), lda, x.data(), ldb);
+  const auto entry = [&](const std::vector<K>& v, const int ii, const int jj) {
+    return row_major ? v[ii * ldb + jj] : v[ii + jj * ldb];
+  };
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < n; ++jj) {
+      K product(0);
+      for (int ll = 0; ll < k; ++ll)
+        product += left ? triangular_entry(row_major, lower, trans, conjugate, unit, a.data(), lda, ii, ll)
+                              * entry(x, ll, jj)
+                        : entry(x, ii, ll)
+                              * triangular_entry(row_major, lower, trans, conjugate, unit, a.data(), lda, ll, jj);
+      expect_near(alpha * entry(b, ii, jj), product, 1e-11);
+    }
+} // ... check_trsm(...)
+
+GTEST_TEST(dune_xt_common_blas_fallback, triangular_solves)
+{
+  for (const bool row_major : {true, false})
+    for (const bool lower : {true, false})
+      for (const bool trans : {false, true})
+        for (const bool unit : {false, true}) {
+          check_trsv<double>(row_major, lower, trans, false, unit);
+          check_trsv<C>(row_major, lower, trans, trans, unit);
+          for (const bool left : {true, false}) {
+            // unblocked and blocked
+            check_trsm<double>(row_major, left, lower, trans, false, unit, 9, 5);
+            check_trsm<double>(row_major, left, lower, trans, false, unit, 150, 140);
+            check_trsm<C>(row_major, left, lower, trans, trans, unit, 7, 4);
+          }
+        }
+}
+
+
+template <class K>
+void check_gemm(const bool row_major, const bool transa, const bool conja, const bool transb, const bool conjb)
+{
+  std::mt19937 generator(42);
+  const int m = 31;
+  const int n = 17;
+  const int k = 13;
+  const int lda = (row_major != transa ? k : m) + 1;
+  const int ldb = (row_major != transb ? n : k) + 2;
+  const int ldc = (row_major ? n : m) + 3;
+  const auto a = random_vector<K>(size_t(lda) * (row_major != transa ? m : k), generator);
+  const auto b = random_vector<K>(size_t(ldb) * (row_major != transb ? k : n), generator);
+  auto c = random_vector<K>(size_t(ldc) * (row_major ? m : n), generator);
+  const K alpha = random_entry(generator, K());
+  const K beta = random_entry(generator, K());
+  const auto c_entry = [&](std::vector<K>& v, const int ii, const int jj) -> K& {
+    return row_major ? v[ii * ldc + jj] : v[ii + jj * ldc];
+  };
+  auto expected = c;
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < n; ++jj) {
+      K product(0);
+      for (int ll = 0; ll < k; ++ll)
+        product += op_entry(row_major, transa, conja, a.data(), lda, ii, ll)
+                   * op_entry(row_major, transb, conjb, b.data(), ldb, ll, jj);
+      c_entry(expected, ii, jj) = alpha * product + beta * c_entry(c, ii, jj);
+    }
+  fallback_gemm(
+      row_major, transa, conja, transb, conjb, m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+  for (size_t ii = 0; ii < c.size(); ++ii)
+    expect_near(expected[ii], c[ii]);
+} // ... check_gemm(...)
+
+
+template <class K>
+void check_syrk(const bool row_major, const bool lower, const bool trans)
+{
+  std::mt19937 generator(42);
+  const int n = 19;
+  const int k = 11;
+  const int lda = (row_major != trans ? k : n) + 1;
+  const int ldc = n + 2;
+  const auto a = random_vector<K>(size_t(lda) * (row_major != trans ? n : k), generator);
+  auto c = random_vector<K>(size_t(ldc) * n, generator);
+  const K alpha = random_entry(generator, K());
+  const K beta = random_entry(generator, K());
+  auto expected = c;
+  for (int ii = 0; ii < n; ++ii)
+    for (int jj = (lower ? 0 : ii); jj < (lower ? ii + 1 : n); ++jj) {
+      K product(0);
+      for (int ll = 0; ll < k; ++ll)
+        product += op_entry(row_major, trans, false, a.data(), lda, ii, ll)
+                   * op_entry(row_major, trans, false, a.data(), lda, jj, ll);
+      K& c_ij = row_major ? expected[ii * ldc + jj] : expected[ii + jj * ldc];
+      c_ij = alpha * product + beta * c_ij;
+    }
+  fallback_syrk(row_major, lower, trans, n, k, alpha, a.data(), lda, beta, c.data(), ldc);
+  for (size_t ii = 0; ii < c.size(); ++ii)
+    expect_near(expected[ii], c[ii]);
+} // ... check_syrk(...)
+
+GTEST_TEST(dune_xt_common_blas_fallback, level_3)
+{
+  for (const bool row_major : {true, false})
+    for (const bool transa : {false, true}) {
+      for (const bool transb : {false, true}) {
+        check_gemm<double>(row_major, transa, false, transb, false);
+        check_gemm<C>(row_major, transa, transa, transb, false);
+      }
+      check_syrk<double>(row_major, false, transa);
+      check_syrk<double>(row_major, true, transa);
+      check_syrk<C>(row_major, true, transa);
+    }
+}
+
+
+GTEST_TEST(dune_xt_common_blas_fallback, potrf)
+{
+  std::mt19937 generator(42);
+  // unblocked and blocked (several block columns and row blocks of the trailing update)
+  for (const int n : {5, 300}) {
+    const int lda = n + 1;
+    const auto b = random_vector<double>(size_t(n) * n, generator);
+    // A = B B^T + n I
+    std::vector<double> a(size_t(lda) * n, 0.);
+    for (int ii = 0; ii < n; ++ii)
+      for (int jj = 0; jj < n; ++jj) {
+        for (int ll = 0; ll < n; ++ll)
+          a[ii * lda + jj] += b[ii * n + ll] * b[jj * n + ll];
+        a[ii * lda + jj] += (ii == jj) ? n : 0.;
+      }
+    for (const bool row_major : {true, false})
+      for (const bool lower : {true, false}) {
+        auto l = a;
+        EXPECT_EQ(0, fallback_potrf(row_major, lower, n, l.data(), lda));
+        // A is symmetric, so the lower triangle in row major is the upper one in column major
+        const auto l_entry = [&](const int ii, const int jj) {
+          if (jj > ii)
+            return 0.;
+          return (lower == row_major) ? l[ii * lda + jj] : l[jj * lda + ii];
+        };
+        for (int ii = 0; ii < n; ++ii)
+          for (int jj = 0; jj <= ii; ++jj) {
+            double l_l_t = 0;
+            for (int ll = 0; ll <= jj; ++ll)
+              l_l_t += l_entry(ii, ll) * l_entry(jj, ll);
+            expect_near(a[ii * lda + jj], l_l_t, 1e-11);
+          }
+      }
+    // not positive definite
+    auto indefinite = a;
+    indefinite[3 * lda + 3] = -1e6;
+    EXPECT_EQ(4, fallback_potrf(true, true, n, indefinite.data(), lda));
+  }
+}
+
+
+GTEST_TEST(dune_xt_common_blas_fallback, pttrf_pttrs)
+{
+  std::mt19937 generator(42);
+  const int n = 33;
+  const int nrhs = 3;
+  auto d = random_vector<double>(n, generator);
+  auto e = random_vector<double>(n - 1, generator);
+  for (auto& d_ii : d)
+    d_ii += 3.;
+  const auto apply = [&](const std::vector<double>& x, const int ii, const int stride) {
+    double ret = d[ii] * x[ii * stride];
+    if (ii > 0)
+      ret += e[ii - 1] * x[(ii - 1) * stride];
+    if (ii + 1 < n)
+      ret += e[ii] * x[(ii + 1) * stride];
+    return ret;
+  };
+  auto d_factor = d;
+  auto e_factor = e;
+  EXPECT_EQ(0, fallback_pttrf(n, d_factor.data(), e_factor.data()));
+  for (const bool row_major : {true, false}) {
+    const int ldb = row_major ? nrhs + 1 : n + 2;
+    const auto b = random_vector<double>(size_t(ldb) * (row_major ? n : nrhs), generator);
+    auto x = b;
+    EXPECT_EQ(0, fallback_pttrs(row_major, n, nrhs, d_factor.data(), e_factor.data(), x.data(), ldb));
+    for (int jj = 0; jj < nrhs; ++jj) {
+      // the jj-th column of x, with the given stride
+      const std::vector<double> x_jj(x.begin() + (row_major ? jj : jj * ldb), x.end());
+      for (int ii = 0; ii < n; ++ii)
+        expect_near(b[row_major ? ii * ldb + jj : ii + jj * ldb], apply(x_jj, ii, row_major ? ldb : 1));
+    }
+  }
+  auto indefinite = d;
+  indefinite[5] = -3.;
+  auto e_copy = e;
+  EXPECT_EQ(6, fallback_pttrf(n, indefinite.data(), e_copy.data()));
+}
+
+
+void check_geqp3(const bool row_major, const int m, const int n)
+{
+  std::mt19937 generator(42);
+  const int lda = (row_major ? n : m) + 1;
+  auto a = random_vector<double>(size_t(lda) * (row_major ? m : n), generator);
+  const auto entry = [&](std::vector<double>& v, const int ii, const int jj) -> double& {
+    return row_major ? v[ii * lda + jj] : v[ii + jj * lda];
+  };
+  // a rank deficient column and a tiny one
+  for (int ii = 0; ii < m; ++ii) {
+    entry(a, ii, 2) = entry(a, ii, 0) + entry(a, ii, 1);
+    entry(a, ii, 3) *= 1e-8;
+  }
+  // column 4 is fixed
+  std::vector<int> jpvt(n, 0);
+  jpvt[4] = 1;
+  const int k = std::min(m, n);
+  std::vector<double> tau(k);
+  auto qr = a;
+  EXPECT_EQ(0, fallback_geqp3(row_major, m, n, qr.data(), lda, jpvt.data(), tau.data()));
+  EXPECT_EQ(5, jpvt[0]);
+  auto sorted_jpvt = jpvt;
+  std::sort(sorted_jpvt.begin(), sorted_jpvt.end());
+  for (int jj = 0; jj < n; ++jj)
+    EXPECT_EQ(jj + 1, sorted_jpvt[jj]);
+  // the diagonal of R decreases (apart from the fixed column), the rank deficiency shows
+  for (int ii = 2; ii < k; ++ii)
+    EXPECT_LE(std::abs(entry(qr, ii, ii)), std::abs(entry(qr, ii - 1, ii - 1)) * (1 + 1e-12));
+  if (m > n) {
+    EXPECT_LT(std::abs(entry(qr, k - 1, k - 1)), 1e-6);
+  }
+  // Q R = A P
+  std::vector<double> q(size_t(lda) * (row_major ? m : k));
+  const int ldq = lda;
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < k; ++jj)
+      (row_major ? q[ii * ldq + jj] : q[ii + jj * ldq]) = entry(qr, ii, jj);
+  EXPECT_EQ(0, fallback_orgqr(row_major, m, k, k, q.data(), ldq, tau.data()));
+  const auto q_entry = [&](const int ii, const int jj) { return row_major ? q[ii * ldq + jj] : q[ii + jj * ldq]; };
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < n; ++jj) {
+      double q_r = 0;
+      for (int ll = 0; ll <= std::min(jj, k - 1); ++ll)
+        q_r += q_entry(ii, ll) * entry(qr, ll, jj);
+      expect_near(entry(a, ii, jpvt[jj] - 1), q_r, 1e-11);
+    }
+  for (int ii = 0; ii < k; ++ii)
+    for (int jj = 0; jj < k; ++jj) {
+      double q_t_q = 0;
+      for (int ll = 0; ll < m; ++ll)
+        q_t_q += q_entry(ll, ii) * q_entry(ll, jj);
+      expect_near(ii == jj ? 1. : 0., q_t_q);
+    }
+} // ... check_geqp3(...)
+
+GTEST_TEST(dune_xt_common_blas_fallback, geqp3_orgqr)
+{
+  for (const bool row_major : {true, false}) {
+    check_geqp3(row_major, 40, 30);
+    check_geqp3(row_major, 20, 35);
+  }
+}
+
+
+GTEST_TEST(dune_xt_common_blas_fallback, lamch)
+{
+  EXPECT_EQ(std::numeric_limits<double>::epsilon() / 2, fallback_lamch<double>('E'));
+  EXPECT_EQ(std::numeric_limits<double>::epsilon(), fallback_lamch<double>('p'));
+  EXPECT_EQ(2., fallback_lamch<double>('B'));
+  EXPECT_EQ(53., fallback_lamch<double>('N'));
+  if (Lapacke::available()) {
+    for (const char cmach : {'E', 'S', 'B', 'P', 'N', 'R', 'M', 'U', 'L', 'O'})
+      EXPECT_EQ(Lapacke::dlamch(cmach), fallback_lamch<double>(cmach)) << cmach;
+  }
+}
+
+
+//! the wrappers use the fallbacks without a library, so they work in any case
+GTEST_TEST(dune_xt_common_blas_fallback, wrappers)
+{
+  std::mt19937 generator(42);
+  const int n = 10;
+  auto a = random_triangular<double>(n, n, generator);
+  const auto x = random_vector<double>(n, generator);
+  std::vector<double> y(n, 0.);
+  Cblas::dgemv(Cblas::row_major(), Cblas::no_trans(), n, n, 1., a.data(), n, x.data(), 1, 0., y.data(), 1);
+  Cblas::dtrsv(Cblas::row_major(), Cblas::upper(), Cblas::no_trans(), Cblas::non_unit(), n, a.data(), n, y.data(), 1);
+  std::vector<double> expected(n, 0.);
+  for (int ii = 0; ii < n; ++ii)
+    for (int jj = 0; jj < n; ++jj)
+      expected[ii] += a[ii * n + jj] * x[jj];
+  for (int ii = n - 1; ii >= 0; --ii) {
+    for (int jj = ii + 1; jj < n; ++jj)
+      expected[ii] -= a[ii * n + jj] * expected[jj];
+    expected[ii] /= a[ii * n + ii];
+  }
+  for (int ii = 0; ii < n; ++ii)
+    expect_near(expected[ii], y[ii]);
+  std::vector<double> d(n, 2.), e(n - 1, -1.), b(n, 1.);
+  EXPECT_EQ(0, Lapacke::dpttrf(n, d.data(), e.data()));
+  EXPECT_EQ(0, Lapacke::dpttrs(Lapacke::row_major(), n, 1, d.data(), e.data(), b.data(), 1));
+  // the solution of the discrete laplacian with a constant right hand side is x_ii = (ii + 1) (n - ii) / 2
+  for (int ii = 0; ii < n; ++ii)
+    expect_near((ii + 1) * (n - ii) / 2., b[ii]);
+}
+
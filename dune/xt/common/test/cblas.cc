@@ -0,0 +1,189 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- Needs to come first, include the config.h.
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <dune/xt/common/cblas.hh>
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/float_cmp.hh>
+
+using namespace Dune::XT::Common;
+
+
+template <class K>
+std::vector<K> random_vector(const size_t size, std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::vector<K> ret(size);
+  for (auto& entry : ret)
+    entry = K(distribution(generator));
+  return ret;
+}
+
+template <>
+std::vector<std::complex<double>> random_vector(const size_t size, std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::vector<std::complex<double>> ret(size);
+  for (auto& entry : ret)
+    entry = std::complex<double>(distribution(generator), distribution(generator));
+  return ret;
+}
+
+
+GTEST_TEST(dune_xt_common_cblas, fallback_throws_on_wrong_input)
+{
+  if (Cblas::available())
+    return;
+  std::vector<double> x(3, 1.);
+  EXPECT_THROW(Cblas::dgemv(0, Cblas::no_trans(), 1, 3, 1., x.data(), 3, x.data(), 1, 0., x.data(), 1),
+               Exceptions::wrong_input_given);
+  EXPECT_THROW(
+      Cblas::dgemv(Cblas::row_major(), Cblas::no_trans(), -1, 3, 1., x.data(), 3, x.data(), 1, 0., x.data(), 1),
+      Exceptions::wrong_input_given);
+}
+
+GTEST_TEST(dune_xt_common_cblas, level_1)
+{
+  std::mt19937 generator(42);
+  const int n = 17;
+  const auto x = random_vector<double>(2 * n, generator);
+  auto y = random_vector<double>(n, generator);
+  double expected_dot = 0;
+  double expected_norm = 0;
+  for (int ii = 0; ii < n; ++ii) {
+    expected_dot += x[2 * ii] * y[ii];
+    expected_norm += x[2 * ii] * x[2 * ii];
+  }
+  EXPECT_TRUE(FloatCmp::eq(expected_dot, Cblas::ddot(n, x.data(), 2, y.data(), 1)));
+  EXPECT_TRUE(FloatCmp::eq(std::sqrt(expected_norm), Cblas::dnrm2(n, x.data(), 2)));
+  auto expected_y = y;
+  for (int ii = 0; ii < n; ++ii)
+    expected_y[ii] = 3. * (expected_y[ii] + 0.5 * x[2 * ii]);
+  Cblas::daxpy(n, 0.5, x.data(), 2, y.data(), 1);
+  Cblas::dscal(n, 3., y.data(), 1);
+  for (int ii = 0; ii < n; ++ii)
+    EXPECT_TRUE(FloatCmp::eq(expected_y[ii], y[ii]));
+}
+
+GTEST_TEST(dune_xt_common_cblas, complex_level_1)
+{
+  typedef std::complex<double> C;
+  std::mt19937 generator(42);
+  const int n = 11;
+  const auto x = random_vector<C>(n, generator);
+  auto y = random_vector<C>(n, generator);
+  C expected_dotc = 0;
+  C expected_dotu = 0;
+  double expected_norm = 0;
+  for (int ii = 0; ii < n; ++ii) {
+    expected_dotc += std::conj(x[ii]) * y[ii];
+    expected_dotu += x[ii] * y[ii];
+    expected_norm += std::norm(x[ii]);
+  }
+  C dot;
+  Cblas::zdotc_sub(n, x.data(), 1, y.data(), 1, &dot);
+  EXPECT_TRUE(FloatCmp::eq(expected_dotc, dot));
+  Cblas::zdotu_sub(n, x.data(), 1, y.data(), 1, &dot);
+  EXPECT_TRUE(FloatCmp::eq(expected_dotu, dot));
+  EXPECT_TRUE(FloatCmp::eq(std::sqrt(expected_norm), Cblas::dznrm2(n, x.data(), 1)));
+  const C alpha(0.5, -1.);
+  const C beta(2., 1.);
+  auto expected_y = y;
+  for (int ii = 0; ii < n; ++ii)
+    expected_y[ii] = beta * (expected_y[ii] + alpha * x[ii]);
+  Cblas::zaxpy(n, &alpha, x.data(), 1, y.data(), 1);
+  Cblas::zscal(n, &beta, y.data(), 1);
+  for (int ii = 0; ii < n; ++ii)
+    EXPECT_TRUE(FloatCmp::eq(expected_y[ii], y[ii]));
+}
+
+GTEST_TEST(dune_xt_common_cblas, level_3)
+{
+  std::mt19937 generator(42);
+  const int m = 7;
+  const int n = 5;
+  const int k = 9;
+  // row-major, A^T is m x k, B is k x n
+  const auto a = random_vector<double>(k * m, generator);
+  const auto b = random_vector<double>(k * n, generator);
+  auto c = random_vector<double>(m * n, generator);
+  auto expected_c = c;
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < n; ++jj) {
+      double a_b = 0;
+      for (int pp = 0; pp < k; ++pp)
+        a_b += a[pp * m + ii] * b[pp * n + jj];
+      expected_c[ii * n + jj] = 2. * a_b - c[ii * n + jj];
+    }
+  Cblas::dgemm(
+      Cblas::row_major(), Cblas::trans(), Cblas::no_trans(), m, n, k, 2., a.data(), m, b.data(), n, -1., c.data(), n);
+  for (int ii = 0; ii < m * n; ++ii)
+    EXPECT_TRUE(FloatCmp::eq(expected_c[ii], c[ii]));
+  // C = A A^T, only the lower triangle is referenced and written
+  std::vector<double> s(m * m, 0.);
+  Cblas::dsyrk(Cblas::row_major(), Cblas::lower(), Cblas::trans(), m, k, 1., a.data(), m, 0., s.data(), m);
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < m; ++jj) {
+      double expected = 0;
+      if (jj <= ii)
+        for (int pp = 0; pp < k; ++pp)
+          expected += a[pp * m + ii] * a[pp * m + jj];
+      EXPECT_TRUE(FloatCmp::eq(expected, s[ii * m + jj]));
+    }
+}
+
+GTEST_TEST(dune_xt_common_cblas, complex_level_3)
+{
+  typedef std::complex<double> C;
+  std::mt19937 generator(42);
+  const int m = 4;
+  const int n = 6;
+  const int k = 3;
+  // row-major, A^H is m x k, B is k x n
+  const auto a = random_vector<C>(k * m, generator);
+  const auto b = random_vector<C>(k * n, generator);
+  std::vector<C> c(m * n);
+  const C alpha(1., 2.);
+  const C zero(0.);
+  Cblas::zgemm(Cblas::row_major(),
+               Cblas::conj_trans(),
+               Cblas::no_trans(),
+               m,
+               n,
+               k,
+               &alpha,
+               a.data(),
+               m,
+               b.data(),
+               n,
+               &zero,
+               c.data(),
+               n);
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = 0; jj < n; ++jj) {
+      C expected = 0;
+      for (int pp = 0; pp < k; ++pp)
+        expected += alpha * std::conj(a[pp * m + ii]) * b[pp * n + jj];
+      EXPECT_TRUE(FloatCmp::eq(expected, c[ii * n + jj]));
+    }
+  // C = A^T A^T^T (no conjugation), only the upper triangle is written
+  std::vector<C> s(m * m);
+  const C one(1.);
+  Cblas::zsyrk(Cblas::row_major(), Cblas::upper(), Cblas::trans(), m, k, &one, a.data(), m, &zero, s.data(), m);
+  for (int ii = 0; ii < m; ++ii)
+    for (int jj = ii; jj < m; ++jj) {
+      C expected = 0;
+      for (int pp = 0; pp < k; ++pp)
+        expected += a[pp * m + ii] * a[pp * m + jj];
+      EXPECT_TRUE(FloatCmp::eq(expected, s[ii * m + jj]));
+    }
+}
@@ -13,11 +13,18 @@
 #include <dune/xt/common/test/main.hxx>
 
 #include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <ostream>
+#include <thread>
+#include <unordered_set>
 
 #include <boost/assign/list_of.hpp>
 #include <boost/array.hpp>
 
+#include <dune/common/parametertreeparser.hh>
+
 #include <dune/xt/common/configuration.hh>
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/float_cmp.hh>
@@ -454,6 +461,41 @@ struct ConfigurationTest : public ::testing::Test
     TupleProduct::Combine<StaticCheck::Ints, StaticCheck::Ints, StaticCheck>::Generate<>::Run(subsub1);
 
   } // ... behaves_correctly(...)
+
+  static void fingerprint_is_consistent()
+  {
+    const Configuration config = ConfigurationCreator::create();
+    const Configuration reference = CreateByParameterTree::create();
+    EXPECT_EQ(config.fingerprint(), reference.fingerprint());
+    EXPECT_EQ(config, reference);
+    EXPECT_EQ(std::hash<Configuration>()(config), std::hash<Configuration>()(reference));
+    EXPECT_FALSE(std::less<Configuration>()(config, reference));
+    EXPECT_FALSE(std::less<Configuration>()(reference, config));
+
+    Configuration modified(config);
+    modified.set("sub1.int", 2, true);
+    EXPECT_NE(modified.fingerprint(), config.fingerprint());
+    EXPECT_NE(modified, config);
+    EXPECT_TRUE(std::less<Configuration>()(modified, config) != std::less<Configuration>()(config, modified));
+    // plain ParameterTrees are compared like the corresponding Configurations
+    const Dune::ParameterTree& config_tree = config;
+    const Dune::ParameterTree& modified_tree = modified;
+    EXPECT_FALSE(config_tree == modified_tree);
+    EXPECT_TRUE(config_tree != modified_tree);
+    EXPECT_EQ(std::less<Configuration>()(modified, config),
+              std::less<Dune::ParameterTree>()(modified_tree, config_tree));
+    EXPECT_EQ(std::less<Configuration>()(config, modified),
+              std::less<Dune::ParameterTree>()(config_tree, modified_tree));
+    modified.set("sub1.int", 1, true);
+    EXPECT_EQ(modified.fingerprint(), config.fingerprint());
+    EXPECT_EQ(modified, config);
+    EXPECT_TRUE(config_tree == modified_tree);
+    EXPECT_FALSE(std::less<Dune::ParameterTree>()(config_tree, modified_tree));
+    EXPECT_FALSE(std::less<Dune::ParameterTree>()(modified_tree, config_tree));
+
+    std::unordered_set<Configuration> configs{config, reference, modified, config.sub("sub2")};
+    EXPECT_EQ(2, configs.size());
+  } // ... fingerprint_is_consistent(...)
 }; // struct ConfigurationTest
 
 TYPED_TEST_CASE(ConfigTest, TestTypes);
@@ -479,3 +521,124 @@ TYPED_TEST(ConfigurationTest, behaves_correctly)
 {
   this->behaves_correctly();
 }
+TYPED_TEST(ConfigurationTest, fingerprint_is_consistent)
+{
+  this->fingerprint_is_consistent();
+}
+
+GTEST_TEST(ConfigurationAccessProfile, counts_accesses)
+{
+  Configuration config(CreateByParameterTree::create(),
+                       ConfigurationDefaults(false, false, "dxtc_parameter.log", true));
+  for (size_t ii = 0; ii < 3; ++ii)
+    EXPECT_EQ(1, config.get<int>("sub1.int"));
+  EXPECT_EQ("string", config.get<std::string>("string"));
+  EXPECT_EQ(2, config.get("missing", 2));
+  std::stringstream report;
+  config.report_access(report);
+  const auto lines = tokenize(report.str(), "\n", boost::algorithm::token_compress_on);
+  std::map<std::string, size_t> counts;
+  for (size_t ii = 1; ii < lines.size(); ++ii) {
+    const auto columns = tokenize(lines[ii], " ", boost::algorithm::token_compress_on);
+    if (columns.size() >= 2)
+      counts[columns[0]] = from_string<size_t>(columns[1]);
+  }
+  EXPECT_EQ(3, counts.size());
+  EXPECT_EQ(3, counts["sub1.int"]);
+  EXPECT_EQ(1, counts["string"]);
+  EXPECT_EQ(1, counts["missing"]);
+  config.set_profile_access(false);
+}
+
+GTEST_TEST(ConfigurationAccessProfile, concurrent_reads)
+{
+  Configuration config(CreateByParameterTree::create(),
+                       ConfigurationDefaults(false, false, "dxtc_parameter.log", true));
+  Configuration reference(CreateByParameterTree::create());
+  const auto expected_fingerprint = reference.fingerprint();
+  config["string"] = "string"; // invalidates the fingerprint, which is then recomputed concurrently below
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < 4; ++tt)
+    threads.emplace_back([&]() {
+      for (size_t ii = 0; ii < 100; ++ii) {
+        EXPECT_EQ(1, config.get<int>("sub1.int"));
+        EXPECT_EQ(expected_fingerprint, config.fingerprint());
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+  std::stringstream report;
+  config.report_access(report);
+  EXPECT_NE(std::string::npos, report.str().find("sub1.int"));
+  EXPECT_NE(std::string::npos, report.str().find("400"));
+  config.set_profile_access(false);
+}
+
+GTEST_TEST(ConfigurationAccessProfile, report_while_reading)
+{
+  Configuration config(CreateByParameterTree::create(),
+                       ConfigurationDefaults(false, false, "dxtc_parameter.log", true));
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < 4; ++tt)
+    threads.emplace_back([&, tt]() {
+      for (size_t ii = 0; ii < 1000; ++ii)
+        config.get("missing_" + std::to_string(tt) + "_" + std::to_string(ii % 10), 1);
+    });
+  std::thread reporter([&]() {
+    while (!done) {
+      std::stringstream report;
+      config.report_access(report);
+    }
+  });
+  for (auto& thread : threads)
+    thread.join();
+  done = true;
+  reporter.join();
+  std::stringstream report;
+  config.report_access(report);
+  EXPECT_NE(std::string::npos, report.str().find("missing_3_9"));
+  config.set_profile_access(false);
+}
+
+GTEST_TEST(ConfigurationReadINI, matches_dune_parser)
+{
+  const std::string contents = "# comment\n"
+                               "global_key = 1 # trailing comment\n"
+                               "[sub1]\n"
+                               "  int = 2\n"
+                               "string = \"multi\n"
+                               "line value\"\n"
+                               "[sub1.sub2]\n"
+                               "vector = [1 2 3]\n"
+                               "[]\n"
+                               "last = 'unterminated";
+  std::string filename = "configuration_read_ini.ini";
+  {
+    std::ofstream file(filename);
+    file << contents;
+  }
+  std::string program = "configuration";
+  std::vector<char*> argv = {&program[0], &filename[0]};
+  Configuration config;
+  config.read_command_line(2, argv.data());
+  Dune::ParameterTree expected;
+  std::istringstream stream(contents);
+  Dune::ParameterTreeParser::readINITree(stream, expected);
+  EXPECT_EQ(Configuration(expected), config);
+  EXPECT_EQ("multi\nline value", config.get<std::string>("sub1.string"));
+  {
+    std::ofstream file(filename);
+    file << "[sub]\nkey = 1\nkey = 2\n";
+  }
+  Configuration duplicate;
+  EXPECT_THROW(duplicate.read_command_line(2, argv.data()), Dune::ParameterTreeParserError);
+  // the same full key in different sections
+  {
+    std::ofstream file(filename);
+    file << "[a]\nb = 1\n[]\na.c = 2\n[a]\nc = 3\n";
+  }
+  Configuration duplicate_across_sections;
+  EXPECT_THROW(duplicate_across_sections.read_command_line(2, argv.data()), Dune::ParameterTreeParserError);
+  std::remove(filename.c_str());
+}
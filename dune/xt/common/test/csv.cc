@@ -0,0 +1,92 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+
+#include <dune/xt/common/csv.hh>
+
+using namespace Dune::XT::Common;
+
+static void write_file(const std::string& filename, const std::string& contents)
+{
+  std::ofstream file(filename, std::ios::binary);
+  file << contents;
+}
+
+GTEST_TEST(ReadCsv, matrix)
+{
+  write_file("read_csv_matrix.csv", "x,y,z\r\n1, 2.5,-3\r\n\r\n# comment\n4,5e-1 ,6\n");
+  const auto matrix = read_csv_matrix("read_csv_matrix.csv", ',', 1);
+  EXPECT_EQ(2, matrix.rows());
+  EXPECT_EQ(3, matrix.cols());
+  EXPECT_EQ(2.5, matrix[0][1]);
+  EXPECT_EQ(-3., matrix[0][2]);
+  EXPECT_EQ(0.5, matrix[1][1]);
+  const auto fixed = read_csv_matrix<Dune::FieldMatrix<double, 2, 3>>("read_csv_matrix.csv", ',', 1);
+  EXPECT_EQ(6., fixed[1][2]);
+  EXPECT_THROW((read_csv_matrix<Dune::FieldMatrix<double, 3, 3>>("read_csv_matrix.csv", ',', 1)),
+               Exceptions::conversion_error);
+  EXPECT_THROW(read_csv_matrix("read_csv_matrix.csv"), Exceptions::conversion_error);
+  std::remove("read_csv_matrix.csv");
+  EXPECT_THROW(read_csv_matrix("read_csv_matrix.csv"), Dune::IOError);
+}
+
+GTEST_TEST(ReadCsv, columns)
+{
+  write_file("read_csv_columns.dat", "  1\t2 3\n4  5\t\t6");
+  const auto columns = read_csv_columns("read_csv_columns.dat", ' ');
+  ASSERT_EQ(3, columns.size());
+  EXPECT_EQ(std::vector<double>({2., 5.}), columns[1]);
+  EXPECT_EQ(std::vector<double>({3., 6.}), columns[2]);
+  const auto dynamic_columns = read_csv_columns<Dune::DynamicVector<float>>("read_csv_columns.dat", ' ');
+  EXPECT_EQ(4.f, dynamic_columns[0][1]);
+  std::remove("read_csv_columns.dat");
+}
+
+GTEST_TEST(ReadCsv, errors)
+{
+  for (const std::string contents : {"1,2\n3\n", "1,2\n3,4,5\n", "1,2\n3,x\n", "1 2\n3 4x\n", "1,2\n3;4\n"}) {
+    write_file("read_csv_errors.csv", contents);
+    const char delimiter = (contents.find(',') == std::string::npos) ? ' ' : ',';
+    try {
+      read_csv_matrix("read_csv_errors.csv", delimiter);
+      ADD_FAILURE() << "reading '" << contents << "' should have failed";
+    } catch (const Exceptions::conversion_error& ee) {
+      EXPECT_NE(std::string::npos, std::string(ee.what()).find("row 1")) << ee.what();
+    }
+  }
+  std::remove("read_csv_errors.csv");
+}
+
+GTEST_TEST(ReadCsv, large)
+{
+  // several chunks, which are read in parallel if TBB is available
+  const size_t rows = 200000;
+  {
+    std::ofstream file("read_csv_large.csv");
+    for (size_t ii = 0; ii < rows; ++ii)
+      file << ii << "," << 0.5 * ii << "," << -double(ii) << "\n";
+  }
+  const auto matrix = read_csv_matrix("read_csv_large.csv");
+  ASSERT_EQ(rows, matrix.rows());
+  for (size_t ii = 0; ii < rows; ii += 997) {
+    EXPECT_EQ(double(ii), matrix[ii][0]);
+    EXPECT_EQ(0.5 * ii, matrix[ii][1]);
+    EXPECT_EQ(-double(ii), matrix[ii][2]);
+  }
+  EXPECT_EQ(-double(rows - 1), matrix[rows - 1][2]);
+  std::remove("read_csv_large.csv");
+}
@@ -0,0 +1,187 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/common/event_log.hh>
+
+using namespace Dune::XT::Common;
+using internal::EventArgType;
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+template <class T>
+static T read(const std::string& contents, size_t& pos)
+{
+  T ret;
+  EXPECT_LE(pos + sizeof(T), contents.size());
+  std::memcpy(&ret, contents.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return ret;
+}
+
+static std::string read_string(const std::string& contents, size_t& pos)
+{
+  const auto size = read<std::uint32_t>(contents, pos);
+  pos += size;
+  return contents.substr(pos - size, size);
+}
+
+// the formats and the events (as format id and raw arguments) in the file
+struct DecodedEvents
+{
+  std::map<std::uint32_t, std::pair<std::string, std::vector<EventArgType>>> formats;
+  std::vector<std::pair<std::uint32_t, std::string>> events;
+};
+
+static DecodedEvents decode(const std::string& filename)
+{
+  const auto contents = read_file(filename);
+  DecodedEvents ret;
+  EXPECT_EQ(std::string("DXTCEVT\0", 8), contents.substr(0, 8));
+  size_t pos = 8;
+  EXPECT_EQ(1, read<std::uint32_t>(contents, pos));
+  EXPECT_EQ(0x01020304, read<std::uint32_t>(contents, pos));
+  EXPECT_GT(read<std::int64_t>(contents, pos), 0);
+  EXPECT_EQ(0, read<std::uint32_t>(contents, pos));
+  std::uint64_t last_time = 0;
+  while (pos < contents.size()) {
+    const auto kind = read<std::uint8_t>(contents, pos);
+    const auto id = read<std::uint32_t>(contents, pos);
+    if (kind == 1) {
+      EXPECT_EQ(0, ret.formats.count(id));
+      read<std::uint32_t>(contents, pos);
+      std::vector<EventArgType> types(read<std::uint16_t>(contents, pos));
+      for (auto& type : types)
+        type = static_cast<EventArgType>(read<std::uint8_t>(contents, pos));
+      EXPECT_EQ(__FILE__, read_string(contents, pos));
+      ret.formats[id] = {read_string(contents, pos), types};
+    } else {
+      EXPECT_EQ(2, kind);
+      EXPECT_EQ(1, ret.formats.count(id));
+      const auto time = read<std::uint64_t>(contents, pos);
+      EXPECT_GE(time, last_time);
+      last_time = time;
+      const size_t begin = pos;
+      for (const auto& type : ret.formats[id].second) {
+        if (type == EventArgType::string)
+          read_string(contents, pos);
+        else
+          pos += (type == EventArgType::boolean || type == EventArgType::int8 || type == EventArgType::uint8)
+                     ? 1
+                     : (type == EventArgType::int16 || type == EventArgType::uint16)
+                           ? 2
+                           : (type == EventArgType::int32 || type == EventArgType::uint32
+                              || type == EventArgType::float32)
+                                 ? 4
+                                 : 8;
+      }
+      EXPECT_LE(pos, contents.size());
+      ret.events.emplace_back(id, contents.substr(begin, pos - begin));
+    }
+  }
+  return ret;
+} // ... decode(...)
+
+GTEST_TEST(EventLog, disabled)
+{
+  size_t evaluations = 0;
+  EXPECT_FALSE(EventLogger().enabled());
+  DXTC_EVENT_LOG("not evaluated: {}", ++evaluations);
+  EXPECT_EQ(0, evaluations);
+}
+
+GTEST_TEST(EventLog, types)
+{
+  EventLogger().create("event_log_types");
+  ASSERT_TRUE(EventLogger().enabled());
+  const std::string filename = EventLogger().filename();
+  EXPECT_EQ("data/log/event_log_types.evt", filename);
+  for (int ii = 0; ii < 3; ++ii)
+    DXTC_EVENT_LOG("iteration {}: residual {}", ii, 0.5 * ii);
+  DXTC_EVENT_LOG("no arguments");
+  DXTC_EVENT_LOG("{} {} {} {} {} {}", std::uint8_t(1), short(-2), 3u, -4l, 5.f, true);
+  DXTC_EVENT_LOG("{} and {}", "literal", std::string("string"));
+  EventLogger().deinit();
+  EXPECT_FALSE(EventLogger().enabled());
+  DXTC_EVENT_LOG("not recorded");
+
+  const auto decoded = decode(filename);
+  ASSERT_EQ(4, decoded.formats.size());
+  ASSERT_EQ(6, decoded.events.size());
+  const auto& iteration = decoded.formats.at(decoded.events[0].first);
+  EXPECT_EQ("iteration {}: residual {}", iteration.first);
+  EXPECT_EQ(std::vector<EventArgType>({EventArgType::int32, EventArgType::float64}), iteration.second);
+  for (int ii = 0; ii < 3; ++ii) {
+    ASSERT_EQ(decoded.events[0].first, decoded.events[ii].first);
+    size_t pos = 0;
+    EXPECT_EQ(ii, read<std::int32_t>(decoded.events[ii].second, pos));
+    EXPECT_EQ(0.5 * ii, read<double>(decoded.events[ii].second, pos));
+  }
+  EXPECT_EQ("no arguments", decoded.formats.at(decoded.events[3].first).first);
+  EXPECT_TRUE(decoded.events[3].second.empty());
+  EXPECT_EQ(std::vector<EventArgType>({EventArgType::uint8,
+                                       EventArgType::int16,
+                                       EventArgType::uint32,
+                                       EventArgType::int64,
+                                       EventArgType::float32,
+                                       EventArgType::boolean}),
+            decoded.formats.at(decoded.events[4].first).second);
+  EXPECT_EQ(std::string("\x01\xfe\xff\x03\0\0\0", 7), decoded.events[4].second.substr(0, 7));
+  EXPECT_EQ('\x01', decoded.events[4].second.back());
+  size_t pos = 0;
+  EXPECT_EQ("literal", read_string(decoded.events[5].second, pos));
+  EXPECT_EQ("string", read_string(decoded.events[5].second, pos));
+
+  // the formats are written again to a new file
+  EventLogger().create("event_log_types");
+  for (int ii = 0; ii < 3; ++ii)
+    DXTC_EVENT_LOG("iteration {}: residual {}", ii, 0.5 * ii);
+  EventLogger().deinit();
+  const auto recreated = decode(filename);
+  EXPECT_EQ(1, recreated.formats.size());
+  EXPECT_EQ(3, recreated.events.size());
+} // GTEST_TEST(EventLog, types)
+
+GTEST_TEST(EventLog, threads)
+{
+  EventLogger().create("event_log_threads");
+  const size_t num_threads = 4;
+  const size_t num_events = 10000;
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < num_threads; ++tt)
+    threads.emplace_back([=]() {
+      for (size_t ii = 0; ii < num_events; ++ii)
+        DXTC_EVENT_LOG("thread {} event {}", tt, ii);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  const std::string filename = EventLogger().filename();
+  EventLogger().deinit();
+  const auto decoded = decode(filename);
+  ASSERT_EQ(1, decoded.formats.size());
+  ASSERT_EQ(num_threads * num_events, decoded.events.size());
+  std::vector<size_t> next_event(num_threads, 0);
+  for (const auto& event : decoded.events) {
+    size_t pos = 0;
+    const auto tt = read<size_t>(event.second, pos);
+    ASSERT_LT(tt, num_threads);
+    EXPECT_EQ(next_event[tt]++, read<size_t>(event.second, pos));
+  }
+} // GTEST_TEST(EventLog, threads)
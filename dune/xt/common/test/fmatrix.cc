@@ -12,6 +12,9 @@
 
 #include <dune/xt/common/fmatrix.hh>
 #include <dune/xt/common/float_cmp.hh>
+#include <dune/xt/common/test/matrices.hh>
+
+using Dune::XT::Common::Test::reversed_triangular_matrix;
 
 GTEST_TEST(dune_xt_common_field_matrix, creation_and_calculations)
 {
@@ -281,3 +284,49 @@ GTEST_TEST(blockedfieldmatrix, creation_and_calculations)
     for (size_t jj = 0; jj < 4; ++jj)
       EXPECT_EQ(block_square_mat.get_entry(ii, jj), expected_mat[ii][jj]);
 }
+
+
+template <int N>
+void check_invert_solve_determinant()
+{
+  using MatrixType = Dune::XT::Common::FieldMatrix<double, N, N>;
+  using VectorType = Dune::XT::Common::FieldVector<double, N>;
+  const MatrixType mat = reversed_triangular_matrix<N>();
+  MatrixType inverse = mat;
+  inverse.invert();
+  for (size_t ii = 0; ii < N; ++ii)
+    for (size_t jj = 0; jj < N; ++jj) {
+      double entry = 0.;
+      for (size_t kk = 0; kk < N; ++kk)
+        entry += mat[ii][kk] * inverse[kk][jj];
+      EXPECT_NEAR(ii == jj ? 1. : 0., entry, 1e-13) << N << "x" << N;
+    }
+  VectorType expected_x;
+  for (size_t ii = 0; ii < N; ++ii)
+    expected_x[ii] = 1. - 0.1 * ii;
+  VectorType b;
+  mat.mv(expected_x, b);
+  VectorType x;
+  mat.solve(x, b);
+  for (size_t ii = 0; ii < N; ++ii)
+    EXPECT_NEAR(expected_x[ii], x[ii], 1e-13) << N << "x" << N;
+  // reversing the rows takes N / 2 swaps
+  double expected_det = ((N / 2) % 2 == 0) ? 1. : -1.;
+  for (size_t ii = 0; ii < N; ++ii)
+    expected_det *= ii + 1.;
+  EXPECT_NEAR(expected_det, mat.determinant(), 1e-12 * std::abs(expected_det)) << N << "x" << N;
+  MatrixType singular = mat;
+  singular[N - 1] = singular[0];
+  EXPECT_THROW(singular.invert(), Dune::FMatrixError);
+  EXPECT_EQ(0., singular.determinant());
+} // ... check_invert_solve_determinant(...)
+
+GTEST_TEST(dune_xt_common_field_matrix, invert_solve_determinant)
+{
+  // the unrolled (up to 8) and the generic loops
+  check_invert_solve_determinant<4>();
+  check_invert_solve_determinant<5>();
+  check_invert_solve_determinant<8>();
+  check_invert_solve_determinant<9>();
+  check_invert_solve_determinant<12>();
+}
@@ -11,8 +11,16 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/common/async_log_writer.hh>
 #include <dune/xt/common/logging.hh>
 #include <dune/xt/common/logstreams.hh>
+#include <dune/xt/common/rank_log_aggregator.hh>
 
 void balh(std::ostream& out)
 {
@@ -70,3 +78,227 @@ GTEST_TEST(LoggerTest, file)
   Logger().create(LOG_INFO | LOG_CONSOLE | LOG_FILE, "test_common_logger", "", "");
   Logger().info() << "This output should be in 'test_common_logger.log'" << std::endl;
 }
+
+GTEST_TEST(LogStream, complete_lines)
+{
+  using namespace Dune::XT::Common;
+  int logflags = LOG_INFO;
+  std::stringstream out;
+  {
+    OstreamLogStream stream(LOG_INFO, logflags, out);
+    std::vector<std::thread> threads;
+    for (size_t tt = 0; tt < 4; ++tt)
+      threads.emplace_back([&, tt]() {
+        for (size_t ii = 0; ii < 100; ++ii) {
+          stream << "thread " << tt << ' ' << "line " << ii << '\n';
+          if (ii % 10 == 0)
+            stream << std::flush;
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    stream << "incomplete";
+  }
+  std::vector<size_t> next(4, 0);
+  std::string line;
+  size_t lines = 0;
+  while (std::getline(out, line) && line != "incomplete") {
+    std::stringstream words(line);
+    std::string thread_word, line_word;
+    size_t tt, ii;
+    ASSERT_TRUE(bool(words >> thread_word >> tt >> line_word >> ii)) << line;
+    ASSERT_EQ("thread", thread_word);
+    ASSERT_EQ("line", line_word);
+    ASSERT_LT(tt, 4);
+    EXPECT_EQ(next[tt]++, ii);
+    ++lines;
+  }
+  EXPECT_EQ(400, lines);
+  EXPECT_EQ("incomplete", line);
+}
+
+GTEST_TEST(LogStream, incomplete_lines_of_other_threads)
+{
+  using namespace Dune::XT::Common;
+  int logflags = LOG_INFO;
+  std::stringstream out;
+  {
+    OstreamLogStream stream(LOG_INFO, logflags, out);
+    std::promise<void> started, synced;
+    std::thread other([&]() {
+      stream << "other thread, ";
+      started.set_value();
+      synced.get_future().wait();
+      stream << "whole line" << std::endl;
+    });
+    started.get_future().wait();
+    stream << "main thread" << std::flush;
+    // the incomplete line of the other thread is not written, it may still be continued
+    EXPECT_EQ("main thread", out.str());
+    stream << std::endl;
+    synced.set_value();
+    other.join();
+    std::thread([&]() { stream << "unterminated"; }).join();
+  }
+  // once the stream is closed, the incomplete lines of all threads are written
+  EXPECT_EQ("main thread\nother thread, whole line\nunterminated\n", out.str());
+}
+
+GTEST_TEST(AsyncLogWriter, order_and_flush)
+{
+  using namespace Dune::XT::Common;
+  std::stringstream first, second;
+  AsyncLogWriter writer(4);
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < 4; ++tt)
+    threads.emplace_back([&, tt]() {
+      for (size_t ii = 0; ii < 100; ++ii)
+        writer.write(tt % 2 ? first : second, std::to_string(tt) + " " + std::to_string(ii) + "\n");
+    });
+  for (auto& thread : threads)
+    thread.join();
+  writer.flush();
+  EXPECT_EQ(0, writer.dropped());
+  // the records of each thread appear in the order they were written
+  std::vector<size_t> last(4, 0);
+  size_t lines = 0;
+  for (auto* stream : {&first, &second}) {
+    size_t tt, ii;
+    while (*stream >> tt >> ii) {
+      EXPECT_EQ(last[tt], ii);
+      last[tt] = ii + 1;
+      ++lines;
+    }
+  }
+  EXPECT_EQ(400, lines);
+}
+
+GTEST_TEST(AsyncLogWriter, overflow)
+{
+  using namespace Dune::XT::Common;
+  std::stringstream out;
+  {
+    AsyncLogWriter writer(2, AsyncLogOverflow::count);
+    size_t written = 0;
+    for (size_t ii = 0; ii < 10000; ++ii)
+      written += writer.write(out, "record\n");
+    writer.flush();
+    EXPECT_EQ(10000, written + writer.dropped());
+    const bool dropped_some = writer.dropped() > 0;
+    while (!writer.write(out, "last\n"))
+      writer.flush();
+    writer.flush();
+    if (dropped_some)
+      EXPECT_NE(std::string::npos, out.str().find("log records were dropped"));
+  }
+  EXPECT_EQ("last\n", out.str().substr(out.str().size() - 5));
+}
+
+GTEST_TEST(AsyncLogWriter, drops_are_noted_per_stream)
+{
+  using namespace Dune::XT::Common;
+  std::stringstream first;
+  std::stringstream second;
+  size_t dropped_first = 0;
+  {
+    AsyncLogWriter writer(2, AsyncLogOverflow::count);
+    for (size_t ii = 0; ii < 10000; ++ii)
+      dropped_first += !writer.write(first, "record\n");
+    writer.flush();
+    while (!writer.write(second, "second\n"))
+      writer.flush();
+    writer.flush();
+  }
+  // all drops are noted in the stream they were meant for
+  size_t noted = 0;
+  std::string line;
+  while (std::getline(first, line))
+    if (line.front() == '[')
+      noted += std::stoul(line.substr(1));
+  EXPECT_EQ(dropped_first, noted);
+  EXPECT_EQ("second\n", second.str());
+}
+
+GTEST_TEST(LoggerTest, async)
+{
+  using namespace Dune::XT::Common;
+  Logger().create(LOG_INFO | LOG_CONSOLE);
+  Logger().enable_async();
+  for (size_t ii = 0; ii < 4; ++ii)
+    Logger().info() << "this line was written by the background thread " << ii << std::endl;
+  Logger().flush();
+  EXPECT_EQ(0, Logger().dropped_records());
+  Logger().disable_async();
+  Logger().info() << "this line was written synchronously" << std::endl;
+}
+
+GTEST_TEST(RankLogAggregator, format)
+{
+  using namespace Dune::XT::Common;
+  EXPECT_EQ("0-3,5,7-8", internal::format_rank_ranges({0, 1, 2, 3, 5, 7, 8}));
+  EXPECT_EQ("4", internal::format_rank_ranges({4}));
+  const std::vector<internal::RankLogEntry> entries{{0.5, 0, "start\n"},
+                                                    {0.5, 1, "start\n"},
+                                                    {1., 1, "warning\nstart\n"},
+                                                    {1.5, 0, "done"},
+                                                    {1.5, 2, "start\ndone\n"}};
+  EXPECT_EQ("[    0.500s|r0-2] start\n"
+            "[    1.000s|r1] warning\n"
+            "[    1.000s|r1] start\n"
+            "[    1.500s|r0,2] done\n",
+            internal::format_rank_log_entries(entries));
+}
+
+GTEST_TEST(RankLogAggregator, serial)
+{
+  using namespace Dune::XT::Common;
+  std::stringstream out;
+  {
+    RankLogAggregator aggregator({&out});
+    EXPECT_EQ(0, aggregator.rank());
+    aggregator.add("first\n");
+    // a single rank has nothing to wait for
+    EXPECT_NE(std::string::npos, out.str().find("|r0] first\n"));
+    aggregator.add("second\n");
+    aggregator.finish();
+    aggregator.add("after finish\n");
+  }
+  const auto lines = out.str();
+  EXPECT_LT(lines.find("|r0] second\n"), lines.find("|r0] after finish\n"));
+}
+
+GTEST_TEST(LoggerTest, rank_aggregation)
+{
+  using namespace Dune::XT::Common;
+  Logger().create(LOG_INFO | LOG_CONSOLE | LOG_FILE, "test_common_rank_aggregation", "", "");
+  Logger().enable_rank_aggregation();
+  DXTC_LOG_INFO_0 << "this line was aggregated on rank 0" << std::endl;
+  Logger().debug() << "this line should not be visible" << std::endl;
+  Logger().disable_rank_aggregation();
+  Logger().info() << "this line was written directly" << std::endl;
+  Logger().flush();
+  std::ifstream file("test_common_rank_aggregation.log");
+  const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_NE(std::string::npos, contents.find("|r0] this line was aggregated on rank 0\n"));
+  EXPECT_EQ(std::string::npos, contents.find("not be visible"));
+  EXPECT_NE(std::string::npos, contents.find("\nthis line was written directly\n"));
+}
+
+GTEST_TEST(LoggerTest, rotation)
+{
+  using namespace Dune::XT::Common;
+  Logger().create(LOG_INFO | LOG_FILE, "test_common_rotation", "", "");
+  Logger().enable_rotation({0, 0, 0, LogCompression::none});
+  EXPECT_FALSE(boost::filesystem::exists("test_common_rotation.log"));
+  Logger().info() << "this line was rotated" << std::endl;
+  Logger().flush();
+  std::ifstream file("test_common_rotation.0000.log");
+  const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_EQ("this line was rotated\n", contents);
+  Logger().disable_rotation();
+  Logger().info() << "this line was written directly" << std::endl;
+  Logger().flush();
+  std::ifstream plain_file("test_common_rotation.log");
+  const std::string plain_contents((std::istreambuf_iterator<char>(plain_file)), std::istreambuf_iterator<char>());
+  EXPECT_EQ("this line was written directly\n", plain_contents);
+}
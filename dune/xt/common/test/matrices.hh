@@ -0,0 +1,56 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_COMMON_TEST_MATRICES_HH
+#define DUNE_XT_COMMON_TEST_MATRICES_HH
+
+#include <cstddef>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/xt/common/fmatrix.hh>
+
+namespace Dune {
+namespace XT {
+namespace Common {
+namespace Test {
+
+
+//! a matrix of small integers in [-5, 5], so that products of such matrices are exact in floating point arithmetic
+template <class K>
+Dune::DynamicMatrix<K> create_dynamic_matrix(const size_t rows, const size_t cols, const size_t seed)
+{
+  Dune::DynamicMatrix<K> ret(rows, cols, K(0));
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      ret[ii][jj] = K((7 * ii + 3 * jj + seed) % 11) - K(5);
+  return ret;
+}
+
+/**
+ * An upper triangular matrix with the diagonal 1, ..., N and its rows in reversed order, so that every step of the LU
+ * decomposition has to pivot.
+ */
+template <int N>
+Dune::XT::Common::FieldMatrix<double, N, N> reversed_triangular_matrix()
+{
+  Dune::XT::Common::FieldMatrix<double, N, N> ret(0.);
+  for (size_t ii = 0; ii < N; ++ii) {
+    ret[N - 1 - ii][ii] = ii + 1.;
+    for (size_t jj = ii + 1; jj < N; ++jj)
+      ret[N - 1 - ii][jj] = 0.5 / (1. + ii + jj);
+  }
+  return ret;
+}
+
+
+} // namespace Test
+} // namespace Common
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_COMMON_TEST_MATRICES_HH
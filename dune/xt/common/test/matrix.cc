@@ -13,6 +13,11 @@
 
 #include <dune/xt/common/matrix.hh>
 #include <dune/xt/common/fmatrix.hh>
+#include <dune/xt/common/gemm.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/common/test/matrices.hh>
+
+using Dune::XT::Common::Test::create_dynamic_matrix;
 
 using MatrixTypes =
     ::testing::Types<std::tuple<Dune::FieldMatrix<int, 1, 1>, Int<1>, Int<1>>,
@@ -133,3 +138,72 @@ TYPED_TEST(SerializeRowwiseTest, double)
 {
   this->template check_type<double>();
 }
+
+
+template <class K>
+void check_dynamic_matrix_product(const size_t m, const size_t k, const size_t n)
+{
+  const auto lhs = create_dynamic_matrix<K>(m, k, 1);
+  const auto rhs = create_dynamic_matrix<K>(k, n, 2);
+  const auto product = lhs * rhs;
+  ASSERT_EQ(m, product.rows());
+  ASSERT_EQ(n, product.cols());
+  for (size_t ii = 0; ii < m; ++ii)
+    for (size_t jj = 0; jj < n; ++jj) {
+      K expected(0);
+      for (size_t kk = 0; kk < k; ++kk)
+        expected += lhs[ii][kk] * rhs[kk][jj];
+      // all entries are small integers, so the result is exact regardless of the order of summation
+      ASSERT_EQ(expected, product[ii][jj]) << "m = " << m << ", k = " << k << ", n = " << n << ", entry " << ii << ", "
+                                           << jj;
+    }
+}
+
+GTEST_TEST(DynamicMatrixProductTest, matches_naive_product)
+{
+  check_dynamic_matrix_product<int>(2, 3, 4);
+  check_dynamic_matrix_product<double>(1, 1, 1);
+  check_dynamic_matrix_product<double>(7, 13, 5);
+  // not multiples of the block sizes
+  check_dynamic_matrix_product<double>(101, 300, 97);
+  check_dynamic_matrix_product<float>(37, 513, 70);
+  check_dynamic_matrix_product<long>(200, 41, 19);
+  EXPECT_THROW(create_dynamic_matrix<double>(2, 3, 0) * create_dynamic_matrix<double>(2, 3, 0),
+               Dune::XT::Common::Exceptions::shapes_do_not_match);
+}
+
+#if HAVE_TBB
+GTEST_TEST(DynamicMatrixProductTest, matches_naive_product_in_chunks)
+{
+  // gemm splits the rows into chunks of whole row blocks if n * k >= kc * kc and several threads are allowed
+  typedef Dune::XT::Common::internal::GemmBlocking<double> B;
+  auto& thread_manager = Dune::XT::Common::threadManager();
+  const size_t max_threads = thread_manager.max_threads();
+  thread_manager.set_max_threads(3);
+  // 4 row blocks, the last one only partially filled, for 3 chunks of different sizes
+  check_dynamic_matrix_product<double>(3 * B::mc + 37, B::kc + 44, B::kc - 26);
+  thread_manager.set_max_threads(max_threads);
+}
+#endif // HAVE_TBB
+
+GTEST_TEST(DynamicMatrixProductTest, gemm_with_leading_dimensions)
+{
+  // multiply the upper left 5x6 and 6x3 blocks of larger matrices into a block of a larger matrix
+  std::vector<double> a(8 * 9), b(7 * 4), c(6 * 10, -1.);
+  for (size_t ii = 0; ii < a.size(); ++ii)
+    a[ii] = double(ii % 5);
+  for (size_t ii = 0; ii < b.size(); ++ii)
+    b[ii] = double(ii % 3) - 1.;
+  Dune::XT::Common::gemm(5, 3, 6, a.data(), 9, b.data(), 4, c.data(), 10);
+  Dune::XT::Common::gemm(5, 3, 6, a.data(), 9, b.data(), 4, c.data() + 5, 10);
+  for (size_t ii = 0; ii < 6; ++ii)
+    for (size_t jj = 0; jj < 10; ++jj) {
+      double expected = -1.;
+      if (ii < 5 && (jj < 3 || (jj >= 5 && jj < 8))) {
+        expected = 0.;
+        for (size_t kk = 0; kk < 6; ++kk)
+          expected += a[ii * 9 + kk] * b[kk * 4 + (jj % 5)];
+      }
+      EXPECT_EQ(expected, c[ii * 10 + jj]) << ii << ", " << jj;
+    }
+}
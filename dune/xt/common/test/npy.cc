@@ -0,0 +1,158 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx>
+
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <dune/xt/common/fmatrix.hh>
+#include <dune/xt/common/fvector.hh>
+#include <dune/xt/common/npy.hh>
+
+using namespace Dune::XT::Common;
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+GTEST_TEST(Npy, header)
+{
+  write_npy("npy_header.npy", std::vector<double>{1., 2., 3.});
+  const auto contents = read_file("npy_header.npy");
+  ASSERT_EQ(128 + 3 * sizeof(double), contents.size());
+  EXPECT_EQ(std::string("\x93NUMPY\x01\x00", 8), contents.substr(0, 8));
+  EXPECT_EQ('\n', contents[127]);
+  // the length of the header, little endian
+  EXPECT_EQ(char(118), contents[8]);
+  EXPECT_EQ('\0', contents[9]);
+  const std::string written_dict = "{'descr': '<f8', 'fortran_order': False, 'shape': (3,), }";
+  EXPECT_EQ(written_dict, contents.substr(10, written_dict.size()));
+  const auto header = internal::read_npy_header(contents.data(), contents.data() + contents.size(), "npy_header");
+  EXPECT_EQ("<f8", header.descr);
+  EXPECT_FALSE(header.fortran_order);
+  EXPECT_EQ(std::vector<size_t>{3}, header.shape);
+  EXPECT_EQ(128, header.data_offset);
+  // as written by numpy 1.x
+  const std::string dict = "{'descr': '<i4', 'fortran_order': True, 'shape': (2, 3), }";
+  const std::string numpy_header = std::string("\x93NUMPY\x01\x00", 8) + char(dict.size() + 1) + '\0' + dict + "\n";
+  // followed by the 2 x 3 4-byte integers
+  const std::string numpy_contents = numpy_header + std::string(24, '\0');
+  const auto parsed = internal::read_npy_header(
+      numpy_contents.data(), numpy_contents.data() + numpy_contents.size(), "numpy_header");
+  EXPECT_EQ("<i4", parsed.descr);
+  EXPECT_TRUE(parsed.fortran_order);
+  EXPECT_EQ(std::vector<size_t>({2, 3}), parsed.shape);
+  EXPECT_EQ(numpy_header.size(), parsed.data_offset);
+  std::remove("npy_header.npy");
+}
+
+GTEST_TEST(Npy, vectors)
+{
+  const std::vector<double> vec{1., -2.5, 3e10};
+  write_npy("npy_vectors.npy", vec);
+  EXPECT_EQ(vec, read_npy<std::vector<double>>("npy_vectors.npy"));
+  const auto dynamic_vector = read_npy<Dune::DynamicVector<double>>("npy_vectors.npy");
+  EXPECT_EQ(-2.5, dynamic_vector[1]);
+  const auto field_vector = read_npy<FieldVector<float, 3>>("npy_vectors.npy");
+  EXPECT_EQ(-2.5f, field_vector[1]);
+  EXPECT_THROW((read_npy<FieldVector<double, 2>>("npy_vectors.npy")), Dune::IOError);
+  EXPECT_THROW(read_npy<std::vector<std::complex<double>>>("npy_vectors.npy"), Dune::IOError);
+  write_npy("npy_vectors.npy", std::vector<std::int16_t>{-1, 2});
+  EXPECT_EQ(std::vector<double>({-1., 2.}), read_npy<std::vector<double>>("npy_vectors.npy"));
+  write_npy("npy_vectors.npy", std::vector<std::complex<double>>{{1., 2.}});
+  EXPECT_EQ(std::complex<double>(1., 2.), read_npy<std::vector<std::complex<double>>>("npy_vectors.npy")[0]);
+  write_npy("npy_vectors.npy", std::vector<double>());
+  EXPECT_TRUE(read_npy<std::vector<double>>("npy_vectors.npy").empty());
+  std::remove("npy_vectors.npy");
+}
+
+GTEST_TEST(Npy, matrices)
+{
+  Dune::DynamicMatrix<double> dynamic_matrix(2, 3);
+  for (size_t ii = 0; ii < 2; ++ii)
+    for (size_t jj = 0; jj < 3; ++jj)
+      dynamic_matrix[ii][jj] = 10. * ii + jj;
+  write_npy("npy_matrices.npy", dynamic_matrix);
+  EXPECT_EQ(dynamic_matrix, read_npy<Dune::DynamicMatrix<double>>("npy_matrices.npy"));
+  const auto field_matrix = read_npy<FieldMatrix<double, 2, 3>>("npy_matrices.npy");
+  EXPECT_EQ(12., field_matrix[1][2]);
+  EXPECT_THROW((read_npy<FieldMatrix<double, 3, 2>>("npy_matrices.npy")), Dune::IOError);
+  EXPECT_THROW(read_npy<std::vector<double>>("npy_matrices.npy"), Dune::IOError);
+  write_npy("npy_matrices.npy", field_matrix);
+  EXPECT_EQ(dynamic_matrix, read_npy<Dune::DynamicMatrix<double>>("npy_matrices.npy"));
+  std::remove("npy_matrices.npy");
+}
+
+GTEST_TEST(Npy, fortran_order)
+{
+  // [[0, 1, 2], [10, 11, 12]] in column major order
+  std::string contents = internal::npy_header("<f8", true, {2, 3});
+  for (const double value : {0., 10., 1., 11., 2., 12.})
+    contents.append(reinterpret_cast<const char*>(&value), sizeof(double));
+  {
+    std::ofstream file("npy_fortran_order.npy", std::ios::binary);
+    file << contents;
+  }
+  const auto matrix = read_npy<Dune::DynamicMatrix<double>>("npy_fortran_order.npy");
+  EXPECT_EQ(10., matrix[1][0]);
+  EXPECT_EQ(2., matrix[0][2]);
+  const auto field_matrix = read_npy<FieldMatrix<double, 2, 3>>("npy_fortran_order.npy");
+  EXPECT_EQ(11., field_matrix[1][1]);
+  const MappedNpyArray<double> mapped("npy_fortran_order.npy");
+  EXPECT_TRUE(mapped.fortran_order());
+  EXPECT_EQ(12., mapped(1, 2));
+  std::remove("npy_fortran_order.npy");
+}
+
+GTEST_TEST(Npy, mapped)
+{
+  const size_t rows = 1000;
+  Dune::DynamicMatrix<double> matrix(rows, 4);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < 4; ++jj)
+      matrix[ii][jj] = ii - 0.5 * jj;
+  write_npy("npy_mapped.npy", matrix);
+  const MappedNpyArray<double> mapped("npy_mapped.npy");
+  ASSERT_EQ(std::vector<size_t>({rows, 4}), mapped.shape());
+  EXPECT_EQ(4 * rows, mapped.size());
+  EXPECT_EQ(0., reinterpret_cast<std::uintptr_t>(mapped.data()) % 64);
+  EXPECT_EQ(matrix[rows - 1][3], mapped(rows - 1, 3));
+  EXPECT_EQ(matrix[7][1], mapped.data()[4 * 7 + 1]);
+  EXPECT_THROW(MappedNpyArray<float>("npy_mapped.npy"), Dune::IOError);
+  std::remove("npy_mapped.npy");
+}
+
+GTEST_TEST(Npy, errors)
+{
+  {
+    std::ofstream file("npy_errors.npy", std::ios::binary);
+    file << "x,y\n1,2\n";
+  }
+  EXPECT_THROW(read_npy<std::vector<double>>("npy_errors.npy"), Dune::IOError);
+  {
+    std::ofstream file("npy_errors.npy", std::ios::binary);
+    file << internal::npy_header("<f8", false, {10}) << "truncated";
+  }
+  EXPECT_THROW(read_npy<std::vector<double>>("npy_errors.npy"), Dune::IOError);
+  {
+    std::ofstream file("npy_errors.npy", std::ios::binary);
+    file << internal::npy_header(internal::npy_little_endian() ? ">f8" : "<f8", false, {1}) << "12345678";
+  }
+  EXPECT_THROW(read_npy<std::vector<double>>("npy_errors.npy"), Dune::IOError);
+  std::remove("npy_errors.npy");
+  EXPECT_THROW(read_npy<std::vector<double>>("npy_errors.npy"), Dune::IOError);
+}
@@ -0,0 +1,131 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#if HAVE_ZLIB
+#  include <zlib.h>
+#endif
+
+#include <dune/xt/common/rotating_log_file.hh>
+
+using namespace Dune::XT::Common;
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+GTEST_TEST(RotatingLogFile, size)
+{
+  for (size_t ii = 0; ii < 5; ++ii)
+    boost::filesystem::remove("rotating_log_file_size.000" + std::to_string(ii) + ".log");
+  {
+    RotatingLogFile file("rotating_log_file_size.log", {98, 0, 3, LogCompression::none});
+    EXPECT_EQ("rotating_log_file_size.0000.log", file.current_filename());
+    for (size_t ii = 0; ii < 10; ++ii) {
+      file << "line " << ii << ": " << std::string(40, 'x') << std::endl;
+      // each line is written as a chunk of its own, each file gets two of them
+      file.write_out();
+    }
+    EXPECT_EQ(std::string("line 9: ") + std::string(40, 'x') + "\n",
+              read_file("rotating_log_file_size.0004.log").substr(49));
+  }
+  EXPECT_FALSE(boost::filesystem::exists("rotating_log_file_size.0000.log"));
+  EXPECT_FALSE(boost::filesystem::exists("rotating_log_file_size.0001.log"));
+  for (size_t ii = 2; ii < 5; ++ii) {
+    const auto contents = read_file("rotating_log_file_size.000" + std::to_string(ii) + ".log");
+    EXPECT_EQ("line " + std::to_string(2 * ii) + ": ", contents.substr(0, 8));
+    EXPECT_EQ(98, contents.size());
+  }
+  EXPECT_FALSE(boost::filesystem::exists("rotating_log_file_size.0005.log"));
+} // GTEST_TEST(RotatingLogFile, size)
+
+GTEST_TEST(RotatingLogFile, threads)
+{
+  const size_t num_threads = 4;
+  const size_t num_lines = 20000;
+  std::string last_filename;
+  {
+    RotatingLogFile file("rotating_log_file_threads.log", {1 << 18, 0, 0, LogCompression::none});
+    std::vector<std::thread> threads;
+    for (size_t tt = 0; tt < num_threads; ++tt)
+      threads.emplace_back([&, tt]() {
+        for (size_t ii = 0; ii < num_lines; ++ii) {
+          const std::string line = "thread " + std::to_string(tt) + " line " + std::to_string(ii) + "\n";
+          file.write(line.data(), line.size());
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    last_filename = file.current_filename();
+  }
+  std::vector<size_t> next_line(num_threads, 0);
+  size_t files = 0;
+  for (size_t ii = 0;; ++ii) {
+    const std::string filename = "rotating_log_file_threads." + std::string(ii < 10 ? "000" : "00")
+                                 + std::to_string(ii) + ".log";
+    if (!boost::filesystem::exists(filename))
+      break;
+    ++files;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+      size_t tt = 0;
+      size_t nn = 0;
+      ASSERT_EQ(2, std::sscanf(line.c_str(), "thread %zu line %zu", &tt, &nn)) << line;
+      ASSERT_LT(tt, num_threads);
+      EXPECT_EQ(next_line[tt]++, nn);
+    }
+  }
+  EXPECT_GT(files, 1);
+  for (const auto& lines : next_line)
+    EXPECT_EQ(num_lines, lines);
+} // GTEST_TEST(RotatingLogFile, threads)
+
+GTEST_TEST(RotatingLogFile, compression)
+{
+  EXPECT_TRUE(log_compression_available(LogCompression::none));
+  EXPECT_TRUE(log_compression_available(LogCompression::best_available));
+  EXPECT_EQ(HAVE_ZLIB, log_compression_available(LogCompression::gzip));
+  EXPECT_EQ(HAVE_ZSTD, log_compression_available(LogCompression::zstd));
+  if (!HAVE_ZLIB) {
+    EXPECT_THROW(RotatingLogFile("rotating_log_file_gzip.log", {0, 0, 0, LogCompression::gzip}),
+                 Dune::NotImplemented);
+    return;
+  }
+#if HAVE_ZLIB
+  std::string expected;
+  {
+    RotatingLogFile file("rotating_log_file_gzip.log", {0, 0, 0, LogCompression::gzip});
+    EXPECT_EQ("rotating_log_file_gzip.0000.log.gz", file.current_filename());
+    for (size_t ii = 0; ii < 10000; ++ii) {
+      const std::string line = "line " + std::to_string(ii) + "\n";
+      file << line;
+      expected += line;
+    }
+  }
+  EXPECT_LT(boost::filesystem::file_size("rotating_log_file_gzip.0000.log.gz"), expected.size() / 4);
+  gzFile compressed = gzopen("rotating_log_file_gzip.0000.log.gz", "rb");
+  ASSERT_NE(nullptr, compressed);
+  std::string decompressed(2 * expected.size(), '\0');
+  const int size = gzread(compressed, &decompressed[0], static_cast<unsigned>(decompressed.size()));
+  gzclose(compressed);
+  ASSERT_GE(size, 0);
+  decompressed.resize(size);
+  EXPECT_EQ(expected, decompressed);
+#endif // HAVE_ZLIB
+} // GTEST_TEST(RotatingLogFile, compression)
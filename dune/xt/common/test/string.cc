@@ -11,6 +11,13 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <clocale>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <system_error>
 #include <vector>
 
 #include <dune/common/fmatrix.hh>
@@ -148,6 +155,122 @@ GTEST_TEST(StringTest, ConvertFrom)
   EXPECT_EQ(Complex(0, -1), from_string<Complex>("0-1i"));
 }
 
+GTEST_TEST(StringTest, ParseNumber)
+{
+  const std::string input = " +12.5e1 rest";
+  double value = 0;
+  const char* end = nullptr;
+  EXPECT_EQ(std::errc(), internal::parse_number(input.data(), input.data() + input.size(), value, &end));
+  EXPECT_EQ(125., value);
+  EXPECT_EQ(" rest", std::string(end));
+  int integer = 7;
+  EXPECT_EQ(std::errc::invalid_argument, internal::parse_number(input.data() + 9, input.data() + 13, integer));
+  EXPECT_EQ(7, integer);
+  const std::string too_large = "99999999999";
+  EXPECT_EQ(std::errc::result_out_of_range,
+            internal::parse_number(too_large.data(), too_large.data() + too_large.size(), integer));
+  EXPECT_EQ(8., from_string<double>("0x1p3"));
+  EXPECT_EQ(-8., from_string<double>("-0x1p3"));
+  EXPECT_TRUE(std::isinf(from_string<double>("inf")));
+  EXPECT_EQ(42u, from_string<unsigned int>("\t42"));
+  EXPECT_THROW(from_string<unsigned int>("-1"), Exceptions::conversion_error);
+  EXPECT_THROW(from_string<unsigned long>("-1"), Exceptions::conversion_error);
+  EXPECT_THROW(from_string<int>("+-1"), Exceptions::conversion_error);
+  EXPECT_THROW(from_string<int>("99999999999"), Exceptions::conversion_error);
+  EXPECT_THROW(from_string<double>("abc"), Exceptions::conversion_error);
+  const std::string buffer = "1.5 2 true";
+  EXPECT_EQ(2, from_string<int>(std::string(buffer, 4, 1)));
+#if __cplusplus >= 201703L
+  const std::string_view view(buffer);
+  EXPECT_EQ(1.5, from_string<double>(view.substr(0, 3)));
+  EXPECT_EQ(true, from_string<bool>(view.substr(6)));
+  EXPECT_EQ("[1 2]", to_string(from_string<std::vector<int>>(std::string_view("[1 2]"))));
+#endif
+}
+
+GTEST_TEST(StringTest, ParseNumberIgnoresLocale)
+{
+  const std::string previous_locale = std::setlocale(LC_ALL, nullptr);
+  const char* locale = nullptr;
+  for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR"})
+    if ((locale = std::setlocale(LC_ALL, name)))
+      break;
+  if (!locale) {
+    std::cerr << "no locale with ',' as decimal point available, skipping" << std::endl;
+    return;
+  }
+  // the numbers are read as in the "C" locale, although the current one uses ',' as decimal point
+  EXPECT_EQ(1.5, from_string<double>("1.5"));
+  EXPECT_EQ(1.5f, from_string<float>("1.5"));
+  EXPECT_EQ(0.25L, from_string<long double>("2.5e-1"));
+  EXPECT_EQ(1., from_string<double>("1,5"));
+  EXPECT_EQ(-12, from_string<int>("-12"));
+  EXPECT_EQ(12345u, from_string<unsigned int>("12345"));
+  std::setlocale(LC_ALL, previous_locale.c_str());
+}
+
+GTEST_TEST(StringTest, FormatNumber)
+{
+  const std::vector<double> values = {
+      0., -0., 1., -1.5, 0.1, 1. / 3., 1e-5, 123456., 1234567., 1e300, -2.5e-300, 4.9e-324, 1e22};
+  for (const auto& value : values) {
+    for (const size_t precision : {size_t(1), size_t(6), size_t(15), size_t(17), size_t(25)}) {
+      std::ostringstream expected;
+      expected << std::setprecision(int(precision)) << value;
+      EXPECT_EQ(expected.str(), to_string(value, precision));
+    }
+    EXPECT_EQ(value, from_string<double>(to_string(value, round_trip_to_string_precision)));
+  }
+  EXPECT_EQ("0.1", to_string(0.1, round_trip_to_string_precision));
+  EXPECT_EQ("0.30000000000000004", to_string(0.1 + 0.2, round_trip_to_string_precision));
+  EXPECT_EQ("0.1", to_string(0.1f, round_trip_to_string_precision));
+  EXPECT_EQ("-9223372036854775808", to_string(std::numeric_limits<long long>::min()));
+  EXPECT_EQ("18446744073709551615", to_string(std::numeric_limits<unsigned long long>::max()));
+  EXPECT_EQ("inf", to_string(std::numeric_limits<double>::infinity()));
+  EXPECT_EQ("1", to_string(true));
+  std::string out = "x = ";
+  append_to_string(out, 2.5);
+  append_to_string(out, std::vector<int>{1, 2});
+  EXPECT_EQ("x = 2.5[1 2]", out);
+  EXPECT_EQ("[[1 2] [3 4]]", to_string(std::vector<std::vector<int>>{{1, 2}, {3, 4}}));
+  EXPECT_EQ("[0.333333 1]", to_string(Dune::DynamicVector<double>{1. / 3., 1.}));
+  EXPECT_EQ("[0.3333333333333333 1]",
+            to_string(Dune::DynamicVector<double>{1. / 3., 1.}, round_trip_to_string_precision));
+}
+
+GTEST_TEST(StringTest, ParseExpressions)
+{
+  typedef Dune::DynamicMatrix<double> MatrixType;
+  typedef Dune::DynamicVector<double> VectorType;
+  EXPECT_EQ("[1 2; 3 4]", to_string(from_string<MatrixType>("[1  2;;  3 4\t]")));
+  EXPECT_EQ("[1; 3]", to_string(from_string<MatrixType>("[1 2; 3 4 5]", 0, 1)));
+  EXPECT_EQ("[1 2]", to_string(from_string<MatrixType>("[1 2; 3 4 5]", 1)));
+  EXPECT_EQ("[1 2 3]", to_string(from_string<VectorType>("[1 2\t  3]")));
+  EXPECT_EQ("[2 2 2]", to_string(from_string<VectorType>(" 2 ", 3)));
+  EXPECT_EQ("[1 2]", to_string(from_string<FieldVector<double, 2>>("[1 2 3]")));
+  EXPECT_THROW(from_string<VectorType>("[1 2;3]"), Exceptions::conversion_error);
+  EXPECT_THROW(from_string<MatrixType>("[1 2; 3 4]", 3), Exceptions::conversion_error);
+  try {
+    from_string<MatrixType>("[1 2; 3 x]");
+    FAIL() << "the expression contains an invalid entry";
+  } catch (const Exceptions::conversion_error& ee) {
+    EXPECT_NE(std::string::npos, std::string(ee.what()).find("row 1, column 1"));
+  }
+  std::string expression = "[";
+  for (size_t rr = 0; rr < 50; ++rr) {
+    expression += (rr > 0) ? "; " : "";
+    for (size_t cc = 0; cc < 40; ++cc) {
+      expression += (cc > 0) ? " " : "";
+      append_to_string(expression, rr * 40. + cc + 0.5);
+    }
+  }
+  expression += "]";
+  const auto matrix = from_string<MatrixType>(expression);
+  EXPECT_EQ(50, matrix.rows());
+  EXPECT_EQ(40, matrix.cols());
+  EXPECT_EQ(1234.5, matrix[30][34]);
+}
+
 // Hex, whitespacify, tokenize, stringFromTime tests
 GTEST_TEST(StringTest, Hex)
 {
@@ -183,6 +306,33 @@ GTEST_TEST(StringTest, Tokenizer)
   EXPECT_EQ(numbers_compressed, tokenize<int>(num_msg, seps, boost::algorithm::token_compress_on));
 }
 
+GTEST_TEST(StringTest, LazyTokenizer)
+{
+  const std::vector<std::string> messages = {"", ";", "a", "a t\tkk;;g", ";;a;b;;", "  a  ", "-1 2;;4", "\t\t"};
+  for (const auto& msg : messages) {
+    for (const std::string separators : {" ", ";", " \t;"}) {
+      for (const auto mode : {boost::algorithm::token_compress_off, boost::algorithm::token_compress_on}) {
+        std::vector<std::string> expected;
+        boost::algorithm::split(expected, msg, boost::algorithm::is_any_of(separators), mode);
+        std::vector<std::string> actual;
+        for (const auto& token : lazy_tokenize(msg, separators, mode))
+          actual.emplace_back(token.data(), token.size());
+        EXPECT_EQ(expected, actual) << "'" << msg << "' split along '" << separators << "'";
+        EXPECT_EQ(expected, tokenize(msg, separators, mode));
+      }
+    }
+  }
+  std::vector<double> numbers;
+  numbers.reserve(4);
+  const auto* data = numbers.data();
+  EXPECT_EQ(3, tokenize_into<double>("1.5 -2  3e1", " ", numbers, boost::algorithm::token_compress_on));
+  EXPECT_EQ(std::vector<double>({1.5, -2., 30.}), numbers);
+  EXPECT_EQ(4, tokenize_into<double>("1;;2;", ";", numbers));
+  EXPECT_EQ(std::vector<double>({1., 0., 2., 0.}), numbers);
+  EXPECT_EQ(data, numbers.data());
+  EXPECT_THROW(tokenize_into<int>("1 a", " ", numbers), Exceptions::conversion_error);
+}
+
 GTEST_TEST(StringTest, TimeString)
 {
   string ts = stringFromTime(-1);
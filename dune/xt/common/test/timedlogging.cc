@@ -15,6 +15,12 @@
 
 #include "config.h"
 
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <dune/xt/common/test/gtest/gtest.h>
 #include <dune/xt/common/timedlogging.hh>
 
@@ -100,6 +106,159 @@ GTEST_TEST(TimedLogger, fool_level_tracking)
   fool_level_tracking();
 }
 
+GTEST_TEST(TimedLogger, threads)
+{
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < 4; ++tt)
+    threads.emplace_back([tt]() {
+      auto logger = TimedLogger().get("thread_" + to_string(tt));
+      for (size_t ii = 0; ii < 10; ++ii)
+        logger.info() << "line " << ii << " of thread " << tt << " should not be mixed with other lines" << std::endl;
+    });
+  for (auto& thread : threads)
+    thread.join();
+}
+
+GTEST_TEST(TimedLogger, enabled_checks)
+{
+  auto logger = TimedLogger().get("enabled_checks");
+  size_t evaluations = 0;
+  const auto evaluate = [&]() { return ++evaluations; };
+  DXTC_TIMEDLOG_INFO(logger) << "evaluated " << evaluate() << " time" << std::endl;
+  DXTC_TIMEDLOG_DEBUG(logger) << "evaluated " << evaluate() << " times" << std::endl;
+  DXTC_TIMEDLOG_WARN(logger) << "this warning should not be visible " << evaluate() << std::endl;
+  EXPECT_EQ(size_t(logger.info_enabled()) + logger.debug_enabled() + logger.warn_enabled(), evaluations);
+  if (!logger.warn_enabled())
+    logger.warn() << "this warning should not be visible either" << std::endl;
+  // the same streams are reused
+  auto other = TimedLogger().get("enabled_checks");
+  if (other.info_enabled() && logger.info_enabled()) {
+    EXPECT_EQ(&logger.info(), &other.info());
+  }
+}
+
+GTEST_TEST(TimedLogger, cached_streams_are_bounded)
+{
+  for (size_t ii = 0; ii < 10; ++ii) {
+    TimedLogging logging;
+    logging.create(0, -1, false, false);
+    auto logger = logging.get("first");
+    EXPECT_TRUE(logger.info_enabled());
+  }
+  TimedLogging logging;
+  logging.create(10, -1, false, false);
+  auto first = logging.get("first");
+  for (size_t ii = 0; ii < TimedLogging::max_cached_ids; ++ii)
+    logging.get("id_" + std::to_string(ii));
+  // all streams were dropped once too many ids were cached, the new ones still work
+  auto logger = logging.get("first");
+  EXPECT_TRUE(logger.info_enabled());
+  EXPECT_NE(&first.info(), &logger.info());
+}
+
+struct StringStreamLogger
+{
+  bool info_enabled() const
+  {
+    return true;
+  }
+
+  StringStreamLogger()
+    : out(std::make_shared<std::stringstream>())
+    , stream(out)
+  {}
+
+  std::ostream& info()
+  {
+    return *stream;
+  }
+
+  const std::shared_ptr<std::ostream>& info_stream() const
+  {
+    return stream;
+  }
+
+  std::shared_ptr<std::stringstream> out;
+  std::shared_ptr<std::ostream> stream;
+};
+
+GTEST_TEST(TimedLogger, rate_limits)
+{
+  StringStreamLogger first;
+  size_t evaluations = 0;
+  for (size_t ii = 0; ii < 10; ++ii)
+    DXTC_TIMEDLOG_LIMITED(first, info, DXTC_LOG_FIRST(3)) << "message " << ++evaluations << "\n";
+  EXPECT_EQ(3, evaluations);
+  EXPECT_EQ("message 1\nmessage 2\nmessage 3\n[further messages are suppressed after 3]\n", first.out->str());
+
+  StringStreamLogger every_nth;
+  evaluations = 0;
+  for (size_t ii = 0; ii < 10; ++ii)
+    DXTC_TIMEDLOG_LIMITED(every_nth, info, DXTC_LOG_EVERY_NTH(4)) << "message " << ii << "\n";
+  EXPECT_EQ("[only every 4-th of the following messages is shown]\nmessage 0\nmessage 4\nmessage 8\n",
+            every_nth.out->str());
+
+  StringStreamLogger per_second;
+  evaluations = 0;
+  const auto log_per_second = [&]() {
+    DXTC_TIMEDLOG_LIMITED(per_second, info, DXTC_LOG_PER_SECOND(2)) << "message " << ++evaluations << "\n";
+  };
+  for (size_t ii = 0; ii < 100; ++ii)
+    log_per_second();
+  // we might have crossed a second
+  EXPECT_LE(evaluations, 4);
+  busywait(1100);
+  log_per_second();
+  EXPECT_NE(std::string::npos,
+            per_second.out->str().find(" messages were suppressed, at most 2 per second are shown]\n"));
+
+  // the limits are per call site, not per logger
+  auto logger = TimedLogger().get("rate_limits");
+  for (size_t ii = 0; ii < 10; ++ii)
+    DXTC_TIMEDLOG_LIMITED(logger, info, DXTC_LOG_FIRST(1)) << "this info should be visible once" << std::endl;
+} // GTEST_TEST(TimedLogger, rate_limits)
+
+//! the sum of the numbers of suppressed messages in the notes of out
+size_t noted_suppressed(const std::string& out)
+{
+  size_t ret = 0;
+  const std::string suffix = " messages were suppressed";
+  for (auto pos = out.find(suffix); pos != std::string::npos; pos = out.find(suffix, pos + 1))
+    ret += std::stoul(out.substr(out.rfind('[', pos) + 1));
+  return ret;
+}
+
+GTEST_TEST(TimedLogger, suppressed_messages_are_counted)
+{
+  using namespace Dune::XT::Common;
+  for (const auto& limit : {LogRateLimit::first(3), LogRateLimit::every_nth(4), LogRateLimit::per_second(2)}) {
+    StringStreamLogger logger;
+    size_t suppressed = 0;
+    {
+      LogRateLimiter limiter(limit);
+      for (size_t ii = 0; ii < 10; ++ii)
+        suppressed += !limiter.admit(logger.info_stream());
+      if (limit.kind == LogRateLimit::Kind::per_second) {
+        busywait(1100);
+        for (size_t ii = 0; ii < 10; ++ii)
+          suppressed += !limiter.admit(logger.info_stream());
+      }
+      EXPECT_EQ(suppressed, limiter.suppressed());
+    }
+    // the notes and the summary written on destruction account for all suppressed messages
+    EXPECT_LT(0, suppressed);
+    EXPECT_EQ(suppressed, noted_suppressed(logger.out->str())) << logger.out->str();
+  }
+  StringStreamLogger logger;
+  {
+    LogRateLimiter limiter(LogRateLimit::first(3));
+    for (size_t ii = 0; ii < 10; ++ii)
+      limiter.admit(logger.info_stream());
+  }
+  EXPECT_EQ("[further messages are suppressed after 3]\n[7 messages were suppressed, only the first 3 are shown]\n",
+            logger.out->str());
+} // GTEST_TEST(TimedLogger, suppressed_messages_are_counted)
+
 int main(int argc, char** argv)
 {
 #if DUNE_XT_COMMON_TEST_MAIN_CATCH_EXCEPTIONS
@@ -11,6 +11,9 @@
 
 #include <dune/xt/common/test/main.hxx>
 
+#include <thread>
+#include <vector>
+
 #include <dune/xt/common/filesystem.hh>
 #include <dune/xt/common/math.hh>
 #include <dune/xt/common/ranges.hh>
@@ -92,3 +95,50 @@ GTEST_TEST(ProfilerTest, Example)
   auto file = make_ofstream("example.csv");
   timings().output_all_measures(*file);
 }
+
+GTEST_TEST(ProfilerTest, Threads)
+{
+  timings().reset();
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < 4; ++tt)
+    threads.emplace_back([tt]() {
+      const std::string section = "threads." + to_string(tt);
+      for (size_t ii = 0; ii < 100; ++ii) {
+        timings().start(section);
+        timings().start("threads.shared");
+        timings().stop(section);
+        timings().walltime("threads.shared");
+      }
+      scoped_busywait(section + ".busy", 10 * tt);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  timings().stop("threads.shared");
+  for (size_t tt = 0; tt < 4; ++tt) {
+    EXPECT_GE(timings().walltime("threads." + to_string(tt)), 0);
+    EXPECT_GE(timings().walltime("threads." + to_string(tt) + ".busy"), long(10 * tt * confidence_margin()));
+  }
+  timings().output_simple();
+}
+
+GTEST_TEST(ProfilerTest, Measures)
+{
+  timings().reset();
+  for (size_t ii = 0; ii < 3; ++ii)
+    scoped_busywait("measures.stopped", 10);
+  timings().start("measures.running");
+  const auto measures = timings().measures();
+  ASSERT_EQ(1, measures.count("measures.stopped"));
+  EXPECT_EQ(3, measures.at("measures.stopped").count);
+  EXPECT_EQ(timings().delta("measures.stopped"), measures.at("measures.stopped").delta);
+  ASSERT_EQ(1, measures.count("measures.running"));
+  EXPECT_EQ(0, measures.at("measures.running").count);
+  const auto measures_per_rank = timings().measures_per_rank();
+  const auto size = static_cast<size_t>(Dune::MPIHelper::getCollectiveCommunication().size());
+  const auto rank = Dune::MPIHelper::getCollectiveCommunication().rank();
+  ASSERT_EQ(size, measures_per_rank.at("measures.stopped").size());
+  EXPECT_EQ(3, measures_per_rank.at("measures.stopped")[rank].count);
+  timings().stop("measures.running");
+  timings().reset("measures.stopped");
+  EXPECT_EQ(0, timings().measures().at("measures.stopped").count);
+}
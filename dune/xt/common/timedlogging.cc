@@ -12,6 +12,11 @@
 #include "config.h"
 #include "timedlogging.hh"
 
+#include <chrono>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <boost/format.hpp>
 
 #include <dune/common/unused.hh>
@@ -48,11 +53,39 @@ TimedLogManager::TimedLogManager(const Timer& timer,
                                                     current_level_ <= max_debug_level ? enabled_out : dev_null))
 #endif
   , warn_(std::make_shared<TimedPrefixedLogStream>(timer_, warning_prefix, enable_warnings ? warn_out : disabled_out))
+  , info_enabled_(current_level_ <= max_info_level)
+  , debug_enabled_(current_level_ <= max_debug_level)
+  , warn_enabled_(enable_warnings)
+{}
+
+TimedLogManager::TimedLogManager(const Timer& timer,
+                                 std::atomic<ssize_t>& current_level,
+                                 std::shared_ptr<std::ostream> info,
+                                 std::shared_ptr<std::ostream> debug,
+                                 std::shared_ptr<std::ostream> warn,
+                                 const bool info_enabled,
+                                 const bool debug_enabled,
+                                 const bool warn_enabled)
+  : timer_(timer)
+  , current_level_(current_level)
+  , info_(std::move(info))
+  , debug_(std::move(debug))
+  , warn_(std::move(warn))
+  , info_enabled_(info_enabled)
+  , debug_enabled_(debug_enabled)
+  , warn_enabled_(warn_enabled)
 {}
 
 TimedLogManager::~TimedLogManager()
 {
   --current_level_;
+  // the streams may outlive this manager (see TimedLogging::get), but pending output is expected now
+  if (info_enabled_)
+    info_->flush();
+  if (debug_enabled_)
+    debug_->flush();
+  if (warn_enabled_)
+    warn_->flush();
 }
 
 std::ostream& TimedLogManager::info()
@@ -71,8 +104,156 @@ std::ostream& TimedLogManager::warn()
 }
 
 
+LogRateLimiter::LogRateLimiter(const LogRateLimit& limit)
+  : limit_(limit)
+  , count_(0)
+  , second_(std::numeric_limits<std::int64_t>::min())
+  , noted_suppressed_(0)
+{}
+
+LogRateLimiter::~LogRateLimiter()
+{
+  // for per_second, only those of the last second were not noted yet
+  const size_t suppressed = this->suppressed() - noted_suppressed_;
+  if (!summary_out_ || suppressed == 0)
+    return;
+  *summary_out_ << "[" << suppressed << " messages were suppressed, ";
+  if (limit_.kind == LogRateLimit::Kind::first)
+    *summary_out_ << "only the first " << limit_.n << " are shown]";
+  else if (limit_.kind == LogRateLimit::Kind::every_nth)
+    *summary_out_ << "only every " << limit_.n << "-th is shown]";
+  else
+    *summary_out_ << "at most " << limit_.n << " per second are shown]";
+  *summary_out_ << std::endl;
+} // ... ~LogRateLimiter(...)
+
+size_t LogRateLimiter::suppressed() const
+{
+  const size_t count = count_.load(std::memory_order_relaxed);
+  if (limit_.kind == LogRateLimit::Kind::every_nth)
+    return count - (count + limit_.n - 1) / limit_.n;
+  const size_t suppressed_now = count > limit_.n ? count - limit_.n : 0;
+  return noted_suppressed_.load(std::memory_order_relaxed) + suppressed_now;
+}
+
+bool LogRateLimiter::admit_per_second(const std::shared_ptr<std::ostream>& out)
+{
+  const std::int64_t second =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  std::int64_t previous_second = second_.load(std::memory_order_relaxed);
+  if (second != previous_second && second_.compare_exchange_strong(previous_second, second)) {
+    // we start the new second, messages of other threads in between are attributed to the last one
+    const size_t previous_count = count_.exchange(1, std::memory_order_relaxed);
+    const size_t suppressed = previous_count > limit_.n ? previous_count - limit_.n : 0;
+    noted_suppressed_.fetch_add(suppressed, std::memory_order_relaxed);
+    note_suppressed(out, suppressed);
+    return limit_.n > 0;
+  }
+  return count_.fetch_add(1, std::memory_order_relaxed) < limit_.n;
+} // ... admit_per_second(...)
+
+void LogRateLimiter::note_suppressed(const std::shared_ptr<std::ostream>& out, const size_t suppressed)
+{
+  {
+    std::lock_guard<std::mutex> guard(summary_mutex_);
+    if (!summary_out_)
+      summary_out_ = out;
+  }
+  if (limit_.kind == LogRateLimit::Kind::first)
+    *out << "[further messages are suppressed after " << limit_.n << "]" << std::endl;
+  else if (limit_.kind == LogRateLimit::Kind::every_nth)
+    *out << "[only every " << limit_.n << "-th of the following messages is shown]" << std::endl;
+  else if (suppressed > 0)
+    *out << "[" << suppressed << " messages were suppressed, at most " << limit_.n << " per second are shown]"
+         << std::endl;
+} // ... note_suppressed(...)
+
+
+namespace {
+
+
+//! the streams of one id, only those which were enabled at some point are created
+struct TimedLogStreams
+{
+  std::shared_ptr<std::ostream> info;
+  std::shared_ptr<std::ostream> debug;
+  std::shared_ptr<std::ostream> warn;
+};
+
+
+//! the state of a TimedLogging as of the last create() and the streams created from it on one thread
+struct TimedLoggingThreadCache
+{
+  size_t generation = std::numeric_limits<size_t>::max();
+  ssize_t max_info_level;
+  ssize_t max_debug_level;
+  bool enable_warnings;
+  std::string info_prefix;
+  std::string debug_prefix;
+  std::string warning_prefix;
+  std::string info_suffix;
+  std::string debug_suffix;
+  std::string warning_suffix;
+  //! a stream without buffer is always bad, so nothing streamed into it is formatted
+  std::shared_ptr<std::ostream> disabled = std::make_shared<std::ostream>(nullptr);
+  std::unordered_map<std::string, TimedLogStreams> streams;
+};
+
+
+//! the ids of all TimedLogging objects which have not been destroyed yet
+std::unordered_set<size_t>& live_timed_logging_instances()
+{
+  static std::unordered_set<size_t> instances;
+  return instances;
+}
+
+
+std::mutex& live_timed_logging_instances_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+
+std::unordered_map<size_t, TimedLoggingThreadCache>& timed_logging_thread_caches()
+{
+  static thread_local std::unordered_map<size_t, TimedLoggingThreadCache> caches;
+  return caches;
+}
+
+
+//! drops the caches of this thread which belong to destroyed TimedLogging objects
+void drop_stale_timed_logging_thread_caches()
+{
+  auto& caches = timed_logging_thread_caches();
+  DUNE_UNUSED std::lock_guard<std::mutex> guard(live_timed_logging_instances_mutex());
+  const auto& live = live_timed_logging_instances();
+  for (auto it = caches.begin(); it != caches.end();) {
+    if (live.count(it->first) == 0)
+      it = caches.erase(it);
+    else
+      ++it;
+  }
+} // ... drop_stale_timed_logging_thread_caches(...)
+
+
+size_t next_timed_logging_instance()
+{
+  static std::atomic<size_t> counter(0);
+  const size_t instance = counter++;
+  DUNE_UNUSED std::lock_guard<std::mutex> guard(live_timed_logging_instances_mutex());
+  live_timed_logging_instances().insert(instance);
+  return instance;
+}
+
+
+} // namespace
+
+
 TimedLogging::TimedLogging()
-  : max_info_level_(default_max_info_level)
+  : instance_(next_timed_logging_instance())
+  , generation_(0)
+  , max_info_level_(default_max_info_level)
   , max_debug_level_(default_max_debug_level)
   , enable_warnings_(default_enable_warnings)
   , enable_colors_(default_enable_colors && terminal_supports_color())
@@ -88,6 +269,12 @@ TimedLogging::TimedLogging()
   update_colors();
 }
 
+TimedLogging::~TimedLogging()
+{
+  DUNE_UNUSED std::lock_guard<std::mutex> guard(live_timed_logging_instances_mutex());
+  live_timed_logging_instances().erase(instance_);
+}
+
 void TimedLogging::create(const ssize_t max_info_level,
                           const ssize_t max_debug_level,
                           const bool enable_warnings,
@@ -108,21 +295,55 @@ void TimedLogging::create(const ssize_t max_info_level,
   created_ = true;
   current_level_ = -1;
   update_colors();
+  ++generation_;
 } // ... create(...)
 
-TimedLogManager TimedLogging::get(const std::string id)
+TimedLogManager TimedLogging::get(const std::string& id)
 {
-  DUNE_UNUSED std::lock_guard<std::mutex> guard(mutex_);
-  ++current_level_;
+  auto& caches = timed_logging_thread_caches();
+  auto cache_it = caches.find(instance_);
+  if (cache_it == caches.end()) {
+    // only happens once per thread and TimedLogging, so the caches of destroyed ones do not pile up
+    drop_stale_timed_logging_thread_caches();
+    cache_it = caches.emplace(instance_, TimedLoggingThreadCache()).first;
+  }
+  auto& cache = cache_it->second;
+  if (cache.generation != generation_ || cache.streams.size() >= max_cached_ids) {
+    DUNE_UNUSED std::lock_guard<std::mutex> guard(mutex_);
+    cache.generation = generation_;
+    cache.max_info_level = max_info_level_;
+    cache.max_debug_level = max_debug_level_;
+    cache.enable_warnings = enable_warnings_;
+    cache.info_prefix = info_prefix_;
+    cache.debug_prefix = debug_prefix_;
+    cache.warning_prefix = warning_prefix_;
+    cache.info_suffix = info_suffix_;
+    cache.debug_suffix = debug_suffix_;
+    cache.warning_suffix = warning_suffix_;
+    cache.streams.clear();
+  }
+  const ssize_t level = ++current_level_;
+  const bool info_enabled = level <= cache.max_info_level;
+  const bool debug_enabled = level <= cache.max_debug_level;
+  auto& streams = cache.streams[id];
+  if (info_enabled && !streams.info)
+    streams.info = std::make_shared<TimedPrefixedLogStream>(
+        timer_, cache.info_prefix + (id.empty() ? "info" : id) + ": " + cache.info_suffix, std::cout);
+  if (debug_enabled && !streams.debug)
+    streams.debug = std::make_shared<TimedPrefixedLogStream>(
+        timer_, cache.debug_prefix + (id.empty() ? "debug" : id) + ": " + cache.debug_suffix, std::cout);
+  if (cache.enable_warnings && !streams.warn)
+    streams.warn = std::make_shared<TimedPrefixedLogStream>(
+        timer_, cache.warning_prefix + (id.empty() ? "warn" : id) + ": " + cache.warning_suffix, std::cerr);
   return TimedLogManager(timer_,
-                         info_prefix_ + (id.empty() ? "info" : id) + ": " + info_suffix_,
-                         debug_prefix_ + (id.empty() ? "debug" : id) + ": " + debug_suffix_,
-                         warning_prefix_ + (id.empty() ? "warn" : id) + ": " + warning_suffix_,
-                         max_info_level_,
-                         max_debug_level_,
-                         enable_warnings_,
-                         current_level_);
-}
+                         current_level_,
+                         info_enabled ? streams.info : cache.disabled,
+                         debug_enabled ? streams.debug : cache.disabled,
+                         cache.enable_warnings ? streams.warn : cache.disabled,
+                         info_enabled,
+                         debug_enabled,
+                         cache.enable_warnings);
+} // ... get(...)
 
 void TimedLogging::update_colors()
 {
@@ -16,10 +16,13 @@
 #ifndef DUNE_XT_COMMON_TIMEDLOGGING_HH
 #define DUNE_XT_COMMON_TIMEDLOGGING_HH
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <map>
-#include <string>
+#include <memory>
 #include <mutex>
-#include <atomic>
+#include <string>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -44,13 +47,30 @@ namespace XT {
 namespace Common {
 
 
+class TimedLogging;
+
+
 /**
  * \brief A logging manager that provides info, debug and warning streams
  *
+ *        Streaming into a disabled stream is cheap (nothing is formatted), but the streamed expressions are still
+ *        evaluated. Use info_enabled() and friends or the DXTC_TIMEDLOG_INFO, DXTC_TIMEDLOG_DEBUG and
+ *        DXTC_TIMEDLOG_WARN macros to avoid that.
  * \note  Most likely you do not want to use this class directly but TimedLogger() instead.
  */
 class TimedLogManager
 {
+  friend class TimedLogging;
+
+  TimedLogManager(const Timer& timer,
+                  std::atomic<ssize_t>& current_level,
+                  std::shared_ptr<std::ostream> info,
+                  std::shared_ptr<std::ostream> debug,
+                  std::shared_ptr<std::ostream> warn,
+                  const bool info_enabled,
+                  const bool debug_enabled,
+                  const bool warn_enabled);
+
 public:
   TimedLogManager(const Timer& timer,
                   const std::string info_prefix,
@@ -72,15 +92,139 @@ public:
 
   std::ostream& warn();
 
+  bool info_enabled() const
+  {
+    return info_enabled_;
+  }
+
+  bool debug_enabled() const
+  {
+    return debug_enabled_;
+  }
+
+  bool warn_enabled() const
+  {
+    return warn_enabled_;
+  }
+
+  //! the info stream itself, which may outlive this manager, \sa LogRateLimiter
+  const std::shared_ptr<std::ostream>& info_stream() const
+  {
+    return info_;
+  }
+
+  const std::shared_ptr<std::ostream>& debug_stream() const
+  {
+    return debug_;
+  }
+
+  const std::shared_ptr<std::ostream>& warn_stream() const
+  {
+    return warn_;
+  }
+
 private:
   const Timer& timer_;
   std::atomic<ssize_t>& current_level_;
   std::shared_ptr<std::ostream> info_;
   std::shared_ptr<std::ostream> debug_;
   std::shared_ptr<std::ostream> warn_;
+  bool info_enabled_;
+  bool debug_enabled_;
+  bool warn_enabled_;
 }; // class TimedLogManager
 
 
+//! how often the messages of a call site are emitted, \sa DXTC_TIMEDLOG_LIMITED
+struct LogRateLimit
+{
+  enum class Kind
+  {
+    first,
+    every_nth,
+    per_second
+  };
+
+  //! only the first n messages
+  static LogRateLimit first(const size_t n)
+  {
+    return {Kind::first, n};
+  }
+
+  //! the first, the (n + 1)-th, the (2n + 1)-th, ... message
+  static LogRateLimit every_nth(const size_t n)
+  {
+    return {Kind::every_nth, std::max(n, size_t(1))};
+  }
+
+  //! at most n messages per second
+  static LogRateLimit per_second(const size_t n)
+  {
+    return {Kind::per_second, n};
+  }
+
+  Kind kind;
+  size_t n;
+}; // struct LogRateLimit
+
+
+/**
+ * \brief Decides whether a message of a call site is emitted, \sa DXTC_TIMEDLOG_LIMITED.
+ *
+ *        Suppressed messages only cost one relaxed atomic increment (and reading the clock for per_second). A line
+ *        saying that further messages will be suppressed (for per_second: how many were suppressed in the last second)
+ *        is written to the stream in front of the next emitted message. On destruction, a summary of the suppressed
+ *        messages (for per_second: those not yet noted) is written to the first stream a note was written to, which is
+ *        kept alive for that purpose.
+ */
+class LogRateLimiter
+{
+public:
+  explicit LogRateLimiter(const LogRateLimit& limit);
+
+  ~LogRateLimiter();
+
+  //! whether the message should be written to out, writes a note about suppressed messages to out if required
+  bool admit(const std::shared_ptr<std::ostream>& out)
+  {
+    if (limit_.kind == LogRateLimit::Kind::per_second)
+      return admit_per_second(out);
+    const size_t count = count_.fetch_add(1, std::memory_order_relaxed);
+    if (limit_.kind == LogRateLimit::Kind::first) {
+      if (count < limit_.n)
+        return true;
+      if (count == limit_.n)
+        note_suppressed(out, 0);
+      return false;
+    }
+    if (count % limit_.n != 0)
+      return false;
+    if (count == 0 && limit_.n > 1)
+      note_suppressed(out, 0);
+    return true;
+  } // ... admit(...)
+
+  //! number of messages suppressed so far
+  size_t suppressed() const;
+
+private:
+  bool admit_per_second(const std::shared_ptr<std::ostream>& out);
+
+  //! writes the number of suppressed messages (or, if 0, what will be suppressed) to out
+  void note_suppressed(const std::shared_ptr<std::ostream>& out, const size_t suppressed);
+
+  const LogRateLimit limit_;
+  std::atomic<size_t> count_;
+  //! per_second: the second count_ refers to
+  std::atomic<std::int64_t> second_;
+  //! per_second: the messages suppressed in the seconds before second_, which were already noted
+  std::atomic<size_t> noted_suppressed_;
+  //! the stream of the summary, guarded by summary_mutex_
+  std::shared_ptr<std::ostream> summary_out_;
+  std::mutex summary_mutex_;
+}; // class LogRateLimiter
+
+
 /**
  * \brief A logger that provides colored and prefixed streams.
  *
@@ -106,8 +250,13 @@ public:
     return "red";
   }
 
+  //! at most this many ids are cached per thread, all streams are recreated on the next call to get() otherwise
+  static const size_t max_cached_ids = 1024;
+
   TimedLogging();
 
+  ~TimedLogging();
+
   /**
    * \brief sets the state
    *
@@ -125,11 +274,23 @@ public:
               const std::string debug_color = default_debug_color(),
               const std::string warning_color = default_warning_color());
 
-  TimedLogManager get(const std::string id);
+  /**
+   * \brief A TimedLogManager for the given id, increases the log level until it goes out of scope.
+   *
+   *        The streams are created once per id and thread and are reused by later calls (on the same thread), so
+   *        this neither locks nor allocates after the first call. The cached streams are dropped by create() and once
+   *        more than max_cached_ids ids were requested on a thread.
+   */
+  TimedLogManager get(const std::string& id);
 
 private:
   void update_colors();
 
+  //! unique among all TimedLogging objects, to identify the streams cached for this one
+  const size_t instance_;
+  //! incremented by create(), which invalidates all cached streams
+  std::atomic<size_t> generation_;
+
   ssize_t max_info_level_;
   ssize_t max_debug_level_;
   bool enable_warnings_;
@@ -231,6 +392,10 @@ int main()
 \endcode
  * \note Debug logging is only enabled if DUNE_XT_COMMON_TIMEDLOGGING_ENABLE_DEBUG is true (which is by default the case
  *       if NDEBUG is not defined) but you might still want to guard calls to logger.debug() for performance reasons.
+ * \note TimedLogging::get() and TimedLogging::create() may be called concurrently from several threads (including
+ *       python threads). A TimedLogManager must not be shared between threads, but each thread may obtain its own.
+ *       Everything streamed into one of its streams up to a flush is written to the underlying stream at once, so
+ *       lines from different threads do not get mixed up. The log level is shared by all threads, though.
  */
 DUNE_EXPORT inline TimedLogging& TimedLogger()
 {
@@ -359,4 +524,48 @@ private:
 } // namespace XT
 } // namespace Dune
 
+/**
+ * \brief Stream into one of the streams of a TimedLogManager, only evaluating the streamed expression if the stream is
+ *        enabled:
+\code
+auto logger = TimedLogger().get("foo");
+DXTC_TIMEDLOG_DEBUG(logger) << "expensive: " << compute_something() << std::endl;
+\endcode
+ */
+#define DXTC_TIMEDLOG_INFO(logger)                                                                                     \
+  if (!(logger).info_enabled()) {                                                                                      \
+  } else                                                                                                               \
+    (logger).info()
+#define DXTC_TIMEDLOG_DEBUG(logger)                                                                                    \
+  if (!(logger).debug_enabled()) {                                                                                     \
+  } else                                                                                                               \
+    (logger).debug()
+#define DXTC_TIMEDLOG_WARN(logger)                                                                                     \
+  if (!(logger).warn_enabled()) {                                                                                      \
+  } else                                                                                                               \
+    (logger).warn()
+
+/**
+ * \brief Like DXTC_TIMEDLOG_INFO and friends, but only emits as many messages of this call site as allowed by limit
+ *        (a LogRateLimit, e.g. DXTC_LOG_EVERY_NTH(100)), for all loggers and threads together:
+\code
+for (auto&& element : elements(grid_view))
+  DXTC_TIMEDLOG_LIMITED(logger, debug, DXTC_LOG_PER_SECOND(10)) << "visiting " << element.geometry().center() << "\n";
+\endcode
+ *        stream has to be one of info, debug or warn. Suppressed messages are not even evaluated.
+ */
+#define DXTC_TIMEDLOG_LIMITED(logger, stream, limit)                                                                   \
+  if (!(logger).stream##_enabled()) {                                                                                  \
+  } else if (![]() -> Dune::XT::Common::LogRateLimiter& {                                                              \
+               static Dune::XT::Common::LogRateLimiter dxtc_log_rate_limiter(limit);                                   \
+               return dxtc_log_rate_limiter;                                                                           \
+             }()                                                                                                       \
+                  .admit((logger).stream##_stream())) {                                                                \
+  } else                                                                                                               \
+    (logger).stream()
+
+#define DXTC_LOG_FIRST(n) Dune::XT::Common::LogRateLimit::first(n)
+#define DXTC_LOG_EVERY_NTH(n) Dune::XT::Common::LogRateLimit::every_nth(n)
+#define DXTC_LOG_PER_SECOND(n) Dune::XT::Common::LogRateLimit::per_second(n)
+
 #endif // DUNE_XT_COMMON_TIMED_LOGGING_HH
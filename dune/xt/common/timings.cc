@@ -37,6 +37,7 @@
 #include <dune/xt/common/parallel/threadmanager.hh>
 #include <dune/xt/common/parallel/threadstorage.hh>
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -78,12 +79,14 @@ TimingData::DeltaType TimingData::delta() const
 
 void Timings::reset(std::string section_name)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   try {
-    stop(section_name);
+    stop_locked(section_name);
   } catch (Dune::RangeError&) {
     // ok, timer simply wasn't running
   }
   commited_deltas_[section_name] = {{0, 0, 0}};
+  commited_counts_[section_name] = 0;
 }
 
 void Timings::start(std::string section_name)
@@ -98,19 +101,26 @@ void Timings::start(std::string section_name)
     section->second.second = TimingData(section_name);
   } else {
     // init new section
-    known_timers_map_[section_name] = std::make_pair(true, TimingData(section_name));
+    known_timers_map_.emplace(section_name, std::make_pair(true, TimingData(section_name)));
   }
   DXTC_LIKWID_BEGIN_SECTION(section_name)
 } // StartTiming
 
 long Timings::stop(std::string section_name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stop_locked(section_name);
+}
+
+long Timings::stop_locked(const std::string& section_name)
 {
   DXTC_LIKWID_END_SECTION(section_name)
-  if (known_timers_map_.find(section_name) == known_timers_map_.end())
+  const auto section = known_timers_map_.find(section_name);
+  if (section == known_timers_map_.end())
     DUNE_THROW(Dune::RangeError, "trying to stop timer " << section_name << " that wasn't started\n");
 
-  known_timers_map_[section_name].first = false; // marks as not running
-  TimingData& timing = *(known_timers_map_[section_name].second);
+  section->second.first = false; // marks as not running
+  TimingData& timing = section->second.second;
   timing.stop();
   const auto dlt = timing.delta();
   if (commited_deltas_.find(section_name) == commited_deltas_.end())
@@ -119,6 +129,7 @@ long Timings::stop(std::string section_name)
     for (auto i : value_range(dlt.size()))
       commited_deltas_[section_name][i] += dlt[i];
   }
+  ++commited_counts_[section_name];
   return dlt[0];
 } // StopTiming
 
@@ -129,35 +140,96 @@ TimingData::TimeType Timings::walltime(std::string section_name) const
 
 TimingData::DeltaType Timings::delta(std::string section_name) const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   DeltaMap::const_iterator section = commited_deltas_.find(section_name);
   if (section == commited_deltas_.end()) {
     // timer might still be running
     const auto& timer_it = known_timers_map_.find(section_name);
     if (timer_it == known_timers_map_.end())
       DUNE_THROW(Dune::InvalidStateException, "no timer found: " + section_name);
-    return timer_it->second.second->delta();
+    return timer_it->second.second.delta();
   }
   return section->second;
 }
 
-void Timings::stop()
+Timings::MeasuresMap Timings::measures() const
 {
-  for (auto&& section : known_timers_map_) {
-    try {
-      stop(section.first);
-    } catch (Dune::RangeError&) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MeasuresMap ret;
+  for (const auto& section : commited_deltas_) {
+    const auto count = commited_counts_.find(section.first);
+    ret[section.first] = {section.second, count == commited_counts_.end() ? 0 : count->second};
+  }
+  for (const auto& section : known_timers_map_)
+    if (section.second.first && ret.find(section.first) == ret.end())
+      ret[section.first] = {section.second.second.delta(), 0};
+  return ret;
+} // ... measures(...)
+
+Timings::MeasuresPerRankMap Timings::measures_per_rank(MPIHelper::MPICommunicator mpi_comm) const
+{
+  CollectiveCommunication<MPIHelper::MPICommunicator> comm(mpi_comm);
+  // the collective communication below must not hold mutex_
+  const auto local_measures = measures();
+  const int num_sections = static_cast<int>(local_measures.size());
+  // the values are matched to the sections by position below, so the names (FNV-1a of all of them) have to agree
+  std::uint64_t names_hash = 0xcbf29ce484222325ULL;
+  for (const auto& section : local_measures)
+    for (const unsigned char cc : section.first + '\0')
+      names_hash = (names_hash ^ cc) * 0x100000001b3ULL;
+  if (comm.min(num_sections) != comm.max(num_sections) || comm.min(names_hash) != comm.max(names_hash))
+    DUNE_THROW(Dune::InvalidStateException, "All ranks need to know the same sections!");
+  // wall, user, system, count for each section, sections are sorted by name on each rank
+  const int values_per_section = 4;
+  std::vector<TimingData::TimeType> local_values;
+  local_values.reserve(values_per_section * num_sections);
+  for (const auto& section : local_measures) {
+    local_values.insert(local_values.end(), section.second.delta.begin(), section.second.delta.end());
+    local_values.push_back(static_cast<TimingData::TimeType>(section.second.count));
+  }
+  const auto size = static_cast<size_t>(comm.size());
+  std::vector<TimingData::TimeType> values(size * local_values.size());
+  comm.allgather(local_values.data(), static_cast<int>(local_values.size()), values.data());
+  MeasuresPerRankMap ret;
+  size_t ss = 0;
+  for (const auto& section : local_measures) {
+    auto& per_rank = ret[section.first];
+    per_rank.resize(size);
+    for (size_t rank = 0; rank < size; ++rank) {
+      const auto* rank_values = values.data() + (rank * num_sections + ss) * values_per_section;
+      per_rank[rank] = {{{rank_values[0], rank_values[1], rank_values[2]}}, static_cast<size_t>(rank_values[3])};
     }
+    ++ss;
   }
+  return ret;
+} // ... measures_per_rank(...)
+
+Timings::DeltaMap Timings::commited_deltas() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return commited_deltas_;
+}
+
+void Timings::stop()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto&& section : known_timers_map_)
+    if (section.second.first)
+      stop_locked(section.first);
 } // GetTiming
 
 void Timings::reset()
 {
-  stop();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto&& section : known_timers_map_)
+    section.second.first = false;
   commited_deltas_.clear();
+  commited_counts_.clear();
 } // Reset
 
 void Timings::set_outputdir(std::string dir)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   output_dir_ = dir;
   test_create_directory(output_dir_);
 }
@@ -165,7 +237,11 @@ void Timings::set_outputdir(std::string dir)
 void Timings::output_per_rank(std::string csv_base) const
 {
   const auto rank = MPIHelper::getCollectiveCommunication().rank();
-  boost::filesystem::path dir(output_dir_);
+  boost::filesystem::path dir;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dir = output_dir_;
+  }
   boost::filesystem::path filename = dir / (boost::format("%s_p%08d.csv") % csv_base % rank).str();
   boost::filesystem::ofstream out(filename);
   output_all_measures(out, MPIHelper::getLocalCommunicator());
@@ -180,10 +256,11 @@ void Timings::output_per_rank(std::string csv_base) const
 
 void Timings::output_simple(std::ostream& out) const
 {
-  for (const auto& section : commited_deltas_) {
+  const auto deltas = commited_deltas();
+  for (const auto& section : deltas) {
     out << csv_sep_ << section.first;
   }
-  for (const auto& section : commited_deltas_) {
+  for (const auto& section : deltas) {
     out << csv_sep_ << section.second[0];
     ;
   }
@@ -194,9 +271,11 @@ void Timings::output_all_measures(std::ostream& out, MPIHelper::MPICommunicator
 {
   CollectiveCommunication<MPIHelper::MPICommunicator> comm(mpi_comm);
   std::stringstream stash;
+  // the collective communication below must not hold mutex_
+  const auto deltas = commited_deltas();
 
   stash << "threads" << csv_sep_ << "ranks";
-  for (const auto& section : commited_deltas_) {
+  for (const auto& section : deltas) {
     stash << csv_sep_ << section.first << "_avg_usr" << csv_sep_ << section.first << "_max_usr" << csv_sep_
           << section.first << "_avg_wall" << csv_sep_ << section.first << "_max_wall" << csv_sep_ << section.first
           << "_avg_sys" << csv_sep_ << section.first << "_max_sys";
@@ -204,7 +283,7 @@ void Timings::output_all_measures(std::ostream& out, MPIHelper::MPICommunicator
   const auto weight = 1 / double(comm.size());
 
   stash << std::endl << threadManager().max_threads() << csv_sep_ << comm.size();
-  for (const auto& section : commited_deltas_) {
+  for (const auto& section : deltas) {
     const auto timings = section.second;
     auto wall = timings[0];
     auto usr = timings[1];
@@ -17,6 +17,7 @@
 #  define DUNE_XT_COMMON_DO_PROFILE 0
 #endif
 
+#include <array>
 #include <string>
 #include <map>
 #include <vector>
@@ -75,6 +76,9 @@ class ScopedTiming;
  *  - User can set as many (even nested) named sections whose total (=system+user) time will be computed across all
  *    program instances.\n
  *  - Provides csv-conform output of process-averaged runtimes.
+ *  - All methods may be called concurrently from several threads (including python threads, the bindings release
+ *    the GIL). Sections are identified by their name only: a section which is already running is not restarted, so
+ *    threads should use distinct section names (e.g., suffixed by a thread or task id) to time concurrent work.
  **/
 class Timings
 {
@@ -83,13 +87,33 @@ class Timings
 private:
   Timings();
 
-  typedef std::map<std::string, std::pair<std::atomic<bool>, UnsafePerThreadValue<TimingData>>> KnownTimersMap;
+  //! section name -> (running, timer), all copies of a TimingData share their timer
+  typedef std::map<std::string, std::pair<bool, TimingData>> KnownTimersMap;
   //! section name -> seconds
   typedef std::map<std::string, TimingData::DeltaType> DeltaMap;
+  //! section name -> number of stops
+  typedef std::map<std::string, size_t> CountMap;
 
-  const TimingData& get_timing_data(std::string section_name) const;
+  //! stop, assuming that mutex_ is locked
+  long stop_locked(const std::string& section_name);
+
+  //! copy of commited_deltas_, to be output without holding mutex_
+  DeltaMap commited_deltas() const;
 
 public:
+  //! everything recorded for one section
+  struct Measures
+  {
+    //! wall, user and system time in milliseconds, as returned by delta()
+    TimingData::DeltaType delta;
+    //! how often the section was stopped
+    size_t count;
+  };
+  //! section name -> measures
+  typedef std::map<std::string, Measures> MeasuresMap;
+  //! section name -> measures of each rank
+  typedef std::map<std::string, std::vector<Measures>> MeasuresPerRankMap;
+
   ~Timings();
 
   void stop();
@@ -108,6 +132,14 @@ public:
   //! get the full delta array
   TimingData::DeltaType delta(std::string section_name) const;
 
+  //! the measures of all sections of this rank, sections which were started but never stopped have a count of 0
+  MeasuresMap measures() const;
+  /** the measures of all sections of each rank of mpi_comm, available on all ranks
+   * \note this is a collective operation and all ranks need to know the same sections (as for output_all_measures),
+   *       throws an InvalidStateException otherwise
+   **/
+  MeasuresPerRankMap measures_per_rank(MPIHelper::MPICommunicator mpi_comm = Dune::MPIHelper::getCommunicator()) const;
+
   /** creates one file local to each MPI-rank (no global averaging)
    *  one single rank-0 file with all combined/averaged measures
    ***/
@@ -126,12 +158,13 @@ public:
 
 private:
   DeltaMap commited_deltas_;
+  CountMap commited_counts_;
   //! runtime tables etc go there
   std::string output_dir_;
 
   KnownTimersMap known_timers_map_;
   const std::string csv_sep_;
-  std::mutex mutex_;
+  mutable std::mutex mutex_;
 };
 
 //! global profiler object
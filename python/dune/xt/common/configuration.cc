@@ -0,0 +1,57 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/stl.h>
+
+#include <dune/xt/common/configuration.hh>
+#include <dune/xt/common/python.hh>
+
+// Note that python/dune/xt/common/configuration.hh must not be included here: it converts Configurations to and from
+// dicts, while this module binds the class itself.
+
+
+PYBIND11_MODULE(configuration, m)
+{
+  namespace py = pybind11;
+  using namespace pybind11::literals;
+  using namespace Dune::XT::Common;
+
+  // All methods keep the GIL: concurrent reads of a Configuration are fine on the C++ side, but writes require
+  // exclusive access. Holding the GIL serializes the calls, so python threads may share Configurations.
+  bindings::guarded_bind([&]() {
+    py::class_<Configuration>(m, "Configuration", "a Configuration, which may be shared by several python threads")
+        .def(py::init([](const std::map<std::string, std::string>& values) {
+               Configuration ret;
+               for (const auto& key_and_value : values)
+                 ret.set(key_and_value.first, key_and_value.second, true);
+               return ret;
+             }),
+             "values"_a = std::map<std::string, std::string>())
+        .def("__contains__", &Configuration::has_key)
+        .def("__getitem__",
+             [](const Configuration& self, const std::string& key) {
+               if (!self.has_key(key))
+                 throw py::key_error(key);
+               return self.get<std::string>(key);
+             })
+        .def("__setitem__",
+             [](Configuration& self, const std::string& key, const std::string& value) {
+               self.set(key, value, true);
+             })
+        .def("__eq__", [](const Configuration& self, const Configuration& other) { return self == other; })
+        .def("__ne__", [](const Configuration& self, const Configuration& other) { return self != other; })
+        .def("__hash__", [](const Configuration& self) { return std::hash<Configuration>()(self); })
+        .def("to_dict", &Configuration::flatten, "all keys and values, the keys of subtrees joined by '.'");
+  });
+}
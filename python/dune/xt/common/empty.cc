@@ -9,6 +9,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,8 @@
 
 #include <python/dune/xt/common/bindings.hh>
 #include <python/dune/xt/common/exceptions.bindings.hh>
+#include <python/dune/xt/common/fmatrix.hh>
+#include <python/dune/xt/common/fvector.hh>
 
 #include <dune/pybindxi/pybind11.h>
 
@@ -69,4 +72,20 @@ PYBIND11_MODULE(_empty, m)
       .def(py::init<const std::string&>())
       .def("bark", &Dog::bark);
   py::class_<Terrier, Dog /* <- specify C++ parent type */>(m, "Terrier").def(py::init<>());
+
+  // round trips through the FieldVector/FieldMatrix casters
+  m.def("scale_field_vector", [](const Dune::FieldVector<double, 3>& vec, double factor) { return vec * factor; });
+  m.def("transpose_field_matrix", [](const Dune::XT::Common::FieldMatrix<double, 2, 3>& mat) {
+    return mat.transpose();
+  });
+  m.def("reverse_field_vectors", [](std::vector<Dune::FieldVector<double, 2>> points) {
+    std::reverse(points.begin(), points.end());
+    return points;
+  });
+  m.def("identity_field_matrices", [](const size_t size) {
+    Dune::FieldMatrix<int, 2, 2> identity(0);
+    identity[0][0] = identity[1][1] = 1;
+    return std::vector<Dune::FieldMatrix<int, 2, 2>>(size, identity);
+  });
+  m.def("field_vector_of_strings", [](const Dune::XT::Common::FieldVector<std::string, 2>& vec) { return vec; });
 }
@@ -0,0 +1,105 @@
+// This file is part of the dune-xt-common project:
+//   https://github.com/dune-community/dune-xt-common
+// Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include "config.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <dune/pybindxi/pybind11.h>
+
+#include <dune/xt/common/event_log.hh>
+#include <dune/xt/common/memory.hh>
+
+namespace {
+
+
+namespace py = pybind11;
+
+//! the number of arguments an event recorded from python may have
+static const size_t max_python_event_args = 3;
+
+
+/**
+ * DXTC_EVENT_LOG has one site per call, which registers its format once. Here, each combination of format and argument
+ * types gets its own site instead. Only called with the GIL held, which guards the map.
+ */
+template <class... Args>
+Dune::XT::Common::internal::EventFormatSite& python_event_site(const std::string& format)
+{
+  static std::map<std::string, std::unique_ptr<Dune::XT::Common::internal::EventFormatSite>> sites;
+  auto& site = sites[format];
+  if (!site)
+    site = Dune::XT::Common::make_unique<Dune::XT::Common::internal::EventFormatSite>(__FILE__, __LINE__);
+  return *site;
+}
+
+template <class... Args>
+std::enable_if_t<(sizeof...(Args) == max_python_event_args)>
+record_python_event(const std::string& format, const py::args& values, const Args&... args)
+{
+  if (values.size() > sizeof...(Args))
+    throw py::value_error("an event may have at most " + std::to_string(max_python_event_args) + " arguments");
+  Dune::XT::Common::EventLogger().record(python_event_site<Args...>(format), format.c_str(), args...);
+}
+
+//! converts the python values one after the other, bool, int, float and str are supported
+template <class... Args>
+std::enable_if_t<(sizeof...(Args) < max_python_event_args)>
+record_python_event(const std::string& format, const py::args& values, const Args&... args)
+{
+  if (values.size() == sizeof...(Args)) {
+    Dune::XT::Common::EventLogger().record(python_event_site<Args...>(format), format.c_str(), args...);
+    return;
+  }
+  const py::object value = values[sizeof...(Args)];
+  // bool first, since it is a subclass of int
+  if (py::isinstance<py::bool_>(value))
+    record_python_event(format, values, args..., value.cast<bool>());
+  else if (py::isinstance<py::int_>(value))
+    record_python_event(format, values, args..., value.cast<std::int64_t>());
+  else if (py::isinstance<py::float_>(value))
+    record_python_event(format, values, args..., value.cast<double>());
+  else if (py::isinstance<py::str>(value))
+    record_python_event(format, values, args..., value.cast<std::string>());
+  else
+    throw py::type_error(std::string("only bool, int, float and str can be recorded, not ")
+                         + Py_TYPE(value.ptr())->tp_name);
+} // ... record_python_event(...)
+
+
+} // namespace
+
+
+PYBIND11_MODULE(event_log, m)
+{
+  using namespace pybind11::literals;
+  using namespace Dune::XT::Common;
+
+  m.def("create",
+        [](const std::string& filename, const std::string& datadir, const std::string& logdir) {
+          EventLogger().create(filename, datadir, logdir);
+        },
+        "filename"_a = "dune_xt_common_events",
+        "datadir"_a = "data",
+        "logdir"_a = "log");
+  m.def("deinit", []() { EventLogger().deinit(); });
+  m.def("enabled", []() { return EventLogger().enabled(); });
+  m.def("filename", []() { return EventLogger().filename(); });
+  m.def("flush", []() { EventLogger().flush(); });
+  // keeps the GIL, which guards the sites of the formats
+  m.def("record",
+        [](const std::string& format, py::args values) {
+          if (EventLogger().enabled())
+            record_python_event(format, values);
+        },
+        "format"_a,
+        "records an event with at most three arguments, each '{}' in format is replaced by the next one when decoding");
+}
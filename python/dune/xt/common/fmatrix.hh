@@ -12,9 +12,14 @@
 #ifndef DUNE_XT_COMMON_FMATRIX_PBH
 #define DUNE_XT_COMMON_FMATRIX_PBH
 
+#include <algorithm>
+#include <vector>
+
 #include <dune/pybindxi/complex.h>
 #include <dune/pybindxi/pybind11.h>
 #include <dune/pybindxi/cast.h>
+#include <dune/pybindxi/numpy.h>
+#include <dune/pybindxi/stl.h>
 
 #include <dune/xt/common/fmatrix.hh>
 
@@ -24,8 +29,49 @@ NAMESPACE_BEGIN(pybind11)
 NAMESPACE_BEGIN(detail)
 
 
+template <class FieldMatrixImp,
+          bool is_number = is_field_numpy_scalar<typename FieldMatrixImp::value_type>::value>
+struct FieldMatrix_type_caster;
+
+
+/**
+ * FieldMatrices of numbers are read from and cast to two-dimensional numpy arrays (any nested sequence is accepted
+ * when converting), without creating a python object per entry.
+ **/
+template <class FieldMatrixImp>
+struct FieldMatrix_type_caster<FieldMatrixImp, true>
+{
+  using type = FieldMatrixImp;
+  typedef typename type::value_type K;
+  static const int ROWS = type::rows;
+  static const int COLS = type::cols;
+  static_assert(sizeof(type) == ROWS * COLS * sizeof(K), "The entries of the FieldMatrix have to be contiguous!");
+
+  bool load(handle src, bool convert)
+  {
+    const auto arr = field_array_load<K>(src, convert, {ROWS, COLS});
+    if (!arr)
+      return false;
+    std::copy_n(arr.data(), ROWS * COLS, reinterpret_cast<K*>(&value));
+    return true;
+  }
+
+  static handle cast(const type& src, return_value_policy policy, handle parent)
+  {
+    return field_array_cast(reinterpret_cast<const K*>(&src), {ROWS, COLS}, policy, parent);
+  }
+
+  PYBIND11_TYPE_CASTER(type,
+                       _("numpy.ndarray[") + npy_format_descriptor<K>::name + _("[") + _<ROWS>() + _(", ")
+                           + _<COLS>() + _("]]"));
+}; // struct FieldMatrix_type_caster<..., true>
+
+
+/**
+ * FieldMatrices of other types (e.g., std::string) are read from and cast to lists of rows entry by entry.
+ **/
 template <class FieldMatrixImp>
-struct FieldMatrix_type_caster
+struct FieldMatrix_type_caster<FieldMatrixImp, false>
 {
   using type = FieldMatrixImp;
   typedef typename type::value_type K;
@@ -43,7 +89,6 @@ struct FieldMatrix_type_caster
     if (s.size() != ROWS)
       return false;
     row_conv conv;
-    value *= K(0.0);
     size_t ii = 0;
     for (auto it : s) {
       if (ii >= ROWS)
@@ -65,59 +110,82 @@ struct FieldMatrix_type_caster
       PyList_SET_ITEM(l.ptr(), ii, val.release().ptr()); // steals a reference
     }
     return l.release();
-    return list(0).release();
   } // ... cast(...)
 
   PYBIND11_TYPE_CASTER(type,
                        _("List[List[") + value_conv::name + _("[") + _<COLS>() + _("]]") + _("[") + _<ROWS>()
                            + _("]]"));
-}; // struct FieldMatrix_type_caster
+}; // struct FieldMatrix_type_caster<..., false>
 
 
-template <class K, int N, int M>
-struct type_caster<Dune::FieldMatrix<K, N, M>> : public FieldMatrix_type_caster<Dune::FieldMatrix<K, N, M>>
+template <class VectorType,
+          class FieldMatrixImp = typename VectorType::value_type,
+          bool is_number = is_field_numpy_scalar<typename FieldMatrixImp::value_type>::value>
+struct FieldMatrices_type_caster : public list_caster<VectorType, FieldMatrixImp>
 {};
 
 /**
- * Dune::XT::Common::FieldMatrix is already able to handle std::string as we already provide the correct default value
- * (see type_traits::suitable_default). Thus, we do not need to initalize with value *= K(0.0)
- *
- * Attention: If this is not enough you need to specialize for std::string. (see fvector.hh)
- */
-template <class K, int N, int M>
-struct type_caster<Dune::XT::Common::FieldMatrix<K, N, M>>
-  : public FieldMatrix_type_caster<Dune::XT::Common::FieldMatrix<K, N, M>>
+ * std::vectors of FieldMatrices of numbers are read from and cast to numpy arrays of shape (size, ROWS, COLS).
+ * Returned temporaries are moved into the array, so not even their entries are copied.
+ **/
+template <class VectorType, class FieldMatrixImp>
+struct FieldMatrices_type_caster<VectorType, FieldMatrixImp, true>
 {
-  using type = Dune::XT::Common::FieldMatrix<K, N, M>;
-  typedef typename type::row_type row_type;
-  static const int ROWS = type::rows;
-  static const int COLS = type::cols;
-  using value_conv = make_caster<K>;
-  using row_conv = make_caster<row_type>;
+  using type = VectorType;
+  typedef typename FieldMatrixImp::value_type K;
+  static const int ROWS = FieldMatrixImp::rows;
+  static const int COLS = FieldMatrixImp::cols;
+  static_assert(sizeof(FieldMatrixImp) == ROWS * COLS * sizeof(K),
+                "The entries of the FieldMatrix have to be contiguous!");
 
   bool load(handle src, bool convert)
   {
-    if (!isinstance<sequence>(src))
+    auto arr = field_array_load<K>(src, convert, {-1, ROWS, COLS});
+    if (!arr)
+      arr = field_array_load<K>(src, convert, {0}); // e.g., []
+    if (!arr)
       return false;
-    auto s = reinterpret_borrow<sequence>(src);
-    if (s.size() != ROWS)
-      return false;
-    row_conv conv;
-    size_t ii = 0;
-    for (auto it : s) {
-      if (ii >= ROWS)
-        return false;
-      if (!conv.load(it, convert))
-        return false;
-      value[ii++] = cast_op<row_type>(conv);
-    }
+    value.resize(arr.ndim() == 3 ? arr.shape(0) : 0);
+    std::copy_n(arr.data(), arr.size(), reinterpret_cast<K*>(value.data()));
     return true;
   } // ... load(...)
 
+  static handle cast(const type& src, return_value_policy policy, handle parent)
+  {
+    return field_array_cast(
+        reinterpret_cast<const K*>(src.data()), {static_cast<ssize_t>(src.size()), ROWS, COLS}, policy, parent);
+  }
+
+  static handle cast(type&& src, return_value_policy /*policy*/, handle /*parent*/)
+  {
+    const auto size = static_cast<ssize_t>(src.size());
+    return field_array_take<K>(std::move(src), {size, ROWS, COLS});
+  }
+
   PYBIND11_TYPE_CASTER(type,
-                       _("List[List[") + value_conv::name + _("[") + _<COLS>() + _("]]") + _("[") + _<ROWS>()
-                           + _("]]"));
-};
+                       _("numpy.ndarray[") + npy_format_descriptor<K>::name + _("[m, ") + _<ROWS>() + _(", ")
+                           + _<COLS>() + _("]]"));
+}; // struct FieldMatrices_type_caster<..., true>
+
+
+template <class K, int N, int M>
+struct type_caster<Dune::FieldMatrix<K, N, M>> : public FieldMatrix_type_caster<Dune::FieldMatrix<K, N, M>>
+{};
+
+template <class K, int N, int M>
+struct type_caster<Dune::XT::Common::FieldMatrix<K, N, M>>
+  : public FieldMatrix_type_caster<Dune::XT::Common::FieldMatrix<K, N, M>>
+{};
+
+template <class K, int N, int M, class Alloc>
+struct type_caster<std::vector<Dune::FieldMatrix<K, N, M>, Alloc>>
+  : public FieldMatrices_type_caster<std::vector<Dune::FieldMatrix<K, N, M>, Alloc>>
+{};
+
+template <class K, int N, int M, class Alloc>
+struct type_caster<std::vector<Dune::XT::Common::FieldMatrix<K, N, M>, Alloc>>
+  : public FieldMatrices_type_caster<std::vector<Dune::XT::Common::FieldMatrix<K, N, M>, Alloc>>
+{};
 
 
 NAMESPACE_END(detail)
@@ -12,8 +12,15 @@
 #ifndef DUNE_XT_COMMON_FVECTOR_PBH
 #define DUNE_XT_COMMON_FVECTOR_PBH
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include <dune/pybindxi/pybind11.h>
 #include <dune/pybindxi/cast.h>
+#include <dune/pybindxi/complex.h>
+#include <dune/pybindxi/numpy.h>
+#include <dune/pybindxi/stl.h>
 
 #include <dune/xt/common/fvector.hh>
 
@@ -21,55 +28,106 @@ NAMESPACE_BEGIN(pybind11)
 NAMESPACE_BEGIN(detail)
 
 
+//! entries which can be stored in numpy arrays, containers of all others are converted from/to lists
+template <class K>
+struct is_field_numpy_scalar
+  : public std::integral_constant<bool, std::is_arithmetic<K>::value || Dune::XT::Common::is_complex<K>::value>
+{};
+
+
+/**
+ * \brief The contiguous entries in data as a numpy array of the given shape.
+ *
+ *        For the reference policies the array is a read-only view on data (which is kept alive by parent for
+ *        reference_internal), for all others the entries are copied at once.
+ */
+template <class K>
+handle field_array_cast(const K* data, std::vector<ssize_t> shape, return_value_policy policy, handle parent)
+{
+  handle base;
+  if (policy == return_value_policy::reference)
+    base = none();
+  else if (policy == return_value_policy::reference_internal)
+    base = parent;
+  array_t<K> arr(std::move(shape), data, base); // copies if base is empty
+  if (base)
+    array_proxy(arr.ptr())->flags &= ~npy_api::NPY_ARRAY_WRITEABLE_;
+  return arr.release();
+} // ... field_array_cast(...)
+
+
+//! moves the std::vector vec to the heap and returns an array of the given shape, which views and owns it
+template <class K, class VectorType>
+handle field_array_take(VectorType&& vec, std::vector<ssize_t> shape)
+{
+  static_assert(!std::is_lvalue_reference<VectorType>::value, "Only temporaries can be taken!");
+  auto* owned = new VectorType(std::move(vec));
+  capsule base(owned, [](void* ptr) { delete reinterpret_cast<VectorType*>(ptr); });
+  return array_t<K>(std::move(shape), reinterpret_cast<K*>(owned->data()), base).release();
+}
+
+
+/**
+ * \brief src as contiguous array of the given shape, if src is an array (or, if convert is true, anything numpy can
+ *        convert) of that shape.
+ *
+ *        A shape entry of -1 matches any extent. Without convert, only arrays of matching dtype are accepted (but
+ *        non-contiguous ones are still copied into a contiguous array).
+ * \return the array, a null object if src does not match
+ */
+template <class K>
+array_t<K, array::c_style | array::forcecast>
+field_array_load(handle src, const bool convert, const std::vector<ssize_t>& shape)
+{
+  using ArrayType = array_t<K, array::c_style | array::forcecast>;
+  if (!convert && !isinstance<array_t<K>>(src))
+    return reinterpret_steal<ArrayType>(handle());
+  auto arr = ArrayType::ensure(src);
+  if (!arr || arr.ndim() != static_cast<ssize_t>(shape.size()))
+    return reinterpret_steal<ArrayType>(handle());
+  for (size_t ii = 0; ii < shape.size(); ++ii)
+    if (shape[ii] >= 0 && arr.shape(ii) != shape[ii])
+      return reinterpret_steal<ArrayType>(handle());
+  return arr;
+} // ... field_array_load(...)
+
+
 template <class FieldVectorImp,
-          bool is_number = (Dune::XT::Common::is_arithmetic<typename FieldVectorImp::value_type>::value
-                            || Dune::XT::Common::is_complex<typename FieldVectorImp::value_type>::value)>
-struct FieldVector_type_caster
+          bool is_number = is_field_numpy_scalar<typename FieldVectorImp::value_type>::value>
+struct FieldVector_type_caster;
+
+
+/**
+ * FieldVectors of numbers are read from and cast to one-dimensional numpy arrays (any sequence is accepted when
+ * converting), without creating a python object per entry.
+ **/
+template <class FieldVectorImp>
+struct FieldVector_type_caster<FieldVectorImp, true>
 {
   using type = FieldVectorImp;
   typedef typename type::value_type K;
   static const int SZ = type::dimension;
-  using value_conv = make_caster<K>;
+  static_assert(sizeof(type) == SZ * sizeof(K), "The entries of the FieldVector have to be contiguous!");
 
   bool load(handle src, bool convert)
   {
-    if (!isinstance<sequence>(src))
-      return false;
-    auto s = reinterpret_borrow<sequence>(src);
-    if (s.size() != SZ)
+    const auto arr = field_array_load<K>(src, convert, {SZ});
+    if (!arr)
       return false;
-    value_conv conv;
-    value *= K(0.0);
-    size_t ii = 0;
-    for (auto it : s) {
-      if (ii >= SZ)
-        return false;
-      if (!conv.load(it, convert))
-        return false;
-      value[ii++] = cast_op<K>(conv);
-    }
+    std::copy_n(arr.data(), SZ, reinterpret_cast<K*>(&value));
     return true;
-  } // ... load(...)
+  }
 
   static handle cast(const type& src, return_value_policy policy, handle parent)
   {
-    list l(SZ);
-    for (size_t ii = 0; ii < src.size(); ++ii) {
-      object val = reinterpret_steal<object>(value_conv::cast(src[ii], policy, parent));
-      if (!val)
-        return handle();
-      PyList_SET_ITEM(l.ptr(), ii, val.release().ptr()); // steals a reference
-    }
-    return l.release();
-  } // ... cast(...)
+    return field_array_cast(reinterpret_cast<const K*>(&src), {SZ}, policy, parent);
+  }
 
-  PYBIND11_TYPE_CASTER(type, _("List[") + value_conv::name + _("[") + _<SZ>() + _("]]"));
-}; // struct FieldVector_type_caster
+  PYBIND11_TYPE_CASTER(type, _("numpy.ndarray[") + npy_format_descriptor<K>::name + _("[") + _<SZ>() + _("]]"));
+}; // struct FieldVector_type_caster<..., true>
 
 /**
- * This specialization is needed because we also want to have std::string in FieldVector.
- * For Dune::XT::Common::FieldMatrix we already have the correct default value, so no string version of value *= K(0.0)
- * is required
+ * FieldVectors of other types (e.g., std::string) are read from and cast to lists entry by entry.
  **/
 template <class FieldVectorImp>
 struct FieldVector_type_caster<FieldVectorImp, false>
@@ -111,7 +169,54 @@ struct FieldVector_type_caster<FieldVectorImp, false>
   } // ... cast(...)
 
   PYBIND11_TYPE_CASTER(type, _("List[") + value_conv::name + _("[") + _<SZ>() + _("]]"));
-}; // struct FieldVector_type_caster
+}; // struct FieldVector_type_caster<..., false>
+
+
+template <class VectorType,
+          class FieldVectorImp = typename VectorType::value_type,
+          bool is_number = is_field_numpy_scalar<typename FieldVectorImp::value_type>::value>
+struct FieldVectors_type_caster : public list_caster<VectorType, FieldVectorImp>
+{};
+
+/**
+ * std::vectors of FieldVectors of numbers are read from and cast to numpy arrays of shape (size, SZ). Returned
+ * temporaries are moved into the array, so not even their entries are copied.
+ **/
+template <class VectorType, class FieldVectorImp>
+struct FieldVectors_type_caster<VectorType, FieldVectorImp, true>
+{
+  using type = VectorType;
+  typedef typename FieldVectorImp::value_type K;
+  static const int SZ = FieldVectorImp::dimension;
+  static_assert(sizeof(FieldVectorImp) == SZ * sizeof(K), "The entries of the FieldVector have to be contiguous!");
+
+  bool load(handle src, bool convert)
+  {
+    auto arr = field_array_load<K>(src, convert, {-1, SZ});
+    if (!arr)
+      arr = field_array_load<K>(src, convert, {0}); // e.g., []
+    if (!arr)
+      return false;
+    value.resize(arr.ndim() == 2 ? arr.shape(0) : 0);
+    std::copy_n(arr.data(), arr.size(), reinterpret_cast<K*>(value.data()));
+    return true;
+  } // ... load(...)
+
+  static handle cast(const type& src, return_value_policy policy, handle parent)
+  {
+    return field_array_cast(
+        reinterpret_cast<const K*>(src.data()), {static_cast<ssize_t>(src.size()), SZ}, policy, parent);
+  }
+
+  static handle cast(type&& src, return_value_policy /*policy*/, handle /*parent*/)
+  {
+    const auto size = static_cast<ssize_t>(src.size());
+    return field_array_take<K>(std::move(src), {size, SZ});
+  }
+
+  PYBIND11_TYPE_CASTER(type,
+                       _("numpy.ndarray[") + npy_format_descriptor<K>::name + _("[m, ") + _<SZ>() + _("]]"));
+}; // struct FieldVectors_type_caster<..., true>
 
 
 template <class K, int SIZE>
@@ -123,6 +228,16 @@ struct type_caster<Dune::XT::Common::FieldVector<K, SIZE>>
   : public FieldVector_type_caster<Dune::XT::Common::FieldVector<K, SIZE>>
 {};
 
+template <class K, int SIZE, class Alloc>
+struct type_caster<std::vector<Dune::FieldVector<K, SIZE>, Alloc>>
+  : public FieldVectors_type_caster<std::vector<Dune::FieldVector<K, SIZE>, Alloc>>
+{};
+
+template <class K, int SIZE, class Alloc>
+struct type_caster<std::vector<Dune::XT::Common::FieldVector<K, SIZE>, Alloc>>
+  : public FieldVectors_type_caster<std::vector<Dune::XT::Common::FieldVector<K, SIZE>, Alloc>>
+{};
+
 
 NAMESPACE_END(detail)
 NAMESPACE_END(pybind11)
@@ -27,6 +27,8 @@ PYBIND11_MODULE(logging, m)
   namespace py = pybind11;
   using namespace pybind11::literals;
   using namespace Dune::XT::Common;
+  // the messages are converted before the GIL is released, so other python threads may run while we write
+  using release_gil = py::call_guard<py::gil_scoped_release>;
 
   m.def("create",
         [](int logflags, const std::string logfile, const std::string datadir, const std::string _logdir) {
@@ -35,28 +37,32 @@ PYBIND11_MODULE(logging, m)
         "logflags"_a = LogDefault,
         "logfile"_a = "dune_xt_common_log",
         "datadir"_a = "data",
-        "_logdir"_a = std::string("log"));
+        "_logdir"_a = std::string("log"),
+        release_gil());
   m.def("info",
         [](std::string msg, std::string end) {
           Logger().info() << msg << end;
           Logger().info().flush();
         },
         "msg"_a,
-        "end"_a = "\n");
+        "end"_a = "\n",
+        release_gil());
   m.def("debug",
         [](std::string msg, std::string end) {
           Logger().debug() << msg << end;
           Logger().debug().flush();
         },
         "msg"_a,
-        "end"_a = "\n");
+        "end"_a = "\n",
+        release_gil());
   m.def("error",
         [](std::string msg, std::string end) {
           Logger().error() << msg << end;
           Logger().error().flush();
         },
         "msg"_a,
-        "end"_a = "\n");
+        "end"_a = "\n",
+        release_gil());
   m.attr("log_max") = LogMax;
   m.attr("log_default") = LogDefault;
 }
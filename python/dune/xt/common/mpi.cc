@@ -38,6 +38,8 @@ PYBIND11_MODULE(_mpi, m)
   using namespace Dune;
   namespace py = pybind11;
   using pybind11::operator""_a;
+  // collective operations block until all ranks arrive, other python threads must not be blocked meanwhile
+  using release_gil = py::call_guard<py::gil_scoped_release>;
 
   m.def("init_mpi",
         [](const std::vector<std::string>& args) {
@@ -45,7 +47,8 @@ PYBIND11_MODULE(_mpi, m)
           char** argv = XT::Common::vector_to_main_args(args);
           MPIHelper::instance(argc, argv);
         },
-        "args"_a = std::vector<std::string>());
+        "args"_a = std::vector<std::string>(),
+        release_gil());
 
   XT::Common::bindings::guarded_bind([&]() {
     using Comm = CollectiveCommunication<MPIHelper::MPICommunicator>;
@@ -56,11 +59,11 @@ PYBIND11_MODULE(_mpi, m)
     cls.def_property_readonly("rank", &Comm::rank);
     cls.def_property_readonly("size", &Comm::size);
 
-    cls.def("barrier", &Comm::barrier);
+    cls.def("barrier", &Comm::barrier, release_gil());
 
-    cls.def("min", [](const Comm& self, double x) { return self.min(x); }, "x"_a);
-    cls.def("max", [](const Comm& self, double x) { return self.max(x); }, "x"_a);
-    cls.def("sum", [](const Comm& self, double x) { return self.sum(x); }, "x"_a);
+    cls.def("min", [](const Comm& self, double x) { return self.min(x); }, "x"_a, release_gil());
+    cls.def("max", [](const Comm& self, double x) { return self.max(x); }, "x"_a, release_gil());
+    cls.def("sum", [](const Comm& self, double x) { return self.sum(x); }, "x"_a, release_gil());
   });
 
   XT::Common::bindings::guarded_bind([&]() {
@@ -75,5 +78,5 @@ PYBIND11_MODULE(_mpi, m)
   });
 #endif
 
-  m.def("abort_all_mpi_processes", &XT::abort_all_mpi_processes);
+  m.def("abort_all_mpi_processes", &XT::abort_all_mpi_processes, release_gil());
 }
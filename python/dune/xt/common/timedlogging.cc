@@ -41,5 +41,6 @@ PYBIND11_MODULE(timedlogging, m)
       "enable_colors"_a = true,
       "info_color"_a = "blue",
       "debug_color"_a = "darkgray",
-      "warning_color"_a = "red");
+      "warning_color"_a = "red",
+      py::call_guard<py::gil_scoped_release>());
 }
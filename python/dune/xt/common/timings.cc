@@ -23,27 +23,108 @@
 #include <dune/common/parallel/mpihelper.hh>
 
 
+//! context manager for python's with statement, see Timings.section
+struct TimingsSection
+{
+  Dune::XT::Common::Timings& timings;
+  const std::string name;
+};
+
+
 PYBIND11_MODULE(_timings, m)
 {
   namespace py = pybind11;
   using namespace pybind11::literals;
   using namespace Dune::XT::Common;
 
+  // Timings is thread-safe, so the GIL is released and other python threads may run (and time) meanwhile
+  using release_gil = py::call_guard<py::gil_scoped_release>;
+
   bindings::try_register(m, [](auto& m_) {
     py::class_<Timings>(m_, "Timings")
-        .def("start", &Timings::start, "set this to begin a named section")
-        .def("reset", py::overload_cast<std::string>(&Timings::reset), "set elapsed time back to 0 for section_name")
-        .def("reset", py::overload_cast<>(&Timings::reset), "set elapsed time back to 0 for section_name")
-        .def("stop", py::overload_cast<std::string>(&Timings::stop), "stop all timer for given section only")
-        .def("stop", py::overload_cast<>(&Timings::stop), "stop all running timers")
-        .def("walltime", &Timings::walltime, "get runtime of section in milliseconds")
+        .def("start", &Timings::start, "set this to begin a named section", release_gil())
+        .def("reset",
+             py::overload_cast<std::string>(&Timings::reset),
+             "set elapsed time back to 0 for section_name",
+             release_gil())
+        .def("reset",
+             py::overload_cast<>(&Timings::reset),
+             "set elapsed time back to 0 for section_name",
+             release_gil())
+        .def("stop",
+             py::overload_cast<std::string>(&Timings::stop),
+             "stop all timer for given section only",
+             release_gil())
+        .def("stop", py::overload_cast<>(&Timings::stop), "stop all running timers", release_gil())
+        .def("walltime", &Timings::walltime, "get runtime of section in milliseconds", release_gil())
         //! TODO this actually accepts an ostream
-        .def("output_simple", [](Timings& self) { self.output_simple(); }, "outputs per-rank csv-file")
-        .def("output_per_rank", &Timings::output_per_rank, "outputs walltime only")
+        .def("output_simple",
+             [](Timings& self) { self.output_simple(); },
+             "outputs per-rank csv-file",
+             release_gil())
+        .def("output_per_rank", &Timings::output_per_rank, "outputs walltime only", release_gil())
         //! TODO this actually accepts an MPICOMM and an ostream too
         .def("output_all_measures",
              [](Timings& self) { self.output_all_measures(); },
-             "outputs per rank and global averages of all measures");
+             "outputs per rank and global averages of all measures",
+             release_gil())
+        .def("section",
+             [](Timings& self, std::string name) { return TimingsSection{self, std::move(name)}; },
+             "name"_a,
+             "context manager which starts the named section on entering and stops it on exiting the with statement")
+        .def("measures",
+             [](const Timings& self, const bool per_rank) {
+               Timings::MeasuresMap measures;
+               Timings::MeasuresPerRankMap measures_per_rank;
+               {
+                 py::gil_scoped_release release;
+                 if (per_rank) {
+                   // local values from the same snapshot
+                   measures_per_rank = self.measures_per_rank();
+                   const auto rank = Dune::MPIHelper::getCollectiveCommunication().rank();
+                   for (const auto& section : measures_per_rank)
+                     measures[section.first] = section.second[rank];
+                 } else
+                   measures = self.measures();
+               }
+               const auto to_dict = [](const Timings::Measures& section) {
+                 return py::dict("wall"_a = section.delta[0],
+                                 "usr"_a = section.delta[1],
+                                 "sys"_a = section.delta[2],
+                                 "count"_a = section.count);
+               };
+               py::dict ret;
+               for (const auto& section : measures) {
+                 auto values = to_dict(section.second);
+                 if (per_rank) {
+                   py::list wall, usr, sys, count;
+                   for (const auto& rank_values : measures_per_rank[section.first]) {
+                     wall.append(rank_values.delta[0]);
+                     usr.append(rank_values.delta[1]);
+                     sys.append(rank_values.delta[2]);
+                     count.append(rank_values.count);
+                   }
+                   values["wall_per_rank"] = wall;
+                   values["usr_per_rank"] = usr;
+                   values["sys_per_rank"] = sys;
+                   values["count_per_rank"] = count;
+                 }
+                 ret[py::str(section.first)] = values;
+               }
+               return ret;
+             },
+             "per_rank"_a = false,
+             "section name -> dict of wall, usr and sys time (in milliseconds) and count, and of their values on each "
+             "rank (as lists with the keys wall_per_rank, ..., requires all ranks to call this) if per_rank is True");
+    py::class_<TimingsSection>(m_, "TimingsSection")
+        .def("__enter__",
+             [](TimingsSection& self) -> TimingsSection& {
+               self.timings.start(self.name);
+               return self;
+             },
+             py::return_value_policy::reference)
+        .def("__exit__", [](TimingsSection& self, py::args) { self.timings.stop(self.name); })
+        .def_property_readonly("name", [](const TimingsSection& self) { return self.name; });
     m_.def("instance", &timings, py::return_value_policy::reference);
   });
 }
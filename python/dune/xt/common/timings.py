@@ -14,3 +14,29 @@ from dune.xt import guarded_import
 guarded_import(globals(), 'dune.xt.common', '_timings')
 
 instance()
+
+
+def _as_array(self, per_rank=False):
+    """All sections as numpy structured array, sorted by name.
+
+    The fields are section, wall, usr, sys (in milliseconds) and count and, if per_rank is True, wall_per_rank,
+    usr_per_rank, sys_per_rank and count_per_rank (each of shape (ranks,)). The latter requires all ranks to call this.
+    """
+    import numpy as np
+    measures = self.measures(per_rank)
+    names = sorted(measures.keys())
+    fields = ('wall', 'usr', 'sys', 'count')
+    dtype = [('section', 'U{}'.format(max([1] + [len(name) for name in names])))]
+    dtype += [(field, np.int64) for field in fields]
+    if per_rank:
+        ranks = len(measures[names[0]]['wall_per_rank']) if names else 1
+        dtype += [(field + '_per_rank', np.int64, (ranks,)) for field in fields]
+    ret = np.zeros(len(names), dtype=dtype)
+    for ii, name in enumerate(names):
+        ret[ii]['section'] = name
+        for key in ret.dtype.names[1:]:
+            ret[ii][key] = measures[name][key]
+    return ret
+
+
+Timings.as_array = _as_array
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+#
+# ~~~
+# This file is part of the dune-xt-common project:
+#   https://github.com/dune-community/dune-xt-common
+# Copyright 2009-2018 dune-xt-common developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+"""Decode the binary event logs written by Dune::XT::Common::EventLogger() into text or CSV
+
+Usage:
+    decode_event_log.py [--csv] [--absolute] [--output=FILE] LOGFILE...
+
+Arguments:
+    LOGFILE         The .evt files to decode (e.g. the files of all ranks, whose events are merged by time).
+
+Options:
+    --csv           Write one row per event with the columns time, rank, file, line, format and one column per
+                    argument, instead of the formatted events.
+    --absolute      Print the times as UTC date and time instead of the seconds since the creation of the log.
+    --output=FILE   Write to FILE instead of stdout.
+"""
+
+import csv
+import datetime
+import heapq
+import struct
+import sys
+
+import docopt
+
+MAGIC = b'DXTCEVT\0'
+FORMAT_RECORD = 1
+EVENT_RECORD = 2
+# the struct codes of EventArgType, 12 is a string
+ARG_TYPES = {1: 'b', 2: 'h', 3: 'i', 4: 'q', 5: 'B', 6: 'H', 7: 'I', 8: 'Q', 9: 'f', 10: 'd', 11: '?', 12: None}
+
+
+class Event:
+
+    def __init__(self, time, rank, fmt, args):
+        self.time = time
+        self.rank = rank
+        self.fmt = fmt
+        self.args = args
+
+    def __lt__(self, other):
+        return (self.time, self.rank) < (other.time, other.rank)
+
+    def text(self):
+        parts = self.fmt['format'].split('{}')
+        ret = parts[0]
+        for ii, part in enumerate(parts[1:]):
+            ret += (str(self.args[ii]) if ii < len(self.args) else '{}') + part
+        return ret
+
+
+def read_events(filename):
+    """Yields the events in the given file (with the time in nanoseconds since the unix epoch)"""
+    with open(filename, 'rb') as f:
+        data = f.read()
+    if data[:len(MAGIC)] != MAGIC:
+        raise RuntimeError('{} is not an event log!'.format(filename))
+    pos = len(MAGIC)
+    order = '<' if struct.unpack_from('<I', data, pos + 4)[0] == 0x01020304 else '>'
+    version, _, start, rank = struct.unpack_from(order + 'IIqI', data, pos)
+    if version != 1:
+        raise RuntimeError('{} has the unsupported version {}!'.format(filename, version))
+    pos += struct.calcsize(order + 'IIqI')
+    formats = {}
+
+    def unpack(fmt):
+        nonlocal pos
+        values = struct.unpack_from(order + fmt, data, pos)
+        pos += struct.calcsize(order + fmt)
+        return values
+
+    def unpack_string():
+        nonlocal pos
+        size, = unpack('I')
+        pos += size
+        return data[pos - size:pos].decode('utf-8', errors='replace')
+
+    try:
+        while pos < len(data):
+            kind, id = unpack('BI')
+            if kind == FORMAT_RECORD:
+                line, num_args = unpack('IH')
+                types = [ARG_TYPES[t] for t in unpack('{}B'.format(num_args))]
+                file = unpack_string()
+                formats[id] = {'file': file, 'line': line, 'format': unpack_string(), 'types': types}
+            elif kind == EVENT_RECORD:
+                time, = unpack('Q')
+                fmt = formats[id]
+                args = [unpack_string() if t is None else unpack(t)[0] for t in fmt['types']]
+                yield Event(start + time, rank, fmt, args)
+            else:
+                raise RuntimeError('{} contains an unknown record at byte {}!'.format(filename, pos - 5))
+    except (struct.error, KeyError):
+        # the last block of a log which was not properly closed may be truncated
+        print('{} is truncated at byte {}, ignoring the rest'.format(filename, pos), file=sys.stderr)
+
+
+def decode(filenames, out, as_csv=False, absolute=False):
+    events = heapq.merge(*[read_events(f) for f in filenames])
+    start = None
+
+    def time_str(time):
+        if absolute:
+            return datetime.datetime.utcfromtimestamp(time // 10**9).strftime('%Y-%m-%d %H:%M:%S') \
+                   + '.{:09d}'.format(time % 10**9)
+        return '{:.9f}'.format((time - start) / 1e9)
+
+    writer = csv.writer(out) if as_csv else None
+    if writer:
+        writer.writerow(['time', 'rank', 'file', 'line', 'format'])
+    for event in events:
+        if start is None:
+            start = event.time
+        if writer:
+            writer.writerow([time_str(event.time), event.rank, event.fmt['file'], event.fmt['line'],
+                             event.fmt['format']] + event.args)
+        elif len(filenames) > 1:
+            out.write('[{}|{}] {}\n'.format(time_str(event.time), event.rank, event.text()))
+        else:
+            out.write('[{}] {}\n'.format(time_str(event.time), event.text()))
+
+
+if __name__ == '__main__':
+    arguments = docopt.docopt(__doc__)
+    if arguments['--output']:
+        with open(arguments['--output'], 'w', newline='') as out:
+            decode(arguments['LOGFILE'], out, arguments['--csv'], arguments['--absolute'])
+    else:
+        decode(arguments['LOGFILE'], sys.stdout, arguments['--csv'], arguments['--absolute'])
@@ -47,6 +47,145 @@ def test_timings():
     timings.output_simple()
 
 
+def test_timings_section():
+    from dune.xt.common.timings import instance
+    timings = instance()
+    timings.reset()
+    for _ in range(3):
+        with timings.section('section.outer'):
+            with timings.section('section.inner') as section:
+                assert section.name == 'section.inner'
+    with pytest.raises(ValueError):
+        with timings.section('section.raising'):
+            raise ValueError
+    measures = timings.measures()
+    assert measures['section.outer']['count'] == 3
+    assert measures['section.inner']['count'] == 3
+    assert measures['section.raising']['count'] == 1
+    assert set(measures['section.inner'].keys()) == {'wall', 'usr', 'sys', 'count'}
+    per_rank = timings.measures(per_rank=True)
+    assert per_rank['section.outer']['count_per_rank'][0] == 3
+    array = timings.as_array(per_rank=True)
+    assert list(array['section']) == ['section.inner', 'section.outer', 'section.raising']
+    assert list(array['count']) == [3, 3, 1]
+    assert array['wall_per_rank'].shape[0] == 3
+
+
+def test_threads():
+    from concurrent.futures import ThreadPoolExecutor
+    import dune.xt.common.logging as lg
+    from dune.xt.common.timings import instance
+    timings = instance()
+    timings.reset()
+
+    def work(ii):
+        section = 'threads.{}'.format(ii)
+        for _ in range(100):
+            timings.start(section)
+            lg.info('thread {}'.format(ii))
+            timings.stop(section)
+        return timings.walltime(section)
+
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        walltimes = list(executor.map(work, range(8)))
+    assert len(walltimes) == 8
+    assert all(walltime >= 0 for walltime in walltimes)
+    timings.output_simple()
+
+
+def test_configuration_threads():
+    from concurrent.futures import ThreadPoolExecutor
+    from dune.xt.common.configuration import Configuration
+    shared = Configuration({'common.key': 'value'})
+
+    def work(ii):
+        key = 'threads.{}'.format(ii)
+        own = Configuration({'common.key': 'value'})
+        for jj in range(100):
+            shared[key] = str(jj)
+            own[key] = str(jj)
+            assert shared['common.key'] == 'value'
+            assert shared[key] == own[key]
+        return own
+
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        configs = list(executor.map(work, range(8)))
+    expected = {'common.key': 'value'}
+    expected.update({'threads.{}'.format(ii): '99' for ii in range(8)})
+    assert shared.to_dict() == expected
+    assert shared == Configuration(expected)
+    assert hash(shared) == hash(Configuration(expected))
+    for ii, config in enumerate(configs):
+        assert config == Configuration({'common.key': 'value', 'threads.{}'.format(ii): '99'})
+        assert 'threads.{}'.format(ii) in config
+    with pytest.raises(KeyError):
+        shared['missing']
+
+
+def test_event_log(tmpdir):
+    import csv
+    import importlib.util
+    import io
+    import os
+    from dune.xt.common import event_log
+    event_log.create('events', str(tmpdir), 'log')
+    event_log.record('iteration {}: residual {}', 3, 0.25)
+    event_log.record('solver {} converged: {}', 'cg', True)
+    event_log.record('done')
+    with pytest.raises(TypeError):
+        event_log.record('unsupported {}', [1, 2])
+    filename = event_log.filename()
+    event_log.deinit()
+    assert not event_log.enabled()
+
+    script = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, 'scripts', 'decode_event_log.py')
+    spec = importlib.util.spec_from_file_location('decode_event_log', script)
+    decoder = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(decoder)
+    out = io.StringIO()
+    decoder.decode([filename], out)
+    # each line starts with the seconds since the first event in brackets
+    messages = [line.split('] ', 1)[1] for line in out.getvalue().splitlines()]
+    assert messages == ['iteration 3: residual 0.25', 'solver cg converged: True', 'done']
+    out = io.StringIO()
+    decoder.decode([filename], out, as_csv=True)
+    rows = list(csv.reader(io.StringIO(out.getvalue())))
+    assert rows[0] == ['time', 'rank', 'file', 'line', 'format']
+    assert [row[4:] for row in rows[1:]] == [['iteration {}: residual {}', '3', '0.25'],
+                                             ['solver {} converged: {}', 'cg', 'True'], ['done']]
+    assert all(row[1] == '0' for row in rows[1:])
+
+
+def test_field_casters():
+    import numpy as np
+    from dune.xt.common._empty import (scale_field_vector, transpose_field_matrix, reverse_field_vectors,
+                                       identity_field_matrices, field_vector_of_strings)
+
+    vec = scale_field_vector(np.array([1., 2., 3.]), 2.)
+    assert isinstance(vec, np.ndarray)
+    assert vec.tolist() == [2., 4., 6.]
+    assert scale_field_vector([1, 2, 3], 1.).dtype == np.float64
+    with pytest.raises(TypeError):
+        scale_field_vector([1., 2.], 1.)
+
+    mat = transpose_field_matrix([[1., 2., 3.], [4., 5., 6.]])
+    assert mat.shape == (3, 2)
+    assert mat[2, 1] == 6.
+    assert transpose_field_matrix(np.arange(6.).reshape(3, 2).T)[1, 0] == 2.
+
+    points = reverse_field_vectors(np.arange(8.).reshape(4, 2))
+    assert points.shape == (4, 2)
+    assert points[0].tolist() == [6., 7.]
+    assert reverse_field_vectors([]).shape == (0, 2)
+
+    identities = identity_field_matrices(1000)
+    assert identities.shape == (1000, 2, 2)
+    assert identities.dtype == np.intc
+    assert identities[999].tolist() == [[1, 0], [0, 1]]
+
+    assert field_vector_of_strings(['a', 'b']) == ['a', 'b']
+
+
 if __name__ == '__main__':
     from dune.xt.common.test import runmodule
     runmodule(__file__)